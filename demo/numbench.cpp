@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <ctime>
+#include <cxxtools/arg.h>
+#include <cxxtools/convert.h>
+#include <tntdb/impl/numconvert.h>
+
+////////////////////////////////////////////////////////////////////////
+// Compares the number conversion used by the drivers with streams.
+//
+
+namespace
+{
+  double seconds(std::clock_t start)
+  {
+    return static_cast<double>(std::clock() - start) / CLOCKS_PER_SEC;
+  }
+
+  void report(const char* what, double streamTime, double kernelTime)
+  {
+    std::cout << what << ": stream " << streamTime << "s, numconvert " << kernelTime << 's';
+    if (kernelTime > 0)
+      std::cout << " (" << streamTime / kernelTime << "x)";
+    std::cout << std::endl;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    cxxtools::Arg<unsigned> count(argc, argv, 'n', 1000000);
+
+    std::vector<std::string> ints;
+    std::vector<std::string> doubles;
+    for (unsigned n = 0; n < 1000; ++n)
+    {
+      ints.push_back(cxxtools::convert<std::string>(static_cast<int64_t>(n) * 7919 - 3000000));
+      std::ostringstream s;
+      s.precision(17);
+      s << (n * 3.14159265358979 - 1234.5) / 7;
+      doubles.push_back(s.str());
+    }
+
+    char buf[tntdb::numberBufferSize];
+    int64_t isum = 0;
+    double dsum = 0;
+    std::clock_t start;
+
+    // parse integers
+    start = std::clock();
+    for (unsigned n = 0; n < count; ++n)
+      isum += cxxtools::convert<int64_t>(ints[n % ints.size()]);
+    double t1 = seconds(start);
+
+    start = std::clock();
+    for (unsigned n = 0; n < count; ++n)
+    {
+      const std::string& s = ints[n % ints.size()];
+      isum -= tntdb::convertNumber<int64_t>(s.data(), s.size(), "int64_t");
+    }
+    report("parse int64_t", t1, seconds(start));
+
+    // parse doubles
+    start = std::clock();
+    for (unsigned n = 0; n < count; ++n)
+      dsum += cxxtools::convert<double>(doubles[n % doubles.size()]);
+    t1 = seconds(start);
+
+    start = std::clock();
+    for (unsigned n = 0; n < count; ++n)
+    {
+      const std::string& s = doubles[n % doubles.size()];
+      dsum -= tntdb::convertNumber<double>(s.data(), s.size(), "double");
+    }
+    report("parse double", t1, seconds(start));
+
+    // format integers
+    std::size_t len = 0;
+    start = std::clock();
+    for (unsigned n = 0; n < count; ++n)
+      len += cxxtools::convert<std::string>(static_cast<int64_t>(n) - 500000).size();
+    t1 = seconds(start);
+
+    start = std::clock();
+    for (unsigned n = 0; n < count; ++n)
+      len -= tntdb::formatInt64(static_cast<int64_t>(n) - 500000, buf);
+    report("format int64_t", t1, seconds(start));
+
+    // format doubles
+    start = std::clock();
+    for (unsigned n = 0; n < count; ++n)
+    {
+      std::ostringstream s;
+      s.precision(24);
+      s << n / 7.0;
+      len += s.str().size();
+    }
+    t1 = seconds(start);
+
+    start = std::clock();
+    for (unsigned n = 0; n < count; ++n)
+      len += tntdb::formatDouble(n / 7.0, buf);
+    report("format double", t1, seconds(start));
+
+    // print the results, so that the loops are not optimized away
+    std::cout << "checksum " << isum << ' ' << dsum << ' ' << len << std::endl;
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+  }
+}
@@ -29,7 +29,9 @@
 #ifndef TNTDB_H
 #define TNTDB_H
 
+#include <tntdb/batch.h>
 #include <tntdb/blob.h>
+#include <tntdb/columnarresult.h>
 #include <tntdb/connect.h>
 #include <tntdb/connection.h>
 #include <tntdb/connectionpool.h>
@@ -40,7 +42,9 @@
 #include <tntdb/librarymanager.h>
 #include <tntdb/result.h>
 #include <tntdb/row.h>
+#include <tntdb/rowvisitor.h>
 #include <tntdb/statement.h>
+#include <tntdb/structmap.h>
 #include <tntdb/time.h>
 #include <tntdb/transaction.h>
 #include <tntdb/value.h>
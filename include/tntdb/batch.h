@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TNTDB_BATCH_H
+#define TNTDB_BATCH_H
+
+#include <tntdb/iface/istatement.h>
+#include <tntdb/decimal.h>
+#include <tntdb/blob.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace tntdb
+{
+  /** Parameter values for executing a statement for many rows at once
+
+      The values are collected column-wise with one column per host variable.
+      A row is filled with the setters and completed with addRow(). Columns,
+      which are not set in a row, are null there. Host variables of the
+      statement without a column in the batch keep their current value.
+
+      @code
+        tntdb::Statement ins = conn.prepare(
+          "insert into person(name, age) values (:name, :age)");
+
+        tntdb::Batch batch;
+        for (unsigned n = 0; n < persons.size(); ++n)
+          batch.setString("name", persons[n].name)
+               .setInt("age", persons[n].age)
+               .addRow();
+
+        unsigned count = ins.executeBatch(batch);
+      @endcode
+   */
+  class Batch
+  {
+    public:
+      typedef unsigned size_type;
+
+      /// Type of a value in the batch
+      enum Type {
+        NULLVALUE,
+        BOOL,
+        INT64,
+        UNSIGNED64,
+        DOUBLE,
+        STRING,
+        DECIMAL,
+        BLOB,
+        DATE,
+        TIME,
+        DATETIME
+      };
+
+    private:
+      struct Cell
+      {
+        Type type;
+        union
+        {
+          bool b;
+          int64_t i;
+          uint64_t u;
+          double d;
+          size_type ref;  // index into the storage for the type
+        } value;
+
+        Cell()
+          : type(NULLVALUE)
+          { }
+      };
+
+      struct Column
+      {
+        std::string name;
+        std::vector<Cell> cells;
+      };
+
+      typedef std::map<std::string, size_type> ColumnMapType;
+
+      std::vector<Column> _columns;
+      ColumnMapType _columnMap;
+      size_type _rows;
+
+      std::vector<std::string> _strings;
+      std::vector<Decimal> _decimals;
+      std::vector<Blob> _blobs;
+      std::vector<Date> _dates;
+      std::vector<Time> _times;
+      std::vector<Datetime> _datetimes;
+
+      Cell& cell(size_type col);
+      const Cell* cell(size_type col, size_type row) const;
+
+    public:
+      Batch()
+        : _rows(0)
+        { }
+
+      /// Returns the index of the column for a host variable and adds it when needed.
+      size_type column(const std::string& name);
+
+      /// Completes the current row and starts a new one.
+      Batch& addRow()   { ++_rows; return *this; }
+
+      /// Removes all rows and columns.
+      void clear();
+
+      /// Setters for the current row
+      /// @{
+      Batch& setNull(size_type col)                      { cell(col).type = NULLVALUE; return *this; }
+      Batch& setBool(size_type col, bool data);
+      Batch& setInt64(size_type col, int64_t data);
+      Batch& setUnsigned64(size_type col, uint64_t data);
+      Batch& setInt(size_type col, int data)             { return setInt64(col, data); }
+      Batch& setLong(size_type col, long data)           { return setInt64(col, data); }
+      Batch& setUnsigned(size_type col, unsigned data)   { return setUnsigned64(col, data); }
+      Batch& setUnsignedLong(size_type col, unsigned long data)  { return setUnsigned64(col, data); }
+      Batch& setDouble(size_type col, double data);
+      Batch& setString(size_type col, const std::string& data);
+      Batch& setString(size_type col, const char* data)
+        { return data == 0 ? setNull(col) : setString(col, std::string(data)); }
+      Batch& setDecimal(size_type col, const Decimal& data);
+      Batch& setBlob(size_type col, const Blob& data);
+      Batch& setDate(size_type col, const Date& data);
+      Batch& setTime(size_type col, const Time& data);
+      Batch& setDatetime(size_type col, const Datetime& data);
+
+      Batch& setNull(const std::string& col)                         { return setNull(column(col)); }
+      Batch& setBool(const std::string& col, bool data)              { return setBool(column(col), data); }
+      Batch& setInt64(const std::string& col, int64_t data)          { return setInt64(column(col), data); }
+      Batch& setUnsigned64(const std::string& col, uint64_t data)    { return setUnsigned64(column(col), data); }
+      Batch& setInt(const std::string& col, int data)                { return setInt64(column(col), data); }
+      Batch& setLong(const std::string& col, long data)              { return setInt64(column(col), data); }
+      Batch& setUnsigned(const std::string& col, unsigned data)      { return setUnsigned64(column(col), data); }
+      Batch& setUnsignedLong(const std::string& col, unsigned long data)  { return setUnsigned64(column(col), data); }
+      Batch& setDouble(const std::string& col, double data)          { return setDouble(column(col), data); }
+      Batch& setString(const std::string& col, const std::string& data)  { return setString(column(col), data); }
+      Batch& setString(const std::string& col, const char* data)     { return setString(column(col), data); }
+      Batch& setDecimal(const std::string& col, const Decimal& data) { return setDecimal(column(col), data); }
+      Batch& setBlob(const std::string& col, const Blob& data)       { return setBlob(column(col), data); }
+      Batch& setDate(const std::string& col, const Date& data)       { return setDate(column(col), data); }
+      Batch& setTime(const std::string& col, const Time& data)       { return setTime(column(col), data); }
+      Batch& setDatetime(const std::string& col, const Datetime& data)  { return setDatetime(column(col), data); }
+      /// @}
+
+      /// Number of completed rows
+      size_type getRowCount() const                 { return _rows; }
+      /// Number of columns
+      size_type getColumnCount() const              { return _columns.size(); }
+      /// Name of the host variable of a column
+      const std::string& getColumnName(size_type col) const  { return _columns[col].name; }
+
+      /// Getters used by the drivers; the getter must match the type of the value
+      /// @{
+      Type getType(size_type col, size_type row) const
+        { const Cell* c = cell(col, row); return c ? c->type : NULLVALUE; }
+      bool isNull(size_type col, size_type row) const
+        { return getType(col, row) == NULLVALUE; }
+      bool getBool(size_type col, size_type row) const             { return cell(col, row)->value.b; }
+      int64_t getInt64(size_type col, size_type row) const         { return cell(col, row)->value.i; }
+      uint64_t getUnsigned64(size_type col, size_type row) const   { return cell(col, row)->value.u; }
+      double getDouble(size_type col, size_type row) const         { return cell(col, row)->value.d; }
+      const std::string& getString(size_type col, size_type row) const  { return _strings[cell(col, row)->value.ref]; }
+      const Decimal& getDecimal(size_type col, size_type row) const     { return _decimals[cell(col, row)->value.ref]; }
+      const Blob& getBlob(size_type col, size_type row) const           { return _blobs[cell(col, row)->value.ref]; }
+      const Date& getDate(size_type col, size_type row) const           { return _dates[cell(col, row)->value.ref]; }
+      const Time& getTime(size_type col, size_type row) const           { return _times[cell(col, row)->value.ref]; }
+      const Datetime& getDatetime(size_type col, size_type row) const   { return _datetimes[cell(col, row)->value.ref]; }
+      /// @}
+
+      /// Looks up the host variable index of each column in the statement.
+      void paramIndexes(IStatement& stmt, std::vector<IStatement::size_type>& idx) const;
+
+      /// Sets the host variables of the statement to the values of a row.
+      void bindRow(IStatement& stmt, const std::vector<IStatement::size_type>& idx,
+        size_type row) const;
+  };
+}
+
+#endif // TNTDB_BATCH_H
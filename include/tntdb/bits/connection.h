@@ -125,7 +125,12 @@ namespace tntdb
        */
       Value selectValue(const std::string& query);
 
-      /// Create a new Statement object with the given query
+      /** Create a new Statement object with the given query
+
+          When statement caching is enabled, the statement is taken from the
+          statement cache if it is not used elsewhere, so that the database
+          does not need to prepare it again.
+       */
       Statement prepare(const std::string& query);
 
       /** Create a new Statement object with the given query and store it in a cache
@@ -156,6 +161,34 @@ namespace tntdb
       bool clearStatementCache(const std::string& key)
         { return _conn->clearStatementCache(key); }
 
+      /** Enable or disable statement caching for prepare()
+
+          When enabled, prepare() looks up the query in the statement cache
+          like prepareCached(query). A cached statement is only returned,
+          when no other Statement object or cursor uses it, so the returned
+          objects are independent. Its host variables are reset to null.
+          When the cached statement is busy, a new one is prepared.
+       */
+      void setStatementCaching(bool sw)
+        { _conn->setStatementCaching(sw); }
+
+      /// Returns true, when prepare() uses the statement cache
+      bool getStatementCaching()
+        { return _conn->getStatementCaching(); }
+
+      /** Limit the number of statements in the cache used from prepareCached()
+
+          When the limit is exceeded, the least recently used statement is
+          removed from the cache. 0 means unlimited. The default capacity is
+          256 statements.
+       */
+      void setStatementCacheCapacity(unsigned capacity)
+        { _conn->setStatementCacheCapacity(capacity); }
+
+      /// Returns the hits, misses and evictions of the statement cache
+      StmtCacheStatistics getStatementCacheStatistics()
+        { return _conn->getStatementCacheStatistics(); }
+
       /// Check whether the connection is alive
       bool ping()                        { return _conn->ping(); }
 
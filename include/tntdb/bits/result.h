@@ -31,6 +31,8 @@
 
 #include <cxxtools/smartptr.h>
 #include <tntdb/iface/iresult.h>
+#include <tntdb/bits/row.h>
+#include <vector>
 
 namespace tntdb
 {
@@ -51,6 +53,37 @@ namespace tntdb
     private:
       cxxtools::SmartPtr<IResult> result;
 
+      // The driver decodes 64 bit integers, doubles and strings directly.
+      // Other integer types and float are converted from them and all
+      // other types are read row by row.
+      static void fillColumn(const IResult& r, size_type field_num,
+          std::vector<int64_t>& values, std::vector<bool>& nulls)
+        { r.getColumn(field_num, values, nulls); }
+      static void fillColumn(const IResult& r, size_type field_num,
+          std::vector<double>& values, std::vector<bool>& nulls)
+        { r.getColumn(field_num, values, nulls); }
+      static void fillColumn(const IResult& r, size_type field_num,
+          std::vector<std::string>& values, std::vector<bool>& nulls)
+        { r.getColumn(field_num, values, nulls); }
+      static void fillColumn(const IResult& r, size_type field_num,
+          std::vector<int>& values, std::vector<bool>& nulls);
+      static void fillColumn(const IResult& r, size_type field_num,
+          std::vector<unsigned>& values, std::vector<bool>& nulls);
+      static void fillColumn(const IResult& r, size_type field_num,
+          std::vector<float>& values, std::vector<bool>& nulls);
+
+      template <typename T>
+      static void fillColumn(const IResult& r, size_type field_num,
+          std::vector<T>& values, std::vector<bool>& nulls)
+      {
+        size_type n = r.size();
+        values.clear();
+        values.resize(n);
+        nulls.resize(n);
+        for (size_type row = 0; row < n; ++row)
+          nulls[row] = !r.getRow(row).getValue(field_num).get(values[row]);
+      }
+
     public:
       class const_iterator;
 
@@ -81,6 +114,25 @@ namespace tntdb
        */
       size_type getFieldCount() const  { return result->getFieldCount(); }
 
+      /**
+       * Decodes the field_num'th column of all rows into a vector.
+       * The flag in nulls is set for each null value. For int64_t, double
+       * and std::string the driver decodes the column directly from its
+       * buffers without creating Row and Value objects.
+       */
+      template <typename T>
+      void getColumn(size_type field_num, std::vector<T>& values,
+          std::vector<bool>& nulls) const
+        { fillColumn(*result, field_num, values, nulls); }
+
+      /**
+       * Decodes the field_num'th column of all rows into a vector.
+       * Null values are stored as default constructed values.
+       */
+      template <typename T>
+      void getColumn(size_type field_num, std::vector<T>& values) const
+        { std::vector<bool> nulls; fillColumn(*result, field_num, values, nulls); }
+
       /**
        * Returns the row_num'ths row of the resultset.
        */
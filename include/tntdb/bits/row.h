@@ -33,6 +33,7 @@
 #include <tntdb/bits/value.h>
 #include <tntdb/blob.h>
 #include <tntdb/config.h>
+#include <tntdb/error.h>
 #include <cxxtools/smartptr.h>
 
 namespace tntdb
@@ -47,6 +48,7 @@ namespace tntdb
     public:
       /// Iterator for iterating through the values of this row.
       class const_iterator;
+      class Column;
       typedef unsigned size_type;
       typedef Value value_type;
 
@@ -79,10 +81,32 @@ namespace tntdb
       /// Returns the name of the field_num's column
       std::string getName(size_type field_num) const
         { return row->getColumnName(field_num); }
+      /// Returns the index of the named column or IRow::npos if not found
+      size_type getColumnIndex(const std::string& field_name) const
+        { return row->getColumnIndex(field_name); }
+
+      /** Returns a handle to the named column with its index resolved.
+
+          The handle can be used to read the column from all rows of the same
+          result or cursor without looking up the name again.
+
+          @code
+            tntdb::Result result = conn.select("select id, name from tab1");
+            tntdb::Row::Column id = result.getRow(0).column("id");
+            for (tntdb::Result::const_iterator it = result.begin(); it != result.end(); ++it)
+              std::cout << (*it)[id].getInt() << std::endl;
+          @endcode
+       */
+      Column column(const std::string& field_name) const;
+
+      /// Returns the value of the column.
+      Value getValue(const Column& column) const;
+      /// Returns the value of the column.
+      Value operator[] (const Column& column) const;
 
       /// Return true, if the specified value is null.
       bool isNull(size_type field_num) const
-        { return getValue(field_num).isNull(); }
+        { return row->isNull(field_num); }
       /// Return true, if the specified value is null.
       bool isNull(const std::string& field_name) const
         { return getValue(field_name).isNull(); }
@@ -94,11 +118,11 @@ namespace tntdb
        */
 
       bool getBool(size_type field_num) const
-        { return getValue(field_num).getBool(); }
+        { return row->getBool(field_num); }
       short getShort(size_type field_num) const
         { return getValue(field_num).getShort(); }
       int getInt(size_type field_num) const
-        { return getValue(field_num).getInt(); }
+        { return row->getInt(field_num); }
       long getLong(size_type field_num) const
         { return getValue(field_num).getLong(); }
       unsigned short getUnsignedShort(size_type field_num) const
@@ -112,21 +136,21 @@ namespace tntdb
       uint32_t getUnsigned32(size_type field_num) const
         { return getValue(field_num).getUnsigned32(); }
       int64_t getInt64(size_type field_num) const
-        { return getValue(field_num).getInt64(); }
+        { return row->getInt64(field_num); }
       uint64_t getUnsigned64(size_type field_num) const
-        { return getValue(field_num).getUnsigned64(); }
+        { return row->getUnsigned64(field_num); }
       Decimal getDecimal(size_type field_num) const
         { return getValue(field_num).getDecimal(); }
       float getFloat(size_type field_num) const
         { return getValue(field_num).getFloat(); }
       double getDouble(size_type field_num) const
-        { return getValue(field_num).getDouble(); }
+        { return row->getDouble(field_num); }
       char getChar(size_type field_num) const
         { return getValue(field_num).getChar(); }
       std::string getString(size_type field_num) const
-        { return getValue(field_num).getString(); }
+        { std::string ret; row->getString(field_num, ret); return ret; }
       void getString(size_type field_num, std::string& ret) const
-        { return getValue(field_num).getString(ret); }
+        { row->getString(field_num, ret); }
       Blob getBlob(size_type field_num) const
         { return getValue(field_num).getBlob(); }
       void getBlob(size_type field_num, Blob& ret) const
@@ -184,6 +208,22 @@ namespace tntdb
       bool getValue(size_type field_num, T& ret) const
         { return getValue(field_num).getValue(ret); }
 
+      //@{
+      /// Reads the value without creating a Value; returns false if the value is null.
+      bool getValue(size_type field_num, bool& ret) const
+        { return row->isNull(field_num) ? false : (ret = row->getBool(field_num), true); }
+      bool getValue(size_type field_num, int& ret) const
+        { return row->isNull(field_num) ? false : (ret = row->getInt(field_num), true); }
+      bool getValue(size_type field_num, int64_t& ret) const
+        { return row->isNull(field_num) ? false : (ret = row->getInt64(field_num), true); }
+      bool getValue(size_type field_num, uint64_t& ret) const
+        { return row->isNull(field_num) ? false : (ret = row->getUnsigned64(field_num), true); }
+      bool getValue(size_type field_num, double& ret) const
+        { return row->isNull(field_num) ? false : (ret = row->getDouble(field_num), true); }
+      bool getValue(size_type field_num, std::string& ret) const
+        { return row->isNull(field_num) ? false : (row->getString(field_num, ret), true); }
+      //@}
+
       /// Returns a iterator to the first column
       const_iterator begin() const;
       /// Returns a iterator past the last column
@@ -206,6 +246,65 @@ namespace tntdb
       RowReader get(T& ret, bool& nullInd) const;
 
   };
+
+  /** A column of a row with its index resolved
+
+      A column created with a name only is resolved on first use, so it can
+      be declared before the first row is fetched:
+
+      @code
+        tntdb::Row::Column id("id");
+        while (cursor.fetch(row))
+          row[id].get(n);
+      @endcode
+
+      The handle must only be used with rows having the same columns as the
+      row it was resolved against.
+   */
+  class Row::Column
+  {
+      friend class Row;
+
+      std::string _name;
+      mutable size_type _idx;
+
+      size_type resolve(const Row& row) const
+      {
+        if (_idx == IRow::npos)
+          _idx = row.getColumnIndex(_name);
+        if (_idx == IRow::npos)
+          throw FieldNotFound(_name);
+        return _idx;
+      }
+
+    public:
+      Column()
+        : _idx(IRow::npos)
+        { }
+
+      explicit Column(const std::string& name)
+        : _name(name),
+          _idx(IRow::npos)
+        { }
+
+      Column(const Row& row, const std::string& name)
+        : _name(name),
+          _idx(row.getColumnIndex(name))
+        { }
+
+      const std::string& getName() const  { return _name; }
+      /// Returns the index of the column or IRow::npos if not resolved or not found
+      size_type getIndex() const          { return _idx; }
+  };
+
+  inline Row::Column Row::column(const std::string& field_name) const
+    { return Column(*this, field_name); }
+
+  inline Value Row::getValue(const Column& column) const
+    { return row->getValueByNumber(column.resolve(*this)); }
+
+  inline Value Row::operator[] (const Column& column) const
+    { return row->getValueByNumber(column.resolve(*this)); }
 }
 
 #endif // TNTDB_BITS_ROW_H
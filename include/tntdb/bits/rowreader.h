@@ -84,14 +84,14 @@ namespace tntdb
       /// might be null or just initialize your value with a suitable default.
       template <typename T>
       RowReader& get(T& ret)
-      { row[field_num++].get(ret); return *this; }
+      { row.getValue(field_num++, ret); return *this; }
 
       /// Reads the current column value and a null indicator and increments the
       /// field counter. If the value is null, the null indicator is set to false
       /// and the actual value of the passed variable is not changed.
       template <typename T>
       RowReader& get(T& ret, bool& nullInd)
-      { nullInd = row[field_num++].get(ret); return *this; }
+      { nullInd = row.getValue(field_num++, ret); return *this; }
 
       /// Reads the current value into a tntdb::Value and increments the field
       /// counter.
@@ -100,7 +100,7 @@ namespace tntdb
 
       /// Returns true, if the current value is null.
       bool isNull() const
-      { return row[field_num].isNull(); }
+      { return row.isNull(field_num); }
 
       /// Resets the field counter to the passed value.
       void rewind(Row::size_type n_ = 0)
@@ -30,6 +30,7 @@
 #define TNTDB_BITS_STATEMENT_H
 
 #include <string>
+#include <cstring>
 #include <cxxtools/smartptr.h>
 #include <tntdb/iface/istatement.h>
 #include <tntdb/date.h>
@@ -45,9 +46,11 @@
 namespace tntdb
 {
   class Connection;
+  class Batch;
   class Result;
   class Row;
   class Value;
+  class RowVisitor;
   class Date;
   class Time;
   class Datetime;
@@ -64,6 +67,7 @@ namespace tntdb
   {
     public:
       class const_iterator;
+      class Param;
       typedef IStatement::size_type size_type;
 
     private:
@@ -149,13 +153,41 @@ namespace tntdb
       /// Set the host variable with the given name to a string value or null
       Statement& setString(const std::string& col, const char* data)
         { data == 0 ? _stmt->setNull(col)
-                    : _stmt->setString(col, data); return *this; }
+                    : _stmt->setString(col, data, std::strlen(data)); return *this; }
+
+      /// Set the host variable with the given name to a string value given by pointer and length
+      Statement& setString(const std::string& col, const char* data, std::size_t length)
+        { _stmt->setString(col, data, length); return *this; }
+
+      /** Set the host variable with the given name to a string value without copying it
+
+          The data must stay valid and unchanged until the statement is executed.
+          This avoids copying large values.
+       */
+      Statement& setStringRef(const std::string& col, const char* data, std::size_t length)
+        { _stmt->setStringRef(col, data, length); return *this; }
+
+      /// Set the host variable with the given name to a string value without copying it
+      Statement& setStringRef(const std::string& col, const std::string& data)
+        { _stmt->setStringRef(col, data.c_str(), data.size()); return *this; }
+
+      /** Set the host variable with the given name to binary data without copying it
+
+          The data must stay valid and unchanged until the statement is executed.
+       */
+      Statement& setBlobRef(const std::string& col, const char* data, std::size_t length)
+        { _stmt->setBlobRef(col, data, length); return *this; }
 
       /// Set the host variable with the given name to a unicode string value
       Statement& setUString(const std::string& col, const cxxtools::String& data)
         { _stmt->setUString(col, data); return *this; }
 
-      /// Set the host variable with the given name to a blob value
+      /** Set the host variable with the given name to a blob value
+
+          The drivers share the blob data with the statement instead of
+          copying it. Blob is copy-on-write, so the caller may assign new
+          data to its blob afterwards.
+       */
       Statement& setBlob(const std::string& col, const Blob& data)
         { _stmt->setBlob(col, data); return *this; }
 
@@ -206,6 +238,14 @@ namespace tntdb
       template <typename Iterator>
       Statement& set(const std::string& col, Iterator it1, Iterator it2);
 
+      /** Set the host variables named like the members of the struct
+
+          T must be mapped with TNTDB_MAP from <tntdb/structmap.h>. Members
+          without a host variable of the same name are ignored.
+       */
+      template <typename T>
+      Statement& setStruct(const T& data);
+
       /** Set the host variable with the given name to the passed value or null
 
           The method sets the host variable to the given value if the 2nd
@@ -221,6 +261,145 @@ namespace tntdb
         return *this;
       }
 
+      /** Return the index of the host variable with the given name
+
+          The setters taking an index set the host variable without looking
+          up its name again, which helps when a statement is executed
+          repeatedly in a loop. When the statement has no such host variable,
+          IStatement::npos is returned and setting it is ignored.
+       */
+      size_type paramIndex(const std::string& col)
+        { return _stmt->paramIndex(col); }
+
+      /// Like paramIndex, but no warning is logged for a missing host variable
+      size_type findParam(const std::string& col)
+        { return _stmt->findParam(col); }
+
+      /** Return a handle for the host variable with the given name
+
+          The name is resolved only once:
+
+          @code
+            tntdb::Statement stmt = conn.prepare("insert into tab1(a) values(:a)");
+            tntdb::Statement::Param a = stmt.param("a");
+            for (int n = 0; n < 1000; ++n)
+              a.set(n).execute();
+          @endcode
+       */
+      Param param(const std::string& col);
+
+      /// Set the host variable with the given index to NULL
+      Statement& setNull(size_type idx)
+        { _stmt->setNull(idx); return *this; }
+
+      /// Set the host variable with the given index to a boolean value
+      Statement& setBool(size_type idx, bool data)
+        { _stmt->setBool(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a short value
+      Statement& setShort(size_type idx, short data)
+        { _stmt->setShort(idx, data); return *this; }
+
+      /// Set the host variable with the given index to an int value
+      Statement& setInt(size_type idx, int data)
+        { _stmt->setInt(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a long value
+      Statement& setLong(size_type idx, long data)
+        { _stmt->setLong(idx, data); return *this; }
+
+      /// Set the host variable with the given index to an unsigned short value
+      Statement& setUnsignedShort(size_type idx, unsigned short data)
+        { _stmt->setUnsignedShort(idx, data); return *this; }
+
+      /// Set the host variable with the given index to an unsigned value
+      Statement& setUnsigned(size_type idx, unsigned data)
+        { _stmt->setUnsigned(idx, data); return *this; }
+
+      /// Set the host variable with the given index to an unsigned long value
+      Statement& setUnsignedLong(size_type idx, unsigned long data)
+        { _stmt->setUnsignedLong(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a int32_t value
+      Statement& setInt32(size_type idx, int32_t data)
+        { _stmt->setInt32(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a uint32_t value
+      Statement& setUnsigned32(size_type idx, uint32_t data)
+        { _stmt->setUnsigned32(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a int64_t value
+      Statement& setInt64(size_type idx, int64_t data)
+        { _stmt->setInt64(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a uint64_t value
+      Statement& setUnsigned64(size_type idx, uint64_t data)
+        { _stmt->setUnsigned64(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a Decimal
+      Statement& setDecimal(size_type idx, const Decimal& data)
+        { _stmt->setDecimal(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a float value
+      Statement& setFloat(size_type idx, float data)
+        { _stmt->setFloat(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a double value
+      Statement& setDouble(size_type idx, double data)
+        { _stmt->setDouble(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a char value
+      Statement& setChar(size_type idx, char data)
+        { _stmt->setChar(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a string value
+      Statement& setString(size_type idx, const std::string& data)
+        { _stmt->setString(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a string value or null
+      Statement& setString(size_type idx, const char* data)
+        { data == 0 ? _stmt->setNull(idx)
+                    : _stmt->setString(idx, data, std::strlen(data)); return *this; }
+
+      /// Set the host variable with the given index to a string value given by pointer and length
+      Statement& setString(size_type idx, const char* data, std::size_t length)
+        { _stmt->setString(idx, data, length); return *this; }
+
+      /// Set the host variable with the given index to a string value without copying it
+      Statement& setStringRef(size_type idx, const char* data, std::size_t length)
+        { _stmt->setStringRef(idx, data, length); return *this; }
+
+      /// Set the host variable with the given index to a string value without copying it
+      Statement& setStringRef(size_type idx, const std::string& data)
+        { _stmt->setStringRef(idx, data.c_str(), data.size()); return *this; }
+
+      /// Set the host variable with the given index to binary data without copying it
+      Statement& setBlobRef(size_type idx, const char* data, std::size_t length)
+        { _stmt->setBlobRef(idx, data, length); return *this; }
+
+      /// Set the host variable with the given index to a unicode string value
+      Statement& setUString(size_type idx, const cxxtools::String& data)
+        { _stmt->setUString(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a blob value
+      Statement& setBlob(size_type idx, const Blob& data)
+        { _stmt->setBlob(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a date value
+      Statement& setDate(size_type idx, const Date& data)
+        { data.isNull() ? _stmt->setNull(idx)
+                        : _stmt->setDate(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a time value
+      Statement& setTime(size_type idx, const Time& data)
+        { data.isNull() ? _stmt->setNull(idx)
+                        : _stmt->setTime(idx, data); return *this; }
+
+      /// Set the host variable with the given index to a datetime value
+      Statement& setDatetime(size_type idx, const Datetime& data)
+        { data.isNull() ? _stmt->setNull(idx)
+                        : _stmt->setDatetime(idx, data); return *this; }
+
       /// Statement execution methods
       /// @{
       /** Execute the query without returning the result
@@ -230,6 +409,32 @@ namespace tntdb
        */
       size_type execute();
 
+      /** Execute the query once for each row of the batch
+
+          The parameters of each row are taken from the batch. Drivers send
+          many rows at once where the database supports it. Returns the number
+          of affected rows. When a row fails, a BatchError is thrown, which
+          tells the index of the row and the number of rows affected by the
+          part of the batch, which was kept.
+
+          Outside of a transaction the drivers keep different parts of a
+          failed batch:
+           - sqlite runs the batch in a transaction and rolls back all rows.
+           - postgresql and oracle send the rows in chunks and commit each
+             chunk on its own. The failing chunk is rolled back; the chunks
+             before are kept.
+           - mysql sends the rows in multi row statements. When one fails,
+             its rows are executed one by one, so the rows before the failing
+             row are kept. The failing statement must not have written rows,
+             which holds for transactional engines like InnoDB only.
+           - Drivers without a native batch execute and commit row by row, so
+             the rows before the failing row are kept.
+
+          Use a transaction, if the rows before the failing row must not be
+          kept.
+       */
+      size_type executeBatch(const Batch& batch);
+
       /** Execute the query and return the result
 
           The query normally is a SELECT statement.
@@ -246,6 +451,28 @@ namespace tntdb
           If the result is empty, a NotFound exception is thrown. Additional values are ignored.
        */
       Value selectValue();
+
+      /** Execute the query and append the rows to the vector
+
+          T must be mapped with TNTDB_MAP from <tntdb/structmap.h>. Each
+          member is read from the column with the same name. Returns the
+          number of rows appended.
+
+          The rows are read with forEach, so the driver reuses one row for all
+          rows and no Result is built. The columns are looked up once and the
+          members are read with the typed getters, which create no Value
+          objects.
+       */
+      template <typename T>
+      size_type selectInto(std::vector<T>& ret);
+
+      /** Execute the query and pass each row to the visitor
+
+          The rows are not collected in a result. The row passed to the
+          visitor is valid only during the call (see RowVisitor). Returns the
+          number of rows.
+       */
+      size_type forEach(RowVisitor& visitor, unsigned fetchsize = 100);
       /// @}
 
       /// Create a database cursor and fetch the first row of the query result
@@ -282,61 +509,68 @@ namespace tntdb
     private:
       Statement& _stmt;
       const std::string& _name;
+      IStatement::size_type _idx;
+      bool _resolved;
 
     public:
       Hostvar(Statement& stmt, const std::string& name)
         : _stmt(stmt),
-          _name(name)
+          _name(name),
+          _idx(IStatement::npos),
+          _resolved(false)
+          { }
+      /// Hostvar with the index resolved already (see Statement::param)
+      Hostvar(Statement& stmt, const std::string& name, IStatement::size_type idx)
+        : _stmt(stmt),
+          _name(name),
+          _idx(idx),
+          _resolved(true)
           { }
       Statement& getStatement()    { return _stmt; }
       const std::string& getName() { return _name; }
 
       void setNull()
-        { _stmt.setNull(_name); }
+        { _resolved ? _stmt.setNull(_idx) : _stmt.setNull(_name); }
       void setBool(bool data)
-        { _stmt.setBool(_name, data); }
+        { _resolved ? _stmt.setBool(_idx, data) : _stmt.setBool(_name, data); }
       void setInt(int data)
-        { _stmt.setInt(_name, data); }
+        { _resolved ? _stmt.setInt(_idx, data) : _stmt.setInt(_name, data); }
       void setLong(long data)
-        { _stmt.setLong(_name, data); }
+        { _resolved ? _stmt.setLong(_idx, data) : _stmt.setLong(_name, data); }
       void setUnsigned(unsigned data)
-        { _stmt.setUnsigned(_name, data); }
+        { _resolved ? _stmt.setUnsigned(_idx, data) : _stmt.setUnsigned(_name, data); }
       void setUnsignedLong(unsigned long data)
-        { _stmt.setUnsignedLong(_name, data); }
+        { _resolved ? _stmt.setUnsignedLong(_idx, data) : _stmt.setUnsignedLong(_name, data); }
       void setInt32(int32_t data)
-        { _stmt.setInt32(_name, data); }
+        { _resolved ? _stmt.setInt32(_idx, data) : _stmt.setInt32(_name, data); }
       void setUnsigned32(uint32_t data)
-        { _stmt.setUnsigned32(_name, data); }
+        { _resolved ? _stmt.setUnsigned32(_idx, data) : _stmt.setUnsigned32(_name, data); }
       void setInt64(int64_t data)
-        { _stmt.setInt64(_name, data); }
+        { _resolved ? _stmt.setInt64(_idx, data) : _stmt.setInt64(_name, data); }
       void setUnsigned64(uint64_t data)
-        { _stmt.setUnsigned64(_name, data); }
+        { _resolved ? _stmt.setUnsigned64(_idx, data) : _stmt.setUnsigned64(_name, data); }
       void setDecimal(const Decimal& data)
-        { _stmt.setDecimal(_name, data); }
+        { _resolved ? _stmt.setDecimal(_idx, data) : _stmt.setDecimal(_name, data); }
       void setFloat(float data)
-        { _stmt.setFloat(_name, data); }
+        { _resolved ? _stmt.setFloat(_idx, data) : _stmt.setFloat(_name, data); }
       void setDouble(double data)
-        { _stmt.setDouble(_name, data); }
+        { _resolved ? _stmt.setDouble(_idx, data) : _stmt.setDouble(_name, data); }
       void setChar(char data)
-        { _stmt.setChar(_name, data); }
+        { _resolved ? _stmt.setChar(_idx, data) : _stmt.setChar(_name, data); }
       void setString(const std::string& data)
-        { _stmt.setString(_name, data); }
+        { _resolved ? _stmt.setString(_idx, data) : _stmt.setString(_name, data); }
       void setString(const char* data)
-        { data == 0 ? _stmt.setNull(_name)
-                    : _stmt.setString(_name, data); }
+        { _resolved ? _stmt.setString(_idx, data) : _stmt.setString(_name, data); }
       void setUString(const cxxtools::String& data)
-        { _stmt.setUString(_name, data); }
+        { _resolved ? _stmt.setUString(_idx, data) : _stmt.setUString(_name, data); }
       void setBlob(const Blob& data)
-        { _stmt.setBlob(_name, data); }
+        { _resolved ? _stmt.setBlob(_idx, data) : _stmt.setBlob(_name, data); }
       void setDate(const Date& data)
-        { data.isNull() ? _stmt.setNull(_name)
-                        : _stmt.setDate(_name, data); }
+        { _resolved ? _stmt.setDate(_idx, data) : _stmt.setDate(_name, data); }
       void setTime(const Time& data)
-        { data.isNull() ? _stmt.setNull(_name)
-                        : _stmt.setTime(_name, data); }
+        { _resolved ? _stmt.setTime(_idx, data) : _stmt.setTime(_name, data); }
       void setDatetime(const Datetime& data)
-        { data.isNull() ? _stmt.setNull(_name)
-                        : _stmt.setDatetime(_name, data); }
+        { _resolved ? _stmt.setDatetime(_idx, data) : _stmt.setDatetime(_name, data); }
 
       template <typename T>
       void set(const T& data);
@@ -452,6 +686,55 @@ namespace tntdb
   template <typename T>
   void Hostvar::set(const T& data)
     { *this << data; }
+
+  /** A host variable of a statement with its index resolved
+
+      Setting a value through this handle does not need to look up the name
+      of the host variable (see Statement::param).
+   */
+  class Statement::Param
+  {
+      Statement _stmt;
+      std::string _name;
+      size_type _idx;
+
+    public:
+      Param()
+        : _idx(IStatement::npos)
+        { }
+
+      Param(const Statement& stmt, const std::string& name)
+        : _stmt(stmt),
+          _name(name),
+          _idx(_stmt.paramIndex(name))
+        { }
+
+      const std::string& getName() const  { return _name; }
+      /// Returns the index of the host variable or IStatement::npos if the statement has none
+      size_type getIndex() const          { return _idx; }
+      Statement& getStatement()           { return _stmt; }
+
+      /// Set the host variable to NULL
+      Statement& setNull()
+        { return _stmt.setNull(_idx); }
+
+      /// Set the host variable to the passed value (see Statement::set)
+      template <typename T>
+      Statement& set(const T& data)
+      {
+        Hostvar h(_stmt, _name, _idx);
+        h << data;
+        return _stmt;
+      }
+
+      /// Set the host variable to the passed value or null
+      template <typename T>
+      Statement& setIf(bool notNull, const T& data)
+        { return notNull ? set(data) : setNull(); }
+  };
+
+  inline Statement::Param Statement::param(const std::string& col)
+    { return Param(*this, col); }
 }
 
 #endif // TNTDB_BITS_STATEMENT_H
@@ -33,6 +33,7 @@
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/statement.h>
 #include <iterator>
+#include <vector>
 
 namespace tntdb
 {
@@ -46,6 +47,7 @@ namespace tntdb
   {
       Row current;
       cxxtools::SmartPtr<ICursor> cursor;
+      std::vector<Row::size_type> structColumns;
 
     public:
       const_iterator(ICursor* cursor_ = 0);
@@ -87,6 +89,21 @@ namespace tntdb
       template <typename T>
       RowReader get(T& ret, bool& nullInd) const;
 
+      /**
+       * Reads the current row into a struct mapped with TNTDB_MAP from
+       * <tntdb/structmap.h> and fetches the next row. Returns false, when
+       * there are no more rows. The columns of the members are looked up at
+       * the first call.
+       *
+       * \code
+       *   Order order;
+       *   for (tntdb::Cursor cur = stmt.begin(); cur.fetchInto(order); )
+       *     process(order);
+       * \endcode
+       */
+      template <typename T>
+      bool fetchInto(T& obj);
+
       /**
        * Returns the actual implementation-class.
        */
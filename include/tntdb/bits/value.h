@@ -46,12 +46,24 @@ namespace tntdb
   class Value
   {
       cxxtools::SmartPtr<IValue> value;
+      cxxtools::SmartPtr<cxxtools::RefCounted> owner;
 
     public:
       explicit Value(IValue* value = 0)
         : value(value)
         { }
 
+      /// Creates a value, which is stored in and keeps alive its owner, typically a row
+      Value(IValue* value, cxxtools::RefCounted* owner)
+        : value(value),
+          owner(owner)
+        { }
+
+      // The value may live in its owner, so it is released before the owner.
+      // Assignment releases the members in declaration order as well.
+      ~Value()
+        { value = 0; }
+
       //@{
       /**
        * Explicit data-access.
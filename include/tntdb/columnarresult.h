@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TNTDB_COLUMNARRESULT_H
+#define TNTDB_COLUMNARRESULT_H
+
+#include <tntdb/bits/result.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+namespace tntdb
+{
+  /**
+   * Column oriented view of a result set.
+   *
+   * Each column is decoded once into a contiguous vector of the requested
+   * type and a null bitmap, so that aggregations can run tight loops over
+   * the values instead of accessing each value through Row and Value.
+   * The vectors are decoded on first access and kept, until the object is
+   * destroyed.
+   *
+   * Example:
+   * @code
+   *   tntdb::ColumnarResult cr(conn.select("select amount, price from orders"));
+   *   const std::vector<int64_t>& amount = cr.getInt64Column(0);
+   *   const std::vector<double>& price = cr.getDoubleColumn(1);
+   *   double sum = 0;
+   *   for (unsigned n = 0; n < cr.size(); ++n)
+   *     sum += amount[n] * price[n];
+   * @endcode
+   */
+  class ColumnarResult
+  {
+    public:
+      typedef unsigned size_type;
+
+    private:
+      struct Column
+      {
+        enum {
+          INT64 = 1,
+          DOUBLE = 2,
+          STRING = 4
+        };
+
+        unsigned decoded;
+        std::vector<int64_t> int64Values;
+        std::vector<double> doubleValues;
+        std::vector<std::string> stringValues;
+        std::vector<bool> nulls;
+
+        Column()
+          : decoded(0)
+          { }
+      };
+
+      Result _result;
+      mutable std::vector<Column> _columns;
+
+      Column& column(size_type field_num) const;
+
+    public:
+      ColumnarResult()  { }
+      explicit ColumnarResult(const Result& result);
+
+      /// Returns the number of rows.
+      size_type size() const            { return !_result ? 0 : _result.size(); }
+      /// Returns the number of columns.
+      size_type getFieldCount() const   { return _columns.size(); }
+
+      /// Returns the column as 64 bit integers; null values are 0.
+      const std::vector<int64_t>& getInt64Column(size_type field_num) const;
+      /// Returns the column as doubles; null values are 0.
+      const std::vector<double>& getDoubleColumn(size_type field_num) const;
+      /// Returns the column as strings; null values are empty.
+      const std::vector<std::string>& getStringColumn(size_type field_num) const;
+
+      /// Returns a vector with a flag for each row, which is set when the value is null.
+      const std::vector<bool>& getNulls(size_type field_num) const;
+      /// Returns true, when the value of the given row is null.
+      bool isNull(size_type field_num, size_type row_num) const
+        { return getNulls(field_num)[row_num]; }
+
+      /// Returns the underlying result.
+      const Result& getResult() const   { return _result; }
+  };
+}
+
+#endif // TNTDB_COLUMNARRESULT_H
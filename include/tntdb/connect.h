@@ -29,8 +29,10 @@
 #ifndef TNTDB_CONNECT_H
 #define TNTDB_CONNECT_H
 
+#include <iosfwd>
 #include <string>
 #include <tntdb/connection.h>
+#include <tntdb/poolstatistics.h>
 
 namespace tntdb
 {
@@ -63,6 +65,13 @@ namespace tntdb
    */
   Connection connectCached(const std::string& url);
 
+  /** Fetch a connection from a pool or create a new one waiting at most msecs milliseconds
+
+      When the maximum pool size is reached and no connection is returned to
+      the pool in time, tntdb::PoolTimeout is thrown.
+   */
+  Connection connectCached(const std::string& url, long msecs);
+
   /// Release unused connections; keep the given number of connections
   void dropCached(unsigned keep = 0);
 
@@ -84,6 +93,155 @@ namespace tntdb
 
   /// Get the current setting for maximum pool size (see setMaxPoolSize())
   unsigned getMaxPoolSize();
+
+  /** Set the default time in milliseconds connectCached waits for a connection
+
+      Waiting callers are served in the order they arrived. When no connection
+      gets available in time, tntdb::PoolTimeout is thrown. A negative value,
+      which is the default, waits forever.
+   */
+  void setPoolTimeout(long msecs);
+
+  /// Get the current setting for the pool timeout (see setPoolTimeout())
+  long getPoolTimeout();
+
+  /** Set the maximum number of callers waiting for a connection of a pool
+
+      When that number of callers already wait, connectCached throws
+      tntdb::PoolExhausted immediately. 0 means unlimited.
+   */
+  void setPoolMaxWaiters(unsigned n);
+
+  /// Get the current setting for the maximum number of waiting callers (see setPoolMaxWaiters())
+  unsigned getPoolMaxWaiters();
+
+  /** Get a snapshot of the state and counters of the pool for the given url
+
+      The result can be serialized with cxxtools, e.g. to export it as json:
+
+      @code
+        cxxtools::JsonSerializer serializer(std::cout);
+        serializer.serialize(tntdb::getPoolStatistics(url), "pool").finish();
+      @endcode
+   */
+  PoolStatistics getPoolStatistics(const std::string& url);
+
+  /** Enable or disable the per thread connection cache of the pools
+
+      When enabled, a connection released by a thread is kept for this thread
+      and returned by its next call to connectCached without locking the
+      shared pool. Other threads take such connections over, when they would
+      have to wait otherwise.
+   */
+  void setPoolThreadCache(bool enable);
+
+  /** Set the maximum lifetime of pooled connections in milliseconds
+
+      Older connections are released, when they are returned to the pool or
+      by the maintainer thread. 0, which is the default, means unlimited.
+   */
+  void setPoolMaxLifetime(unsigned msecs);
+
+  /** Set the time in milliseconds after which the maintainer thread releases
+      unused connections
+
+      The minimum number of unused connections (see setPoolMinIdle()) is kept.
+      0, which is the default, disables the idle timeout.
+   */
+  void setPoolIdleTimeout(unsigned msecs);
+
+  /** Start a background thread, which maintains the connection pools
+
+      The thread runs every intervalMsecs milliseconds. It releases connections
+      which exceed the maximum lifetime or idle timeout, validates unused
+      connections with a ping outside of connectCached and establishes missing
+      connections up to the minimum idle size.
+   */
+  void startPoolMaintainer(unsigned intervalMsecs = 1000);
+
+  /// Stop the background thread started with startPoolMaintainer()
+  void stopPoolMaintainer();
+
+  /** Set the time in milliseconds after which a pooled connection is
+      validated with a ping before connectCached returns it
+
+      Connections, which were returned to the pool more recently, are just
+      checked locally. When the first operation on such a connection fails
+      since the connection is dead, a new connection is established and the
+      operation is repeated transparently.
+
+      This applies to the operations of the connection itself (execute,
+      select, prepare and transactions). A statement is bound to the
+      connection it was prepared on, so executing a prepared statement on
+      a dead connection throws and is not repeated. Call
+      Connection::ping() first, when the statement must not fail, or set
+      the validation idle time to 0 to ping on every checkout.
+   */
+  void setPoolValidationIdleTime(unsigned msecs);
+
+  /// Get the current setting for the validation idle time (see setPoolValidationIdleTime())
+  unsigned getPoolValidationIdleTime();
+
+  /** Set the minimum number of unused connections in a pool
+
+      When a new connection pool is created, it establishes that number of
+      connections in the background, so that the first requests do not have
+      to wait for a connection to the database.
+   */
+  void setPoolMinIdle(unsigned n);
+
+  /// Get the current setting for the minimum number of unused connections (see setPoolMinIdle())
+  unsigned getPoolMinIdle();
+
+  /** Fill the pool for the given url with the minimum number of unused connections
+
+      The connections are established concurrently by up to the given number
+      of threads. Connections are available for connectCached as soon as they
+      are established. When wait is false, the function returns immediately.
+   */
+  void warmUpCached(const std::string& url, unsigned threads = 4, bool wait = false);
+
+  /** Register a statement, which is prepared on every new connection of the pool for the given url
+
+      Before connectCached returns a new connection the first time, the
+      statement is put into its statement cache with the given key and
+      prepared in the database, so that prepareCached(query, key) does not
+      need a roundtrip. Statements, which can't be prepared, are logged and
+      prepared on first use as usual.
+   */
+  void registerCachedStatement(const std::string& url, const std::string& key,
+    const std::string& query);
+
+  /// Remove a statement registered with registerCachedStatement()
+  bool unregisterCachedStatement(const std::string& url, const std::string& key);
+
+  /** Prepare the registered statements only on connections established by
+      the warm up and maintainer threads
+
+      Connections, which connectCached has to establish itself, then prepare
+      the statements on first use.
+   */
+  void setPoolPrepareInBackground(bool sw);
+
+  /// Register every statement passed to prepareCached on pooled connections automatically
+  void setPoolRecordStatements(bool sw);
+
+  /** Set the maximum number of registered statements per pool; 0 means unlimited
+
+      When the limit is reached, the least recently used statement is removed
+      from the registry (default ConnectionPool::defaultMaxStatements).
+   */
+  void setPoolMaxStatements(unsigned n);
+
+  /** Write the registered statements of the pool for the given url to a stream
+
+      Together with loadCachedStatements() and setPoolRecordStatements() the
+      statements used by one process can be prepared in advance by the next one.
+   */
+  void dumpCachedStatements(const std::string& url, std::ostream& out);
+
+  /// Register the statements written by dumpCachedStatements()
+  void loadCachedStatements(const std::string& url, std::istream& in);
 }
 
 #endif // TNTDB_CONNECT_H
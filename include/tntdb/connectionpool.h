@@ -29,47 +29,319 @@
 #ifndef TNTDB_CONNECTIONPOOL_H
 #define TNTDB_CONNECTIONPOOL_H
 
-#include <cxxtools/pool.h>
+#include <tntdb/connection.h>
+#include <tntdb/poolstatistics.h>
+#include <cxxtools/atomicity.h>
+#include <cxxtools/condition.h>
+#include <cxxtools/mutex.h>
+#include <cxxtools/timespan.h>
+#include <deque>
+#include <iosfwd>
+#include <list>
 #include <map>
 #include <string>
+#include <vector>
+
+namespace cxxtools
+{
+  class AttachedThread;
+}
 
 namespace tntdb
 {
-  class Connection;
+  class PoolConnection;
+  class ConnectionPools;
 
   class ConnectionPool
   {
-      class Connector
+      friend class PoolConnection;
+      friend class ConnectionPools;
+
+      ConnectionPool(const ConnectionPool&);
+      ConnectionPool& operator=(const ConnectionPool&);
+
+    public:
+      /// A database connection together with the bookkeeping data of the pool
+      struct Entry
+      {
+        Connection connection;
+        /// system ticks, when the connection was established
+        cxxtools::Timespan created;
+        /// system ticks, when the connection was put back into the pool
+        cxxtools::Timespan lastUsed;
+        /// system ticks, when the connection was found alive with a ping
+        cxxtools::Timespan lastValidated;
+        /// system ticks, when the connection was handed out
+        cxxtools::Timespan checkedOut;
+
+        Entry()
+          { }
+        explicit Entry(const Connection& connection_);
+      };
+
+      typedef Entry PoolObjectType;
+
+      /// registered statements: query indexed by the key of the statement cache
+      typedef std::map<std::string, std::string> StatementsType;
+
+    private:
+      typedef std::deque<Entry> IdleType;
+
+      // keys of the registered statements; most recently used first
+      typedef std::list<std::string> StatementOrderType;
+
+      struct RegisteredStatement
       {
-          std::string url;
+        std::string query;
+        StatementOrderType::iterator order;
+      };
 
-        public:
-          Connector(const std::string& url_)
-            : url(url_)
-            { }
+      typedef std::map<std::string, RegisteredStatement> RegistryType;
 
-          Connection* operator() ();
+      // a caller of connect waiting for a connection or for a free slot to
+      // create one
+      struct Waiter
+      {
+        cxxtools::Condition cond;
+        Entry entry;
+        bool served;
+
+        Waiter()
+          : served(false)
+          { }
       };
 
-      typedef cxxtools::Pool<Connection, Connector> PoolType;
-      PoolType pool;
+      typedef std::deque<Waiter*> WaitersType;
 
-    public:
-      typedef PoolType::Ptr PoolObjectType;
+      struct ThreadCache;
+
+      std::string url;
+      unsigned maxcount;
+      unsigned currentSize;   // connections owned by the pool (idle, in use and being established)
+      cxxtools::Timespan validationIdleTime;
+      cxxtools::Timespan maxLifetime;
+      cxxtools::Timespan idleTimeout;
+      IdleType idle;          // most recently used connection at the back
+      unsigned minIdle;
+      unsigned connecting;    // connections currently established by warm up threads
+      unsigned validating;    // idle connections currently pinged by maintain()
+      std::vector<cxxtools::AttachedThread*> warmUpThreads;
+      unsigned runningWarmUpThreads;
+      WaitersType waiters;    // FIFO queue of callers waiting for a connection
+      unsigned maxWaiters;
+      long timeout;
+      unsigned long waitCount;
+      unsigned long timeoutCount;
+      unsigned long rejectCount;
+      unsigned long createdCount;
+      unsigned long droppedDeadCount;
+      PoolHistogram checkoutWait;
+      PoolHistogram holdTime;
+      ThreadCache* threadCache;
+      volatile cxxtools::atomic_t useThreadCache;
+      volatile cxxtools::atomic_t waitingCount;  // like waiters.size() but readable without lock
+      RegistryType statements;
+      StatementOrderType statementOrder;
+      unsigned maxStatements;
+      bool prepareInBackground;
+      bool statementCaching;
+      volatile cxxtools::atomic_t recordStatements;
+      volatile cxxtools::atomic_t users;   // callers of ConnectionPools using the pool without lock
+      mutable cxxtools::Mutex mutex;
+
+      Entry create(bool background = false);
+      void prepareStatements(Connection& conn);
+      void recordStatement(const std::string& key, const std::string& query);
+      void putStatement(const std::string& key, const std::string& query);
+      void warmUpConnections();
+      void runWarmUpThread();
+      void joinWarmUpThreads(bool wait = true);
+      unsigned countParked() const;
+      bool validate(Entry& entry);
+      void put(Entry& entry);
+      void handOver(Entry& entry);
+      void discard(Entry& entry);
+      void release(Entry& entry, bool reuse);
+      void droppedDead();
+      Connection checkedOut(const Connection& conn, const cxxtools::Timespan& start);
+
+      static void releaseThreadSlot(void* slot);
+      bool parkInThreadCache(Entry& entry);
+      bool takeFromThreadCache(Entry& entry);
+      bool stealFromThreadCaches(Entry& entry);
+      void drainThreadCaches();
+      void serveWaiters();
+      Connection createConnection();
 
     public:
-      explicit ConnectionPool(const std::string& url, unsigned maxcount = 0)
-        : pool(maxcount, Connector(url))
-        { }
+      /// default for the validation idle time in milliseconds
+      static const unsigned defaultValidationIdleTime = 1000;
+      /// default for the maximum number of registered statements
+      static const unsigned defaultMaxStatements = 256;
+
+      /// Creates a pool and starts to establish minIdle connections in the background
+      explicit ConnectionPool(const std::string& url, unsigned maxcount = 0,
+        unsigned minIdle = 0);
+      ~ConnectionPool();
 
+      /// Fetches a connection using the default timeout (see setTimeout())
       Connection connect();
 
+      /** Fetches a connection from the pool or creates a new one.
+
+          When getMaximumSize() connections are in use, the caller waits in
+          a FIFO queue until a connection is returned to the pool. If no
+          connection gets available within msecs milliseconds, PoolTimeout
+          is thrown. A negative value waits forever. When getMaximumWaiters()
+          callers are already waiting, PoolExhausted is thrown immediately.
+       */
+      Connection connect(long msecs);
+
+      /** Establishes connections until the pool has getMinIdle() unused connections.
+
+          The connections are opened concurrently using up to the given number of
+          threads. Each connection is available for connect() as soon as it is
+          established. Unless wait is set, the method returns immediately.
+       */
+      void warmUp(unsigned threads = 4, bool wait = false);
+
       /// Release unused connections; keep the given number of connections
-      void drop(unsigned keep = 0)    { pool.drop(keep); }
+      void drop(unsigned keep = 0);
+
+      /// Returns the maximum number of connections of the pool; 0 means unlimited
+      unsigned getMaximumSize()       { return maxcount; }
+      void setMaximumSize(unsigned m);
+      /// Returns the number of unused connections including the ones kept in thread caches
+      unsigned getCurrentSize() const;
+      /// Returns the number of connections owned by the pool including the ones in use
+      unsigned getTotalSize() const;
+
+      /** Sets the time in milliseconds after which an unused connection is
+          validated with a ping before it is handed out again.
+
+          Connections, which were used more recently, are just checked locally
+          without a roundtrip to the database. When the first operation on
+          such a connection fails because the connection is dead, it is
+          silently replaced with a new one.
+       */
+      void setValidationIdleTime(unsigned msecs);
+      unsigned getValidationIdleTime() const;
+
+      /// Sets the number of unused connections warmUp() establishes
+      void setMinIdle(unsigned n);
+      unsigned getMinIdle() const;
+
+      /// Sets the default timeout of connect() in milliseconds; negative values wait forever
+      void setTimeout(long msecs);
+      long getTimeout() const;
+
+      /// Sets the maximum number of callers waiting for a connection; 0 means unlimited
+      void setMaximumWaiters(unsigned n);
+      unsigned getMaximumWaiters() const;
+
+      /// Returns the number of callers currently waiting for a connection
+      unsigned getWaiting() const;
+      /// Returns the number of calls to connect, which had to wait for a connection
+      unsigned long getWaitCount() const;
+      /// Returns the number of calls to connect, which timed out
+      unsigned long getTimeoutCount() const;
+      /// Returns the number of calls to connect, which were rejected since the queue was full
+      unsigned long getRejectCount() const;
+
+      /// Returns a snapshot of the state and the counters of the pool
+      PoolStatistics getStatistics() const;
+
+      /** Does the housekeeping of the unused connections.
 
-      unsigned getMaximumSize()       { return pool.getMaximumSize(); }
-      void setMaximumSize(unsigned m) { pool.setMaximumSize(m); }
-      unsigned getCurrentSize() const { return pool.getCurrentSize(); }
+          Connections older than the maximum lifetime and connections unused
+          for longer than the idle timeout are released, but no more than
+          needed to keep getMinIdle() connections. Connections unused for
+          longer than the validation idle time are checked with a ping, so that
+          connect() does not need to. Finally missing connections up to the
+          minimum idle size are established.
+
+          This is called periodically by the maintainer thread of
+          ConnectionPools.
+       */
+      void maintain();
+
+      /// Sets the maximum lifetime of a connection in milliseconds; 0 means unlimited
+      void setMaxLifetime(unsigned msecs);
+      unsigned getMaxLifetime() const;
+
+      /// Sets the time in milliseconds after which maintain() releases unused connections; 0 disables it
+      void setIdleTimeout(unsigned msecs);
+      unsigned getIdleTimeout() const;
+
+      /** Enables or disables the per thread connection cache.
+
+          When enabled, a released connection is kept in a cache of the
+          releasing thread and the next connect() of that thread returns it
+          without locking the pool. Other threads take it over, when they
+          would have to wait for a connection otherwise.
+
+          Each pool uses a thread specific key of the process. When the
+          process has no free key left, the cache stays disabled.
+       */
+      void setThreadCache(bool enable);
+      bool getThreadCache() const;
+
+      /** Registers a statement, which is prepared on each new connection of the pool.
+
+          The statement is put into the statement cache of the connection
+          with the given key before the connection is handed out the first
+          time, so that Connection::prepareCached(query, key) finds it
+          already prepared in the database. Connections established before
+          the statement was registered prepare it on first use as usual.
+       */
+      void registerStatement(const std::string& key, const std::string& query);
+      /// Registers a statement using the query as key like Connection::prepareCached(query)
+      void registerStatement(const std::string& query)
+        { registerStatement(query, query); }
+      /// Removes a statement from the registry; returns false if the key was not registered
+      bool unregisterStatement(const std::string& key);
+      /// Returns a copy of the registered statements
+      StatementsType getStatements() const;
+
+      /** Sets the maximum number of registered statements; 0 means unlimited.
+
+          When a statement is registered or recorded and the registry is
+          full, the least recently used statement is removed from it.
+       */
+      void setMaxStatements(unsigned n);
+      unsigned getMaxStatements() const;
+
+      /** Prepares the registered statements only on connections established
+          in the background by warmUp() and maintain().
+
+          Connections created by connect() then prepare the statements on
+          first use, so that the caller does not have to wait for them.
+       */
+      void setPrepareInBackground(bool sw);
+      bool getPrepareInBackground() const;
+
+      /** Enables statement caching on each new connection of the pool.
+
+          See Connection::setStatementCaching. Connections established
+          before are not changed.
+       */
+      void setStatementCaching(bool sw);
+      bool getStatementCaching() const;
+
+      /** Registers every statement passed to prepareCached of a connection
+          of the pool automatically.
+
+          Together with dumpStatements() and loadStatements() this makes the
+          set of statements observed by one process available to the
+          connections of the next one.
+       */
+      void setRecordStatements(bool sw);
+      bool getRecordStatements() const;
+
+      /// Writes the registered statements to the stream; one line per statement
+      void dumpStatements(std::ostream& out) const;
+      /// Registers the statements written by dumpStatements()
+      void loadStatements(std::istream& in);
   };
 
   class ConnectionPools
@@ -82,17 +354,59 @@ namespace tntdb
       typedef std::map<std::string, PoolType*> PoolsType;
 
     private:
-      PoolsType pools;
+      // The map of pools is never modified but replaced by a modified copy,
+      // so that connect() can look up pools without locking. Threads, which
+      // read the map without lock, are counted in readers and pin the pool
+      // they use. Replaced maps and removed pools are deleted, when no reader
+      // is active and the pool is neither pinned nor has connections.
+      class PoolRef;
+      friend class PoolRef;
+
+      void* volatile pools;
+      volatile cxxtools::atomic_t readers;
+      volatile cxxtools::atomic_t retiredCount;
+      std::vector<PoolsType*> retiredMaps;
+      std::vector<PoolType*> retiredPools;
       unsigned maxcount;
+      unsigned validationIdleTime;
+      unsigned minIdle;
+      long timeout;
+      unsigned maxWaiters;
+      bool threadCache;
+      unsigned maxLifetime;
+      unsigned idleTimeout;
+      bool prepareInBackground;
+      bool recordStatements;
+      unsigned maxStatements;
+      bool statementCaching;
+      cxxtools::AttachedThread* maintainer;
+      unsigned maintainInterval;
+      bool maintainerRunning;
+      cxxtools::Condition maintainerCond;
       mutable cxxtools::Mutex mutex;
 
+      // only with the mutex locked
+      const PoolsType& getPools() const
+        { return *static_cast<const PoolsType*>(pools); }
+      const PoolsType& loadPools();
+      void enterReader();
+      void leaveReader();
+      void replacePools(PoolsType* newPools);
+      void reclaimRetired();
+      PoolType* pinPool(const std::string& url);
+      void unpinPool(PoolType* pool);
+      void runMaintainer();
+
     public:
-      explicit ConnectionPools(unsigned maxcount_ = 0)
-        : maxcount(maxcount_)
-        { }
+      explicit ConnectionPools(unsigned maxcount_ = 0);
       ~ConnectionPools();
 
       Connection connect(const std::string& url);
+      /// Fetches a connection waiting at most msecs milliseconds (see ConnectionPool::connect(long))
+      Connection connect(const std::string& url, long msecs);
+
+      /// Creates the pool for the given url if needed and fills it up to the minimum idle size
+      void warmUp(const std::string& url, unsigned threads = 4, bool wait = false);
 
       /// Release unused connections; keep the given number of connections
       void drop(unsigned keep = 0);
@@ -107,6 +421,84 @@ namespace tntdb
 
       void setMaximumSize(unsigned m);
       unsigned getCurrentSize(const std::string& url) const;
+
+      /// Returns the statistics of the pool for the given url; all values are 0 when there is no pool
+      PoolStatistics getStatistics(const std::string& url) const;
+
+      /// Returns the statistics of all pools indexed by url
+      std::map<std::string, PoolStatistics> getStatistics() const;
+
+      /// Sets the validation idle time of all pools (see ConnectionPool::setValidationIdleTime)
+      void setValidationIdleTime(unsigned msecs);
+      unsigned getValidationIdleTime() const
+        { return validationIdleTime; }
+
+      /// Sets the minimum number of unused connections; new pools are warmed up when created
+      void setMinIdle(unsigned n);
+      unsigned getMinIdle() const
+        { return minIdle; }
+
+      /// Sets the default timeout of all pools (see ConnectionPool::setTimeout)
+      void setTimeout(long msecs);
+      long getTimeout() const
+        { return timeout; }
+
+      /// Sets the maximum number of waiting callers of all pools (see ConnectionPool::setMaximumWaiters)
+      void setMaximumWaiters(unsigned n);
+      unsigned getMaximumWaiters() const
+        { return maxWaiters; }
+
+      /// Enables or disables the per thread connection cache of all pools (see ConnectionPool::setThreadCache)
+      void setThreadCache(bool enable);
+      bool getThreadCache() const
+        { return threadCache; }
+
+      /// Sets the maximum lifetime of connections of all pools (see ConnectionPool::setMaxLifetime)
+      void setMaxLifetime(unsigned msecs);
+      unsigned getMaxLifetime() const
+        { return maxLifetime; }
+
+      /// Sets the idle timeout of all pools (see ConnectionPool::setIdleTimeout)
+      void setIdleTimeout(unsigned msecs);
+      unsigned getIdleTimeout() const
+        { return idleTimeout; }
+
+      /// Registers a statement in the pool for the given url (see ConnectionPool::registerStatement)
+      void registerStatement(const std::string& url, const std::string& key,
+        const std::string& query);
+      /// Removes a statement from the registry of the pool for the given url
+      bool unregisterStatement(const std::string& url, const std::string& key);
+      /// Sets the maximum number of registered statements of all pools (see ConnectionPool::setMaxStatements)
+      void setMaxStatements(unsigned n);
+      unsigned getMaxStatements() const
+        { return maxStatements; }
+
+      /// Writes the registered statements of the pool for the given url to the stream
+      void dumpStatements(const std::string& url, std::ostream& out) const;
+      /// Registers the statements written by dumpStatements() in the pool for the given url
+      void loadStatements(const std::string& url, std::istream& in);
+
+      /// Sets whether all pools prepare registered statements in the background only (see ConnectionPool::setPrepareInBackground)
+      void setPrepareInBackground(bool sw);
+      bool getPrepareInBackground() const
+        { return prepareInBackground; }
+
+      /// Sets whether all pools register the statements used with prepareCached (see ConnectionPool::setRecordStatements)
+      void setRecordStatements(bool sw);
+      bool getRecordStatements() const
+        { return recordStatements; }
+
+      /// Enables statement caching on new connections of all pools (see ConnectionPool::setStatementCaching)
+      void setStatementCaching(bool sw);
+      bool getStatementCaching() const
+        { return statementCaching; }
+
+      /** Starts a thread, which calls ConnectionPool::maintain() of all pools
+          every intervalMsecs milliseconds.
+       */
+      void startMaintainer(unsigned intervalMsecs = 1000);
+      /// Stops the maintainer thread
+      void stopMaintainer();
   };
 }
 
@@ -86,12 +86,25 @@ namespace tntdb
       /// Get the date in ISO format (yyyy-mm-dd)
       std::string getIso() const;
 
+      /// Number of characters written by getIso(char*)
+      static const unsigned isoLength = 10;
+
+      /** Write the date in ISO format into buf and return the number of characters written.
+
+          The buffer must have room for isoLength characters. No terminating
+          zero is written.
+       */
+      unsigned getIso(char* buf) const;
+
       /** Construct a Date object from the given ISO date string
 
           If the string is not in ISO format, an exception of type tntdb::TypeError is thrown.
        */
       static Date fromIso(const std::string& s);
 
+      /// Construct a Date object from the ISO string at s with len characters
+      static Date fromIso(const char* s, unsigned len);
+
       bool operator== (const Date& dt) const
       {
         return _year == dt._year
@@ -116,12 +116,25 @@ namespace tntdb
       /// Get the date in ISO format (yyyy-mm-dd hh:mm:ss.hhh)
       std::string getIso() const;
 
+      /// Number of characters written by getIso(char*)
+      static const unsigned isoLength = 23;
+
+      /** Write the datetime in ISO format into buf and return the number of characters written.
+
+          The buffer must have room for isoLength characters. No terminating
+          zero is written.
+       */
+      unsigned getIso(char* buf) const;
+
       /** Construct a Datetime object from the given ISO datetime string
 
           If the string is not in ISO format, an exception of type tntdb::TypeError is thrown.
        */
       static Datetime fromIso(const std::string& s);
 
+      /// Construct a Datetime object from the ISO string at s with len characters
+      static Datetime fromIso(const char* s, unsigned len);
+
       /** Set the date and the time
 
           No range checks are done.
@@ -94,6 +94,10 @@ namespace tntdb
       void _setInteger(LongType l, short exponent);
       void _setUnsigned(UnsignedLongType l, short exponent);
 
+      void _parse(const char* value, std::string::size_type len);
+      void _printSci(std::string& ret) const;
+      void _printFix(std::string& ret) const;
+
     public:
       class Parser;
 
@@ -104,6 +108,9 @@ namespace tntdb
 
       explicit Decimal(const std::string& value);
 
+      /// Parses the text directly from a character buffer
+      Decimal(const char* value, std::string::size_type len);
+
       explicit Decimal(long mantissa, short exponent)
         { setInteger(mantissa, exponent); }
 
@@ -159,6 +166,8 @@ namespace tntdb
       }
 
       std::string toString() const;
+      /// Writes the text into ret, reusing its buffer
+      void toString(std::string& ret) const;
       std::string toStringSci() const;
       std::string toStringFix() const;
 
@@ -89,6 +89,48 @@ namespace tntdb
 
       const std::string& getField() const { return field; }
   };
+
+  /// Exception thrown when a row of a batch failed; getRow() returns its index
+  class BatchError : public Error
+  {
+      unsigned row;
+      std::string rowMessage;
+      unsigned affectedRows;
+
+    public:
+      BatchError(unsigned row, const std::string& msg, unsigned affectedRows = 0);
+      ~BatchError() throw() { }
+
+      unsigned getRow() const { return row; }
+      /// Returns the error message of the database for the failing row
+      const std::string& getRowMessage() const { return rowMessage; }
+      /// Returns the number of rows affected by the part of the batch, which was kept
+      unsigned getAffectedRows() const { return affectedRows; }
+  };
+
+  /// Exception thrown when no connection of a connection pool got available in time
+  class PoolTimeout : public Error
+  {
+      std::string url;
+
+    public:
+      explicit PoolTimeout(const std::string& url);
+      ~PoolTimeout() throw() { }
+
+      const std::string& getUrl() const { return url; }
+  };
+
+  /// Exception thrown when too many callers are already waiting for a connection of a pool
+  class PoolExhausted : public Error
+  {
+      std::string url;
+
+    public:
+      explicit PoolExhausted(const std::string& url);
+      ~PoolExhausted() throw() { }
+
+      const std::string& getUrl() const { return url; }
+  };
 }
 
 #endif // TNTDB_ERROR_H
@@ -31,6 +31,7 @@
 
 #include <cxxtools/refcounted.h>
 #include <cxxtools/smartptr.h>
+#include <tntdb/stmtcachestatistics.h>
 #include <string>
 #include <map>
 
@@ -41,6 +42,7 @@ namespace tntdb
   class Value;
   class Statement;
   class IStatement;
+  class StmtCache;
 
   class IConnection : public cxxtools::RefCounted
   {
@@ -60,19 +62,52 @@ namespace tntdb
       virtual void clearStatementCache() = 0;
       virtual bool clearStatementCache(const std::string& key) = 0;
       virtual bool ping() = 0;
+      /// Cheap local check without a roundtrip to the database; the default returns true
+      virtual bool isAlive();
+      /** Rolls back a pending transaction regardless of its nesting level and
+          releases table locks, so that the connection can be reused.
+
+          Returns false, when the connection can't be reset; the default does
+          not know the state of the connection and returns false.
+       */
+      virtual bool reset();
       virtual long lastInsertId(const std::string& name) = 0;
       virtual void lockTable(const std::string& tablename, bool exclusive) = 0;
+      /** Prepares a statement like prepare, but takes it from the statement
+          cache when statement caching is enabled; the default calls prepare.
+       */
+      virtual Statement prepareShared(const std::string& query);
+      /// Enables the statement cache for prepareShared; the default does nothing
+      virtual void setStatementCaching(bool sw);
+      /// Returns true, when prepareShared uses the statement cache; the default returns false
+      virtual bool getStatementCaching();
+      /// Limits the number of statements cached by prepareCached; the default does nothing
+      virtual void setStatementCacheCapacity(unsigned capacity);
+      /// Returns the counters of the statement cache; the default returns an empty statistic
+      virtual StmtCacheStatistics getStatementCacheStatistics();
   };
 
   class IStmtCacheConnection : public IConnection
   {
-      typedef std::map<std::string, cxxtools::SmartPtr<IStatement> > stmtCacheType;
-      stmtCacheType stmtCache;
+      StmtCache* stmtCache;
+      bool statementCaching;
+
+      // non copyable
+      IStmtCacheConnection(const IStmtCacheConnection&);
+      IStmtCacheConnection& operator=(const IStmtCacheConnection&);
 
     public:
+      IStmtCacheConnection();
+      ~IStmtCacheConnection();
+
       virtual Statement prepareCached(const std::string& query, const std::string& key);
       virtual void clearStatementCache();
       virtual bool clearStatementCache(const std::string& key);
+      virtual Statement prepareShared(const std::string& query);
+      virtual void setStatementCaching(bool sw);
+      virtual bool getStatementCaching();
+      virtual void setStatementCacheCapacity(unsigned capacity);
+      virtual StmtCacheStatistics getStatementCacheStatistics();
   };
 }
 
@@ -30,6 +30,9 @@
 #define TNTDB_IFACE_IRESULT_H
 
 #include <cxxtools/refcounted.h>
+#include <string>
+#include <vector>
+#include <stdint.h>
 
 namespace tntdb
 {
@@ -45,6 +48,20 @@ namespace tntdb
       virtual Row getRow(size_type tup_num) const = 0;
       virtual size_type size() const = 0;
       virtual size_type getFieldCount() const = 0;
+
+      /** Decodes one column of all rows into a vector.
+
+          The flag in nulls is set for each row, where the value is null;
+          the value is then 0 or empty. The default implementation reads
+          the values through getRow, so drivers override it to decode the
+          column directly from their buffers.
+       */
+      virtual void getColumn(size_type field_num, std::vector<int64_t>& values,
+        std::vector<bool>& nulls) const;
+      virtual void getColumn(size_type field_num, std::vector<double>& values,
+        std::vector<bool>& nulls) const;
+      virtual void getColumn(size_type field_num, std::vector<std::string>& values,
+        std::vector<bool>& nulls) const;
   };
 }
 
@@ -31,6 +31,7 @@
 
 #include <cxxtools/refcounted.h>
 #include <string>
+#include <stdint.h>
 
 namespace tntdb
 {
@@ -41,11 +42,35 @@ namespace tntdb
   {
     public:
       typedef unsigned size_type;
+      static const size_type npos = static_cast<size_type>(-1);
 
       virtual size_type size() const = 0;
       virtual Value getValueByNumber(size_type field_num) const = 0;
       virtual Value getValueByName(const std::string& field_name) const = 0;
       virtual std::string getColumnName(size_type field_num) const = 0;
+
+      /** Returns the index of the column with the given name.
+
+          When the row has no such column, npos is returned. The default
+          implementation compares the name with all column names; drivers
+          override it with a lookup in an index shared by all rows.
+       */
+      virtual size_type getColumnIndex(const std::string& field_name) const;
+
+      //@{
+      /** Typed access to the values of the row.
+
+          The default implementations read the value with getValueByNumber.
+          Drivers override them to convert directly from their buffers.
+       */
+      virtual bool isNull(size_type field_num) const;
+      virtual bool getBool(size_type field_num) const;
+      virtual int getInt(size_type field_num) const;
+      virtual int64_t getInt64(size_type field_num) const;
+      virtual uint64_t getUnsigned64(size_type field_num) const;
+      virtual double getDouble(size_type field_num) const;
+      virtual void getString(size_type field_num, std::string& ret) const;
+      //@}
   };
 }
 
@@ -32,6 +32,7 @@
 #include <cxxtools/refcounted.h>
 #include <cxxtools/string.h>
 #include <string>
+#include <cstddef>
 #include <stdint.h>
 
 namespace tntdb
@@ -45,42 +46,132 @@ namespace tntdb
   class Decimal;
   class ICursor;
   class Blob;
+  class Batch;
+  class RowVisitor;
 
   class IStatement : public cxxtools::RefCounted
   {
     public:
       typedef unsigned size_type;
 
+      /// Index of a host variable, which the statement does not have
+      static const size_type npos = static_cast<size_type>(-1);
+
       virtual void clear() = 0;
 
-      virtual void setNull(const std::string& col) = 0;
-      virtual void setBool(const std::string& col, bool data) = 0;
-      virtual void setShort(const std::string& col, short data) = 0;
-      virtual void setInt(const std::string& col, int data) = 0;
-      virtual void setLong(const std::string& col, long data) = 0;
-      virtual void setUnsignedShort(const std::string& col, unsigned short data) = 0;
-      virtual void setUnsigned(const std::string& col, unsigned data) = 0;
-      virtual void setUnsignedLong(const std::string& col, unsigned long data) = 0;
-      virtual void setInt32(const std::string& col, int32_t data) = 0;
-      virtual void setUnsigned32(const std::string& col, uint32_t data) = 0;
-      virtual void setInt64(const std::string& col, int64_t data) = 0;
-      virtual void setUnsigned64(const std::string& col, uint64_t data) = 0;
-      virtual void setDecimal(const std::string& col, const Decimal& data) = 0;
-      virtual void setFloat(const std::string& col, float data) = 0;
-      virtual void setDouble(const std::string& col, double data) = 0;
-      virtual void setChar(const std::string& col, char data) = 0;
-      virtual void setString(const std::string& col, const std::string& data) = 0;
-      virtual void setBlob(const std::string& col, const Blob& data) = 0;
-      virtual void setDate(const std::string& col, const Date& data) = 0;
-      virtual void setTime(const std::string& col, const Time& data) = 0;
-      virtual void setDatetime(const std::string& col, const Datetime& data) = 0;
+      /** Returns the index of the host variable with the given name for the
+          setters taking an index.
+
+          When the statement has no such host variable, a warning is logged
+          and npos is returned. Setting the index npos is ignored.
+       */
+      virtual size_type paramIndex(const std::string& col) = 0;
+
+      /** Returns the index of the host variable with the given name or npos.
+
+          Unlike paramIndex no warning is logged, when the statement has no
+          such host variable. The default implementation calls paramIndex.
+       */
+      virtual size_type findParam(const std::string& col);
+
+      virtual void setNull(size_type idx) = 0;
+      virtual void setBool(size_type idx, bool data) = 0;
+      virtual void setShort(size_type idx, short data) = 0;
+      virtual void setInt(size_type idx, int data) = 0;
+      virtual void setLong(size_type idx, long data) = 0;
+      virtual void setUnsignedShort(size_type idx, unsigned short data) = 0;
+      virtual void setUnsigned(size_type idx, unsigned data) = 0;
+      virtual void setUnsignedLong(size_type idx, unsigned long data) = 0;
+      virtual void setInt32(size_type idx, int32_t data) = 0;
+      virtual void setUnsigned32(size_type idx, uint32_t data) = 0;
+      virtual void setInt64(size_type idx, int64_t data) = 0;
+      virtual void setUnsigned64(size_type idx, uint64_t data) = 0;
+      virtual void setDecimal(size_type idx, const Decimal& data) = 0;
+      virtual void setFloat(size_type idx, float data) = 0;
+      virtual void setDouble(size_type idx, double data) = 0;
+      virtual void setChar(size_type idx, char data) = 0;
+      virtual void setString(size_type idx, const std::string& data) = 0;
+      virtual void setBlob(size_type idx, const Blob& data) = 0;
+      virtual void setDate(size_type idx, const Date& data) = 0;
+      virtual void setTime(size_type idx, const Time& data) = 0;
+      virtual void setDatetime(size_type idx, const Datetime& data) = 0;
+      virtual void setUString(size_type idx, const cxxtools::String& data);
+
+      /// Sets a string given by pointer and length; the data is copied.
+      virtual void setString(size_type idx, const char* data, std::size_t length);
+
+      /** Sets a string without copying the data.
+
+          The data must stay valid and unchanged until the statement is
+          executed. The default implementation copies the data.
+       */
+      virtual void setStringRef(size_type idx, const char* data, std::size_t length);
+
+      /** Sets binary data without copying it.
+
+          The data must stay valid and unchanged until the statement is
+          executed. The default implementation copies the data into a Blob.
+       */
+      virtual void setBlobRef(size_type idx, const char* data, std::size_t length);
+
+      // The setters taking a name look up the index with paramIndex().
+      virtual void setNull(const std::string& col);
+      virtual void setBool(const std::string& col, bool data);
+      virtual void setShort(const std::string& col, short data);
+      virtual void setInt(const std::string& col, int data);
+      virtual void setLong(const std::string& col, long data);
+      virtual void setUnsignedShort(const std::string& col, unsigned short data);
+      virtual void setUnsigned(const std::string& col, unsigned data);
+      virtual void setUnsignedLong(const std::string& col, unsigned long data);
+      virtual void setInt32(const std::string& col, int32_t data);
+      virtual void setUnsigned32(const std::string& col, uint32_t data);
+      virtual void setInt64(const std::string& col, int64_t data);
+      virtual void setUnsigned64(const std::string& col, uint64_t data);
+      virtual void setDecimal(const std::string& col, const Decimal& data);
+      virtual void setFloat(const std::string& col, float data);
+      virtual void setDouble(const std::string& col, double data);
+      virtual void setChar(const std::string& col, char data);
+      virtual void setString(const std::string& col, const std::string& data);
+      virtual void setBlob(const std::string& col, const Blob& data);
+      virtual void setDate(const std::string& col, const Date& data);
+      virtual void setTime(const std::string& col, const Time& data);
+      virtual void setDatetime(const std::string& col, const Datetime& data);
       virtual void setUString(const std::string& col, const cxxtools::String& data);
+      virtual void setString(const std::string& col, const char* data, std::size_t length);
+      virtual void setStringRef(const std::string& col, const char* data, std::size_t length);
+      virtual void setBlobRef(const std::string& col, const char* data, std::size_t length);
 
       virtual size_type execute() = 0;
       virtual Result select() = 0;
       virtual Row selectRow() = 0;
       virtual Value selectValue() = 0;
       virtual ICursor* createCursor(unsigned fetchsize) = 0;
+
+      /** Executes the statement once for each row of the batch and returns
+          the number of affected rows.
+
+          The default implementation binds and executes row by row. Drivers
+          override it to send many rows at once. When a row fails, a
+          BatchError with the index of the row and the number of rows
+          affected by the part of the batch, which was kept, is thrown.
+       */
+      virtual size_type executeBatch(const Batch& batch);
+
+      /** Executes the query and passes each row to the visitor. Returns
+          the number of rows.
+
+          The default implementation fetches the rows with a cursor. Drivers
+          override it to call the visitor from their fetch loop with one row
+          object, which is reused for all rows.
+       */
+      virtual size_type forEach(RowVisitor& visitor, unsigned fetchsize);
+
+      /** Prepares the statement in the database now.
+
+          Drivers normally prepare a statement when it is executed the
+          first time. The default implementation does nothing.
+       */
+      virtual void prepare();
   };
 }
 
@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_IMPL_COLUMNDESCRIPTOR_H
+#define TNTDB_IMPL_COLUMNDESCRIPTOR_H
+
+#include <cxxtools/refcounted.h>
+#include <string>
+#include <vector>
+#include <map>
+#if __cplusplus >= 201103L
+#include <unordered_map>
+#endif
+
+namespace tntdb
+{
+  /** Column metadata of a result set
+
+      The descriptor holds the names and declared types of the columns and an
+      index for looking up columns by name. It is created once per result set
+      and shared by all rows, so that the metadata do not grow with the number
+      of rows.
+   */
+  class ColumnDescriptor : public cxxtools::RefCounted
+  {
+    public:
+      typedef unsigned size_type;
+      static const size_type npos = static_cast<size_type>(-1);
+
+    private:
+      struct Column
+      {
+        std::string name;
+        std::string type;
+
+        Column(const std::string& name_, const std::string& type_)
+          : name(name_),
+            type(type_)
+          { }
+      };
+
+#if __cplusplus >= 201103L
+      typedef std::unordered_map<std::string, size_type> IndexType;
+#else
+      typedef std::map<std::string, size_type> IndexType;
+#endif
+
+      std::vector<Column> _columns;
+      IndexType _index;
+
+    public:
+      ColumnDescriptor()
+        { }
+
+      /// Reserves space for the given number of columns
+      void reserve(size_type n)
+        { _columns.reserve(n); }
+
+      /** Appends a column
+
+          When the name is already used, lookups by name return the first
+          column with this name.
+       */
+      void add(const std::string& name, const std::string& type = std::string());
+
+      size_type size() const
+        { return _columns.size(); }
+      bool empty() const
+        { return _columns.empty(); }
+
+      const std::string& getName(size_type field_num) const
+        { return _columns.at(field_num).name; }
+      /// Returns the declared type of the column or an empty string if not known
+      const std::string& getType(size_type field_num) const
+        { return _columns.at(field_num).type; }
+
+      /// Returns the index of the column or npos if not found
+      size_type find(const std::string& field_name) const;
+      /// Returns the index of the column or throws FieldNotFound
+      size_type getIndex(const std::string& field_name) const;
+  };
+}
+
+#endif // TNTDB_IMPL_COLUMNDESCRIPTOR_H
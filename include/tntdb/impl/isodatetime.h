@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TNTDB_IMPL_ISODATETIME_H
+#define TNTDB_IMPL_ISODATETIME_H
+
+#include <cstddef>
+
+namespace tntdb
+{
+  class Date;
+  class Time;
+  class Datetime;
+
+  /** @file
+      Parsing of dates and times in ISO format without copying the text.
+
+      The functions parse the value at the start of s and return the number
+      of characters used or 0, when s does not start with a valid value. The
+      caller decides, what may follow. No exceptions are thrown and no memory
+      is allocated.
+   */
+
+  /// Parses "YYYY-MM-DD"
+  std::size_t parseIsoDate(const char* s, std::size_t len, Date& ret);
+
+  /// Parses "hh:mm:ss" with a optional fraction of seconds, which is truncated to milliseconds
+  std::size_t parseIsoTime(const char* s, std::size_t len, Time& ret);
+
+  /// Parses a date and a time separated by ' ' or 'T'
+  std::size_t parseIsoDatetime(const char* s, std::size_t len, Datetime& ret);
+}
+
+#endif // TNTDB_IMPL_ISODATETIME_H
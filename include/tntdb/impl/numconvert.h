@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_IMPL_NUMCONVERT_H
+#define TNTDB_IMPL_NUMCONVERT_H
+
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <stdint.h>
+
+namespace tntdb
+{
+  /** @file
+      Conversion between numbers and their text representation.
+
+      The functions do not allocate memory, do not use streams and do not
+      depend on the locale. Leading and trailing white space is accepted when
+      parsing. The parse functions return false, when the text is not a valid
+      number or the number does not fit into the requested type.
+   */
+
+  /// Size of a buffer, which is large enough for all format functions
+  const std::size_t numberBufferSize = 32;
+
+  bool parseInt64(const char* s, std::size_t len, int64_t& ret);
+  bool parseUnsigned64(const char* s, std::size_t len, uint64_t& ret);
+  bool parseDouble(const char* s, std::size_t len, double& ret);
+  bool parseFloat(const char* s, std::size_t len, float& ret);
+
+  /// Formats the number into buf and returns the number of characters written
+  std::size_t formatInt64(int64_t value, char* buf);
+  std::size_t formatUnsigned64(uint64_t value, char* buf);
+  /// Formats with the least number of digits needed to read back the same value
+  std::size_t formatDouble(double value, char* buf);
+  std::size_t formatFloat(float value, char* buf);
+
+  namespace numconvert
+  {
+    template <typename IntType, bool isSigned = std::numeric_limits<IntType>::is_signed>
+    struct IntegerParser
+    {
+      static bool parse(const char* s, std::size_t len, IntType& ret)
+      {
+        int64_t v;
+        if (!parseInt64(s, len, v)
+          || v < static_cast<int64_t>(std::numeric_limits<IntType>::min())
+          || v > static_cast<int64_t>(std::numeric_limits<IntType>::max()))
+          return false;
+        ret = static_cast<IntType>(v);
+        return true;
+      }
+    };
+
+    template <typename IntType>
+    struct IntegerParser<IntType, false>
+    {
+      static bool parse(const char* s, std::size_t len, IntType& ret)
+      {
+        uint64_t v;
+        if (!parseUnsigned64(s, len, v)
+          || v > static_cast<uint64_t>(std::numeric_limits<IntType>::max()))
+          return false;
+        ret = static_cast<IntType>(v);
+        return true;
+      }
+    };
+
+    template <typename IntType, bool isSigned = std::numeric_limits<IntType>::is_signed>
+    struct IntegerFormatter
+    {
+      static std::size_t format(IntType value, char* buf)
+        { return formatInt64(static_cast<int64_t>(value), buf); }
+    };
+
+    template <typename IntType>
+    struct IntegerFormatter<IntType, false>
+    {
+      static std::size_t format(IntType value, char* buf)
+        { return formatUnsigned64(static_cast<uint64_t>(value), buf); }
+    };
+
+    /// Throws a TypeError, which tells, that the text can't be converted to tname
+    void throwConversionError(const char* s, std::size_t len, const char* tname);
+  }
+
+  /// Parses a integer of any size with range check
+  template <typename IntType>
+  bool parseInteger(const char* s, std::size_t len, IntType& ret)
+    { return numconvert::IntegerParser<IntType>::parse(s, len, ret); }
+
+  inline bool parseNumber(const char* s, std::size_t len, double& ret)
+    { return parseDouble(s, len, ret); }
+  inline bool parseNumber(const char* s, std::size_t len, float& ret)
+    { return parseFloat(s, len, ret); }
+  template <typename IntType>
+  bool parseNumber(const char* s, std::size_t len, IntType& ret)
+    { return parseInteger(s, len, ret); }
+
+  /// Formats a integer of any size
+  template <typename IntType>
+  std::size_t formatInteger(IntType value, char* buf)
+    { return numconvert::IntegerFormatter<IntType>::format(value, buf); }
+
+  inline std::size_t formatNumber(double value, char* buf)
+    { return formatDouble(value, buf); }
+  inline std::size_t formatNumber(float value, char* buf)
+    { return formatFloat(value, buf); }
+  template <typename IntType>
+  std::size_t formatNumber(IntType value, char* buf)
+    { return formatInteger(value, buf); }
+
+  /// Parses a number and throws a tntdb::TypeError when the text is not valid
+  template <typename T>
+  T convertNumber(const char* s, std::size_t len, const char* tname)
+  {
+    T ret;
+    if (!parseNumber(s, len, ret))
+      numconvert::throwConversionError(s, len, tname);
+    return ret;
+  }
+
+  inline std::string formatNumber(double value)
+    { char buf[numberBufferSize]; return std::string(buf, formatDouble(value, buf)); }
+  inline std::string formatNumber(float value)
+    { char buf[numberBufferSize]; return std::string(buf, formatFloat(value, buf)); }
+  template <typename IntType>
+  std::string formatNumber(IntType value)
+    { char buf[numberBufferSize]; return std::string(buf, formatInteger(value, buf)); }
+}
+
+#endif // TNTDB_IMPL_NUMCONVERT_H
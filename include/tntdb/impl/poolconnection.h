@@ -36,12 +36,18 @@ namespace tntdb
 {
   class PoolConnection : public IConnection
   {
-      ConnectionPool::PoolObjectType connection;
+      ConnectionPool& pool;
+      ConnectionPool::Entry entry;
       bool inTransaction;
       bool drop;
+      bool validated;   // set after the connection proved to be alive
+
+      IConnection* connection()   { return entry.connection.getImpl(); }
+      bool reconnect();
 
     public:
-      PoolConnection(ConnectionPool::PoolObjectType connection);
+      PoolConnection(ConnectionPool& pool, const ConnectionPool::Entry& entry,
+        bool validated);
       ~PoolConnection();
 
       virtual void beginTransaction();
@@ -57,8 +63,15 @@ namespace tntdb
       virtual void clearStatementCache();
       virtual bool clearStatementCache(const std::string& key);
       virtual bool ping();
+      virtual bool isAlive();
+      virtual bool reset();
       virtual long lastInsertId(const std::string& name);
       virtual void lockTable(const std::string& tablename, bool exclusive);
+      virtual Statement prepareShared(const std::string& query);
+      virtual void setStatementCaching(bool sw);
+      virtual bool getStatementCaching();
+      virtual void setStatementCacheCapacity(unsigned capacity);
+      virtual StmtCacheStatistics getStatementCacheStatistics();
   };
 }
 
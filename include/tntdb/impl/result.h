@@ -30,26 +30,45 @@
 #define TNTDB_IMPL_RESULT_H
 
 #include <tntdb/iface/iresult.h>
+#include <tntdb/iface/irow.h>
 #include <tntdb/result.h>
+#include <tntdb/impl/columndescriptor.h>
+#include <tntdb/impl/value.h>
+#include <tntdb/impl/valueslots.h>
+#include <cxxtools/smartptr.h>
+#include <string>
 #include <vector>
 
 namespace tntdb
 {
+  /**
+   * Generic result set for drivers, which copy the values of all rows.
+   *
+   * The values are stored back to back in one buffer with a table of
+   * offsets, so that a result needs a few allocations regardless of the
+   * number of rows and values. Rows and values returned by the result
+   * reference the buffer instead of copying it.
+   *
+   * The column names and types are kept in a ColumnDescriptor, which is
+   * shared by all rows.
+   *
+   * The result is filled row by row: addRow() starts a new row, followed
+   * by one call of addValue() or addNull() for each column.
+   */
   class ResultImpl : public IResult
   {
-    public:
-      typedef std::vector<Row> data_type;
+      cxxtools::SmartPtr<ColumnDescriptor> _columns;
+      size_type _fieldCount;
+      size_type _rowCount;
+      std::vector<char> _data;
+      std::vector<std::size_t> _offsets;  // start of each value; one more entry than values
+      std::vector<bool> _nulls;
 
-    private:
-      data_type data;
+      std::size_t index(size_type tup_num, size_type field_num) const
+        { return tup_num * _fieldCount + field_num; }
 
     public:
-      ResultImpl()
-      { }
-
-      explicit ResultImpl(const data_type& data_)
-        : data(data_)
-      { }
+      explicit ResultImpl(ColumnDescriptor* columns);
 
       // methods from IResult
       virtual Row getRow(size_type tup_num) const;
@@ -57,9 +76,60 @@ namespace tntdb
       virtual size_type getFieldCount() const;
 
       // specific methods
-      void add(const Row& row)   { data.push_back(row); }
+      const ColumnDescriptor& getColumns() const
+        { return *_columns; }
+
+      /// Reserves space for the given number of rows and bytes of data
+      void reserve(size_type rows, std::size_t bytes);
+
+      void addRow()
+        { ++_rowCount; }
+      void addValue(const char* data, std::size_t length)
+      {
+        _data.insert(_data.end(), data, data + length);
+        _offsets.push_back(_data.size());
+        _nulls.push_back(false);
+      }
+      void addNull()
+      {
+        _offsets.push_back(_data.size());
+        _nulls.push_back(true);
+      }
+
+      bool isNull(size_type tup_num, size_type field_num) const
+        { return _nulls[index(tup_num, field_num)]; }
+      const char* data(size_type tup_num, size_type field_num) const
+        { return _data.empty() ? "" : &_data[0] + _offsets[index(tup_num, field_num)]; }
+      std::size_t length(size_type tup_num, size_type field_num) const
+      {
+        std::size_t i = index(tup_num, field_num);
+        return _offsets[i + 1] - _offsets[i];
+      }
+  };
+
+  /// Row of a ResultImpl
+  class ResultRowImpl : public IRow
+  {
+      cxxtools::SmartPtr<ResultImpl> _result;
+      size_type _row;
+      ValueSlots<ValueImpl> _values;
+
+    public:
+      ResultRowImpl(ResultImpl* result, size_type row);
+
+      virtual size_type size() const;
+      virtual Value getValueByNumber(size_type field_num) const;
+      virtual Value getValueByName(const std::string& field_name) const;
+      virtual std::string getColumnName(size_type field_num) const;
+      virtual size_type getColumnIndex(const std::string& field_name) const;
+      virtual bool isNull(size_type field_num) const;
+      virtual bool getBool(size_type field_num) const;
+      virtual int getInt(size_type field_num) const;
+      virtual int64_t getInt64(size_type field_num) const;
+      virtual uint64_t getUnsigned64(size_type field_num) const;
+      virtual double getDouble(size_type field_num) const;
+      virtual void getString(size_type field_num, std::string& ret) const;
   };
 }
 
 #endif // TNTDB_IMPL_RESULT_H
-
@@ -30,37 +30,35 @@
 #define TNTDB_IMPL_ROW_H
 
 #include <tntdb/iface/irow.h>
+#include <tntdb/impl/columndescriptor.h>
 #include <tntdb/value.h>
+#include <cxxtools/smartptr.h>
 #include <vector>
 
 namespace tntdb
 {
+  /**
+   * Generic row, which holds a list of values.
+   *
+   * The column names are kept in a ColumnDescriptor, which may be shared
+   * with other rows of the same result.
+   */
   class RowImpl : public IRow
   {
     public:
-      struct ValueType
-      {
-        std::string name;
-        Value value;
-
-        ValueType()  { }
-        ValueType(const std::string& name_, const Value& value_)
-          : name(name_),
-            value(value_)
-            { }
-      };
-
-      typedef std::vector<ValueType> data_type;
+      typedef std::vector<Value> data_type;
 
     private:
+      cxxtools::SmartPtr<ColumnDescriptor> columns;
       data_type data;
 
     public:
       RowImpl()
+        : columns(new ColumnDescriptor())
         { }
 
-      explicit RowImpl(const data_type& data_)
-        : data(data_)
+      explicit RowImpl(ColumnDescriptor* columns_)
+        : columns(columns_)
         { }
 
       // methods from IResult
@@ -68,11 +66,25 @@ namespace tntdb
       virtual Value getValueByNumber(size_type field_num) const;
       virtual Value getValueByName(const std::string& field_name) const;
       virtual std::string getColumnName(size_type field_num) const;
+      virtual size_type getColumnIndex(const std::string& field_name) const;
+      virtual bool isNull(size_type field_num) const;
+      virtual bool getBool(size_type field_num) const;
+      virtual int getInt(size_type field_num) const;
+      virtual int64_t getInt64(size_type field_num) const;
+      virtual uint64_t getUnsigned64(size_type field_num) const;
+      virtual double getDouble(size_type field_num) const;
+      virtual void getString(size_type field_num, std::string& ret) const;
 
       // specific methods
-      void add(const std::string& field_name, const Value& value)   { data.push_back(ValueType(field_name, value)); }
+
+      /// Adds a value to a row with a shared column descriptor
+      void add(const Value& value)   { data.push_back(value); }
+      /// Adds a value and its column name to a row with an own descriptor
+      void add(const std::string& field_name, const Value& value)
+        { columns->add(field_name); data.push_back(value); }
+
+      const ColumnDescriptor& getColumns() const  { return *columns; }
   };
 }
 
 #endif // TNTDB_IMPL_ROW_H
-
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TNTDB_IMPL_STMTCACHE_H
+#define TNTDB_IMPL_STMTCACHE_H
+
+#include <tntdb/stmtcachestatistics.h>
+#include <cxxtools/smartptr.h>
+#include <string>
+#include <list>
+#include <map>
+#if __cplusplus >= 201103L
+#include <unordered_map>
+#endif
+
+namespace tntdb
+{
+  class IStatement;
+
+  /** Cache of prepared statements with a limited capacity
+
+      When the capacity is exceeded, the least recently used statement is
+      removed from the cache. The statement is destroyed, and its server side
+      resources are released, when it is not used by the application any more.
+   */
+  class StmtCache
+  {
+      typedef std::pair<std::string, cxxtools::SmartPtr<IStatement> > EntryType;
+      typedef std::list<EntryType> ListType;
+#if __cplusplus >= 201103L
+      typedef std::unordered_map<std::string, ListType::iterator> IndexType;
+#else
+      typedef std::map<std::string, ListType::iterator> IndexType;
+#endif
+
+      ListType _entries;  // most recently used first
+      IndexType _index;
+      StmtCacheStatistics _statistics;
+
+      void evict();
+
+      // non copyable
+      StmtCache(const StmtCache&);
+      StmtCache& operator=(const StmtCache&);
+
+    public:
+      static const unsigned defaultCapacity = 256;
+
+      explicit StmtCache(unsigned capacity = defaultCapacity);
+
+      /// Returns the cached statement or 0, if the key is not found
+      IStatement* get(const std::string& key);
+      /** Returns the cached statement, when it is not used outside of the cache.
+
+          Returns 0, when the key is not found or the statement is still in
+          use; found tells, whether the key was found.
+       */
+      IStatement* getIdle(const std::string& key, bool& found);
+      /// Adds a statement to the cache; the least recently used statements are evicted when needed
+      void put(const std::string& key, IStatement* stmt);
+      /// Removes a statement from the cache; returns false, when the key is not found
+      bool erase(const std::string& key);
+      void clear();
+
+      /// Sets the maximum number of statements; 0 means unlimited
+      void setCapacity(unsigned capacity);
+      unsigned getCapacity() const    { return _statistics.capacity; }
+      unsigned size() const           { return _index.size(); }
+
+      StmtCacheStatistics getStatistics() const;
+  };
+}
+
+#endif // TNTDB_IMPL_STMTCACHE_H
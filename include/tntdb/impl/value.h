@@ -30,24 +30,53 @@
 #define TNTDB_IMPL_VALUE_H
 
 #include <tntdb/iface/ivalue.h>
+#include <tntdb/iface/iresult.h>
+#include <cxxtools/smartptr.h>
+#include <string>
 
 namespace tntdb
 {
+  /**
+   * Generic value, which is stored as a string.
+   *
+   * The value either owns a copy of the data or references memory of
+   * a result, which is kept alive as long as the value exists.
+   */
   class ValueImpl : public IValue
   {
       bool null;
-      std::string data;
+      std::string own;
+      const char* ptr;
+      std::size_t len;
+      cxxtools::SmartPtr<IResult> result;
+
+      std::string str() const  { return std::string(ptr, len); }
 
     public:
       ValueImpl()
-        : null(true)
+        : null(true),
+          ptr(""),
+          len(0)
       { }
 
       ValueImpl(const std::string& d)
         : null(false),
-          data(d)
+          own(d),
+          ptr(own.data()),
+          len(own.size())
       { }
 
+      /// Creates a value, which references data owned by a result
+      ValueImpl(const char* data, std::size_t length, IResult* owner)
+        : null(false),
+          ptr(data),
+          len(length),
+          result(owner)
+      { }
+
+      ValueImpl(const ValueImpl& v);
+      ValueImpl& operator= (const ValueImpl& v);
+
       virtual bool isNull() const;
       virtual bool getBool() const;
       virtual short getShort() const;
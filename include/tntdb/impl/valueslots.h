@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_IMPL_VALUESLOTS_H
+#define TNTDB_IMPL_VALUESLOTS_H
+
+#include <tntdb/bits/value.h>
+#include <cxxtools/refcounted.h>
+#include <vector>
+
+namespace tntdb
+{
+  /** Values of a row, which are created together with the row.
+
+      Each value holds a permanent reference, so that it is never destroyed
+      through a smart pointer. The tntdb::Value objects returned by get() keep
+      the owning row alive instead, so that reading a value does not need to
+      allocate a value object.
+
+      All values must be added before the first value is returned.
+   */
+  template <typename ValueType>
+  class ValueSlots
+  {
+      std::vector<ValueType> _values;
+
+    public:
+      typedef typename std::vector<ValueType>::size_type size_type;
+
+      void reserve(size_type n)
+        { _values.reserve(n); }
+
+      void add(const ValueType& value)
+      {
+        _values.push_back(value);
+        _values.back().addRef();
+      }
+
+      size_type size() const
+        { return _values.size(); }
+
+      ValueType& operator[] (size_type n)
+        { return _values[n]; }
+      const ValueType& operator[] (size_type n) const
+        { return _values[n]; }
+
+      /// Returns the n'th value; throws std::out_of_range if n >= size()
+      ValueType& at(size_type n)
+        { return _values.at(n); }
+      const ValueType& at(size_type n) const
+        { return _values.at(n); }
+
+      /// Returns the n'th value, which keeps the owner alive
+      Value get(size_type n, cxxtools::RefCounted* owner) const
+        { return Value(const_cast<ValueType*>(&_values.at(n)), owner); }
+  };
+}
+
+#endif // TNTDB_IMPL_VALUESLOTS_H
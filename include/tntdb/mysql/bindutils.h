@@ -61,6 +61,7 @@ namespace tntdb
     void setChar(MYSQL_BIND& value, unsigned long& length, char data);
     void setString(MYSQL_BIND& value, unsigned long& length, const char* data);
     void setString(MYSQL_BIND& value, unsigned long& length, const std::string& data);
+    void setString(MYSQL_BIND& value, unsigned long& length, const char* data, unsigned long size);
     void setBlob(MYSQL_BIND& value, unsigned long& length, const Blob& data);
     void setDate(MYSQL_BIND& value, const Date& data);
     void setTime(MYSQL_BIND& value, const Time& data);
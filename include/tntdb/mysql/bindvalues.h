@@ -32,6 +32,7 @@
 #include <mysql.h>
 #include <string>
 #include <tntdb/decimal.h>
+#include <tntdb/blob.h>
 #include <tntdb/mysql/bindutils.h>
 
 namespace tntdb
@@ -47,12 +48,27 @@ namespace tntdb
           unsigned long length;
           my_bool isNull;
           std::string name;
+          // own buffer, while the bind points to borrowed data
+          void* ownBuffer;
+          unsigned long ownBufferLength;
+          bool borrowed;
+          Blob blob;
           BindAttributes()
             : length(0),
-              isNull(true)
+              isNull(true),
+              ownBuffer(0),
+              ownBufferLength(0),
+              borrowed(false)
               { }
         }* bindAttributes;
 
+        // makes the bind point to its own buffer again before it is written
+        void own(unsigned n)
+          { if (bindAttributes[n].borrowed) restoreBuffer(n); }
+        void restoreBuffer(unsigned n);
+        void setRef(unsigned n, const char* data, unsigned long length);
+        void releaseAll();
+
         // non copyable
         BindValues(const BindValues&);
         BindValues& operator=(const BindValues&);
@@ -67,49 +83,55 @@ namespace tntdb
         unsigned getSize() const   { return valuesSize; }
 
         void setNull(unsigned n)
-          { mysql::setNull(values[n]); }
+          { own(n); mysql::setNull(values[n]); }
         void setBool(unsigned n, bool data)
-          { mysql::setBool(values[n], data); }
+          { own(n); mysql::setBool(values[n], data); }
         void setShort(unsigned n, short data)
-          { mysql::setShort(values[n], data); }
+          { own(n); mysql::setShort(values[n], data); }
         void setInt(unsigned n, int data)
-          { mysql::setInt(values[n], data); }
+          { own(n); mysql::setInt(values[n], data); }
         void setLong(unsigned n, int data)
-          { mysql::setLong(values[n], data); }
+          { own(n); mysql::setLong(values[n], data); }
         void setUnsignedShort(unsigned n, unsigned short data)
-          { mysql::setUnsignedShort(values[n], data); }
+          { own(n); mysql::setUnsignedShort(values[n], data); }
         void setUnsigned(unsigned n, unsigned data)
-          { mysql::setUnsigned(values[n], data); }
+          { own(n); mysql::setUnsigned(values[n], data); }
         void setUnsignedLong(unsigned n, unsigned data)
-          { mysql::setUnsignedLong(values[n], data); }
+          { own(n); mysql::setUnsignedLong(values[n], data); }
         void setInt32(unsigned n, int32_t data)
-          { mysql::setInt32(values[n], data); }
+          { own(n); mysql::setInt32(values[n], data); }
         void setUnsigned32(unsigned n, uint32_t data)
-          { mysql::setUnsigned32(values[n], data); }
+          { own(n); mysql::setUnsigned32(values[n], data); }
         void setInt64(unsigned n, int64_t data)
-          { mysql::setInt64(values[n], data); }
+          { own(n); mysql::setInt64(values[n], data); }
         void setUnsigned64(unsigned n, uint64_t data)
-          { mysql::setUnsigned64(values[n], data); }
+          { own(n); mysql::setUnsigned64(values[n], data); }
         void setDecimal(unsigned n, const Decimal& data)
-          { mysql::setDecimal(values[n], bindAttributes[n].length, data); }
+          { own(n); mysql::setDecimal(values[n], bindAttributes[n].length, data); }
         void setFloat(unsigned n, float data)
-          { mysql::setFloat(values[n], data); }
+          { own(n); mysql::setFloat(values[n], data); }
         void setDouble(unsigned n, double data)
-          { mysql::setDouble(values[n], data); }
+          { own(n); mysql::setDouble(values[n], data); }
         void setChar(unsigned n, char data)
-          { mysql::setChar(values[n], bindAttributes[n].length, data); }
+          { own(n); mysql::setChar(values[n], bindAttributes[n].length, data); }
         void setString(unsigned n, const char* data)
-          { mysql::setString(values[n], bindAttributes[n].length, data); }
+          { own(n); mysql::setString(values[n], bindAttributes[n].length, data); }
         void setString(unsigned n, const std::string& data)
-          { mysql::setString(values[n], bindAttributes[n].length, data); }
+          { own(n); mysql::setString(values[n], bindAttributes[n].length, data); }
+        void setString(unsigned n, const char* data, unsigned long length)
+          { own(n); mysql::setString(values[n], bindAttributes[n].length, data, length); }
+        // the bind shares the data of the blob
         void setBlob(unsigned n, const Blob& data)
-          { mysql::setBlob(values[n], bindAttributes[n].length, data); }
+          { bindAttributes[n].blob = data; setRef(n, data.data(), data.size()); }
+        // the bind points to the passed data, which must be valid until execution
+        void setStringRef(unsigned n, const char* data, unsigned long length)
+          { bindAttributes[n].blob = Blob(); setRef(n, data, length); }
         void setDate(unsigned n, const Date& data)
-          { mysql::setDate(values[n], data); }
+          { own(n); mysql::setDate(values[n], data); }
         void setTime(unsigned n, const Time& data)
-          { mysql::setTime(values[n], data); }
+          { own(n); mysql::setTime(values[n], data); }
         void setDatetime(unsigned n, const Datetime& data)
-          { mysql::setDatetime(values[n], data); }
+          { own(n); mysql::setDatetime(values[n], data); }
 
         bool isNull(unsigned n) const
           { return mysql::isNull(values[n]); }
@@ -31,22 +31,41 @@
 
 #include <tntdb/iface/irow.h>
 #include <tntdb/mysql/bindvalues.h>
+#include <tntdb/mysql/impl/boundvalue.h>
+#include <tntdb/impl/valueslots.h>
+#include <tntdb/impl/columndescriptor.h>
+#include <cxxtools/smartptr.h>
 
 namespace tntdb
 {
   namespace mysql
   {
+    /// Row of a statement; the same row is reused for all rows of a cursor
     class BoundRow : public IRow, public BindValues
     {
+        // column names; shared with the statement or read on first lookup by name
+        mutable cxxtools::SmartPtr<ColumnDescriptor> columns;
+        const ColumnDescriptor& getColumns() const;
+
+        ValueSlots<BoundValue> values;
+
       public:
-        explicit BoundRow(unsigned n)
-          : BindValues(n)
-          { }
+        explicit BoundRow(unsigned n);
+
+        void setColumns(ColumnDescriptor* c)  { columns = c; }
 
         size_type size() const;
         Value getValueByNumber(size_type field_num) const;
         Value getValueByName(const std::string& field_name) const;
         std::string getColumnName(size_type field_num) const;
+        size_type getColumnIndex(const std::string& field_name) const;
+        bool isNull(size_type field_num) const;
+        bool getBool(size_type field_num) const;
+        int getInt(size_type field_num) const;
+        int64_t getInt64(size_type field_num) const;
+        uint64_t getUnsigned64(size_type field_num) const;
+        double getDouble(size_type field_num) const;
+        void getString(size_type field_num, std::string& ret) const;
     };
   }
 }
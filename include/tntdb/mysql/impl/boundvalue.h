@@ -30,8 +30,6 @@
 #define TNTDB_MYSQL_IMPL_BOUNDVALUE_H
 
 #include <tntdb/iface/ivalue.h>
-#include <tntdb/iface/irow.h>
-#include <cxxtools/smartptr.h>
 #include <mysql.h>
 
 namespace tntdb
@@ -49,13 +47,12 @@ namespace tntdb
         typedef unsigned size_type;
 
       private:
-        cxxtools::SmartPtr<IRow> row;
-        MYSQL_BIND& mysql_bind;
+        MYSQL_BIND* mysql_bind;
 
       public:
-        BoundValue(IRow* row_, MYSQL_BIND& bind)
-          : row(row_),
-            mysql_bind(bind)
+        /// The value is stored in a BoundRow, which keeps the bind buffer
+        explicit BoundValue(MYSQL_BIND& bind)
+          : mysql_bind(&bind)
           { }
 
         virtual bool isNull() const;
@@ -95,6 +95,8 @@ namespace tntdb
         tntdb::Value selectValue(const std::string& query);
         tntdb::Statement prepare(const std::string& query);
         bool ping();
+        bool isAlive();
+        bool reset();
         long lastInsertId(const std::string& name);
         void lockTable(const std::string& tablename, bool exclusive);
     };
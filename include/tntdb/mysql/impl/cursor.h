@@ -52,6 +52,12 @@ namespace tntdb
 
         // method for ICursor
         Row fetch();
+
+        // specific methods of mysql-driver
+
+        /// Fetches the next row into the bound row; returns false, when there are no more rows
+        bool next();
+        BoundRow* getBoundRow() const   { return row.getPointer(); }
     };
   }
 }
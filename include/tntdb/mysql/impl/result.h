@@ -31,6 +31,8 @@
 
 #include <tntdb/iface/iresult.h>
 #include <tntdb/bits/connection.h>
+#include <tntdb/impl/columndescriptor.h>
+#include <cxxtools/smartptr.h>
 #include <mysql.h>
 
 namespace tntdb
@@ -43,16 +45,26 @@ namespace tntdb
         MYSQL* mysql;
         MYSQL_RES* result;
         size_type field_count;
+        mutable cxxtools::SmartPtr<ColumnDescriptor> columns;
 
       public:
         Result(const tntdb::Connection& c, MYSQL* m, MYSQL_RES* r);
         ~Result();
 
         MYSQL_RES* getMysqlRes() const  { return result; }
+        /// Returns the column names, which are read on first use
+        const ColumnDescriptor& getColumns() const;
 
         Row getRow(size_type tup_num) const;
         size_type size() const;
         size_type getFieldCount() const;
+
+        void getColumn(size_type field_num, std::vector<int64_t>& values,
+          std::vector<bool>& nulls) const;
+        void getColumn(size_type field_num, std::vector<double>& values,
+          std::vector<bool>& nulls) const;
+        void getColumn(size_type field_num, std::vector<std::string>& values,
+          std::vector<bool>& nulls) const;
     };
   }
 }
@@ -31,6 +31,9 @@
 
 #include <tntdb/bits/result.h>
 #include <tntdb/iface/irow.h>
+#include <tntdb/impl/columndescriptor.h>
+#include <tntdb/impl/valueslots.h>
+#include <tntdb/mysql/impl/rowvalue.h>
 #include <mysql.h>
 
 namespace tntdb
@@ -41,17 +44,25 @@ namespace tntdb
     class ResultRow : public IRow
     {
         Result result;
-        MYSQL_ROW row;
-        unsigned long* lengths;
-        MYSQL_FIELD* fields;
+        const ColumnDescriptor& columns;  // owned by result
+        ValueSlots<RowValue> values;
 
       public:
-        ResultRow(const tntdb::Result& result_, MYSQL_RES* res, MYSQL_ROW row_);
+        ResultRow(const tntdb::Result& result_, const ColumnDescriptor& columns_,
+          MYSQL_RES* res, MYSQL_ROW row_);
 
         unsigned size() const;
         Value getValueByNumber(size_type field_num) const;
         Value getValueByName(const std::string& field_name) const;
         std::string getColumnName(size_type field_num) const;
+        size_type getColumnIndex(const std::string& field_name) const;
+        bool isNull(size_type field_num) const;
+        bool getBool(size_type field_num) const;
+        int getInt(size_type field_num) const;
+        int64_t getInt64(size_type field_num) const;
+        uint64_t getUnsigned64(size_type field_num) const;
+        double getDouble(size_type field_num) const;
+        void getString(size_type field_num, std::string& ret) const;
     };
   }
 }
@@ -48,6 +48,13 @@ namespace tntdb
         Row getRow(size_type tup_num) const;
         size_type size() const;
         size_type getFieldCount() const;
+
+        void getColumn(size_type field_num, std::vector<int64_t>& values,
+          std::vector<bool>& nulls) const;
+        void getColumn(size_type field_num, std::vector<double>& values,
+          std::vector<bool>& nulls) const;
+        void getColumn(size_type field_num, std::vector<std::string>& values,
+          std::vector<bool>& nulls) const;
     };
   }
 }
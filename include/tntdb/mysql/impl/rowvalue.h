@@ -30,7 +30,6 @@
 #define TNTDB_MYSQL_IMPL_ROWVALUE_H
 
 #include <tntdb/iface/ivalue.h>
-#include <tntdb/bits/result.h>
 #include <mysql.h>
 
 namespace tntdb
@@ -43,15 +42,14 @@ namespace tntdb
         typedef unsigned size_type;
 
       private:
-        Result result;
         MYSQL_ROW row;
         size_type col;
         size_type len;
 
       public:
-        RowValue(const Result result_, MYSQL_ROW row_, size_type col_, size_type len_)
-          : result(result_),
-            row(row_),
+        /// The value is stored in a ResultRow, which keeps the result
+        RowValue(MYSQL_ROW row_, size_type col_, size_type len_)
+          : row(row_),
             col(col_),
             len(len_)
             { }
@@ -31,10 +31,10 @@
 
 #include <tntdb/iface/istatement.h>
 #include <tntdb/iface/irow.h>
+#include <tntdb/parsedstmt.h>
 #include <tntdb/mysql/bindvalues.h>
 #include <tntdb/mysql/impl/boundrow.h>
 #include <tntdb/mysql/impl/connection.h>
-#include <map>
 
 namespace tntdb
 {
@@ -42,21 +42,29 @@ namespace tntdb
   {
     class Statement : public IStatement
     {
-        typedef std::multimap<std::string, unsigned> hostvarMapType;
+      public:
+        typedef ParsedStmt::hostvarMapType hostvarMapType;
+        typedef ParsedStmt::positionsType positionsType;
+        typedef ParsedStmt::paramsType paramsType;
 
+      private:
         Connection* conn;
-        std::string query;
+        cxxtools::SmartPtr<ParsedStmt> parsed;
         BindValues inVars;
-        hostvarMapType hostvarMap;
         MYSQL* mysql;
         MYSQL_STMT* stmt;
         MYSQL_FIELD* fields;
         unsigned field_count;
+        // column names shared by all rows of the statement
+        cxxtools::SmartPtr<ColumnDescriptor> columns;
         cxxtools::SmartPtr<BoundRow> rowPtr;
 
         cxxtools::SmartPtr<BoundRow> getRow();
         cxxtools::SmartPtr<IRow> fetchRow();
 
+        // positions of each host variable in the query
+        const paramsType& params() const  { return parsed->getParams(); }
+
       public:
         Statement(Connection* conn, MYSQL* mysql,
           const std::string& query);
@@ -65,33 +73,41 @@ namespace tntdb
         // methods of IStatement
 
         void clear();
-        void setNull(const std::string& col);
-        void setBool(const std::string& col, bool data);
-        void setShort(const std::string& col, short data);
-        void setInt(const std::string& col, int data);
-        void setLong(const std::string& col, long data);
-        void setUnsignedShort(const std::string& col, unsigned short data);
-        void setUnsigned(const std::string& col, unsigned data);
-        void setUnsignedLong(const std::string& col, unsigned long data);
-        void setInt32(const std::string& col, int32_t data);
-        void setUnsigned32(const std::string& col, uint32_t data);
-        void setInt64(const std::string& col, int64_t data);
-        void setUnsigned64(const std::string& col, uint64_t data);
-        void setDecimal(const std::string& col, const Decimal& data);
-        void setFloat(const std::string& col, float data);
-        void setDouble(const std::string& col, double data);
-        void setChar(const std::string& col, char data);
-        void setString(const std::string& col, const std::string& data);
-        void setBlob(const std::string& col, const Blob& data);
-        void setDate(const std::string& col, const Date& data);
-        void setTime(const std::string& col, const Time& data);
-        void setDatetime(const std::string& col, const Datetime& data);
+        size_type paramIndex(const std::string& col);
+        size_type findParam(const std::string& col);
+        void setNull(size_type idx);
+        void setBool(size_type idx, bool data);
+        void setShort(size_type idx, short data);
+        void setInt(size_type idx, int data);
+        void setLong(size_type idx, long data);
+        void setUnsignedShort(size_type idx, unsigned short data);
+        void setUnsigned(size_type idx, unsigned data);
+        void setUnsignedLong(size_type idx, unsigned long data);
+        void setInt32(size_type idx, int32_t data);
+        void setUnsigned32(size_type idx, uint32_t data);
+        void setInt64(size_type idx, int64_t data);
+        void setUnsigned64(size_type idx, uint64_t data);
+        void setDecimal(size_type idx, const Decimal& data);
+        void setFloat(size_type idx, float data);
+        void setDouble(size_type idx, double data);
+        void setChar(size_type idx, char data);
+        void setString(size_type idx, const std::string& data);
+        void setBlob(size_type idx, const Blob& data);
+        void setString(size_type idx, const char* data, std::size_t length);
+        void setStringRef(size_type idx, const char* data, std::size_t length);
+        void setBlobRef(size_type idx, const char* data, std::size_t length);
+        void setDate(size_type idx, const Date& data);
+        void setTime(size_type idx, const Time& data);
+        void setDatetime(size_type idx, const Datetime& data);
 
         size_type execute();
         tntdb::Result select();
         tntdb::Row selectRow();
         tntdb::Value selectValue();
         ICursor* createCursor(unsigned fetchsize);
+        size_type forEach(RowVisitor& visitor, unsigned fetchsize);
+        void prepare();
+        size_type executeBatch(const Batch& batch);
 
         // specfic methods
 
@@ -108,6 +124,7 @@ namespace tntdb
 
         MYSQL_FIELD* getFields();
         unsigned getFieldCount();
+        ColumnDescriptor* getColumns();
     };
   }
 }
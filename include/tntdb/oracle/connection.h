@@ -94,6 +94,8 @@ namespace tntdb
         tntdb::Statement prepare(const std::string& query);
         void clearStatementCache();
         bool ping();
+        bool isAlive();
+        bool reset();
         long lastInsertId(const std::string& name);
         void lockTable(const std::string& tablename, bool exclusive);
 
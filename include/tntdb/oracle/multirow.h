@@ -31,6 +31,7 @@
 
 #include <tntdb/oracle/statement.h>
 #include <tntdb/oracle/multivalue.h>
+#include <tntdb/impl/columndescriptor.h>
 #include <vector>
 
 namespace tntdb
@@ -43,6 +44,9 @@ namespace tntdb
         typedef std::vector<tntdb::Value> Values;
         Columns _columns;
         Values _values;
+        ColumnDescriptor _descriptor;  // upper case column names
+
+        void initDescriptor();
 
       public:
         typedef cxxtools::SmartPtr<MultiRow> Ptr;
@@ -56,6 +60,8 @@ namespace tntdb
         MultiValue::Ptr getValuesByNumber(unsigned field_num) const;
         MultiValue::Ptr getValuesByName(const std::string& field_name) const;
         Columns::size_type getColIndexByName(const std::string& field_name) const;
+        /// Returns the index of the column or ColumnDescriptor::npos if not found
+        Columns::size_type findColIndexByName(const std::string& field_name) const;
         std::string getColumnName(unsigned field_num) const;
     };
   }
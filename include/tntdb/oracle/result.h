@@ -31,6 +31,7 @@
 
 #include <tntdb/iface/iresult.h>
 #include <tntdb/row.h>
+#include <tntdb/oracle/multirow.h>
 #include <vector>
 #include <oci.h>
 
@@ -45,6 +46,15 @@ namespace tntdb
         ub4 columncount;
         std::vector<tntdb::Row> rows;
 
+        // fetched blocks of rows with the number of rows in each block;
+        // empty when the rows were fetched one by one
+        typedef std::vector<std::pair<MultiRow::Ptr, unsigned> > BlocksType;
+        BlocksType blocks;
+
+        template <typename T>
+        void readColumn(size_type field_num, std::vector<T>& values,
+          std::vector<bool>& nulls, T (MultiValue::*getter)(unsigned) const) const;
+
       public:
         Result(oracle::Statement* conn);
         Result(oracle::Statement* conn, unsigned fetchsize);
@@ -52,6 +62,13 @@ namespace tntdb
         Row getRow(size_type tup_num) const;
         size_type size() const;
         size_type getFieldCount() const;
+
+        void getColumn(size_type field_num, std::vector<int64_t>& values,
+          std::vector<bool>& nulls) const;
+        void getColumn(size_type field_num, std::vector<double>& values,
+          std::vector<bool>& nulls) const;
+        void getColumn(size_type field_num, std::vector<std::string>& values,
+          std::vector<bool>& nulls) const;
     };
   }
 }
@@ -54,6 +54,14 @@ namespace tntdb
         virtual tntdb::Value getValueByNumber(size_type field_num) const;
         virtual tntdb::Value getValueByName(const std::string& field_name) const;
         virtual std::string getColumnName(size_type field_num) const;
+        virtual size_type getColumnIndex(const std::string& field_name) const;
+        virtual bool isNull(size_type field_num) const;
+        virtual bool getBool(size_type field_num) const;
+        virtual int getInt(size_type field_num) const;
+        virtual int64_t getInt64(size_type field_num) const;
+        virtual uint64_t getUnsigned64(size_type field_num) const;
+        virtual double getDouble(size_type field_num) const;
+        virtual void getString(size_type field_num, std::string& ret) const;
     };
   }
 }
@@ -35,6 +35,7 @@
 #include <string>
 #include <string.h>
 #include <map>
+#include <set>
 #include <tntdb/oracle/datetime.h>
 #include <tntdb/oracle/blob.h>
 #include <tntdb/oracle/number.h>
@@ -57,19 +58,22 @@ namespace tntdb
         class Bind : public cxxtools::RefCounted
         {
           public:
+            std::string name;
             OCIBind* ptr;
             std::vector<char> data;
             sb2 indicator;
             Datetime datetime;
             Blob blob;
+            tntdb::Blob sharedBlob;
             Number number;
 
             const char* boundPtr;
             int boundType;
             unsigned boundLength;
 
-            Bind()
-              : ptr(0),
+            explicit Bind(const std::string& name_)
+              : name(name_),
+                ptr(0),
                 indicator(0),
                 boundPtr(0),
                 boundType(0),
@@ -91,11 +95,21 @@ namespace tntdb
             }
         };
 
-        typedef std::map<std::string, cxxtools::SmartPtr<Bind> > BindMapType;
-        BindMapType bindMap;
+        typedef std::map<std::string, size_type> BindMapType;
+        typedef std::vector<cxxtools::SmartPtr<Bind> > BindsType;
+        BindMapType bindMap;  // index into binds by name
+        BindsType binds;
+        std::set<std::string> paramNames;  // upper case names of the host variables
+        bool paramNamesRead;
 
-        Bind* getBindPtr(const std::string& col);
-        Bind& getBind(const std::string& col)   { return *getBindPtr(col); }
+        void readParamNames();
+
+        Bind* getBindPtr(size_type idx)
+          { return idx < binds.size() ? binds[idx].getPointer() : 0; }
+
+        void unbindArrays(const std::vector<size_type>& idx);
+        // binds the parameter to data, which is not copied
+        void bindRef(size_type idx, const char* data, unsigned length, int type);
 
       public:
         /** convenience method */
@@ -108,33 +122,40 @@ namespace tntdb
         // methods of IStatement
 
         void clear();
-        void setNull(const std::string& col);
-        void setBool(const std::string& col, bool data);
-        void setShort(const std::string& col, short data);
-        void setInt(const std::string& col, int data);
-        void setLong(const std::string& col, long data);
-        void setUnsignedShort(const std::string& col, unsigned short data);
-        void setUnsigned(const std::string& col, unsigned data);
-        void setUnsignedLong(const std::string& col, unsigned long data);
-        void setInt32(const std::string& col, int32_t data);
-        void setUnsigned32(const std::string& col, uint32_t data);
-        void setInt64(const std::string& col, int64_t data);
-        void setUnsigned64(const std::string& col, uint64_t data);
-        void setDecimal(const std::string& col, const Decimal& data);
-        void setFloat(const std::string& col, float data);
-        void setDouble(const std::string& col, double data);
-        void setChar(const std::string& col, char data);
-        void setString(const std::string& col, const std::string& data);
-        void setBlob(const std::string& col, const tntdb::Blob& data);
-        void setDate(const std::string& col, const Date& data);
-        void setTime(const std::string& col, const Time& data);
-        void setDatetime(const std::string& col, const tntdb::Datetime& data);
+        size_type paramIndex(const std::string& col);
+        size_type findParam(const std::string& col);
+        void setNull(size_type idx);
+        void setBool(size_type idx, bool data);
+        void setShort(size_type idx, short data);
+        void setInt(size_type idx, int data);
+        void setLong(size_type idx, long data);
+        void setUnsignedShort(size_type idx, unsigned short data);
+        void setUnsigned(size_type idx, unsigned data);
+        void setUnsignedLong(size_type idx, unsigned long data);
+        void setInt32(size_type idx, int32_t data);
+        void setUnsigned32(size_type idx, uint32_t data);
+        void setInt64(size_type idx, int64_t data);
+        void setUnsigned64(size_type idx, uint64_t data);
+        void setDecimal(size_type idx, const Decimal& data);
+        void setFloat(size_type idx, float data);
+        void setDouble(size_type idx, double data);
+        void setChar(size_type idx, char data);
+        void setString(size_type idx, const std::string& data);
+        void setBlob(size_type idx, const tntdb::Blob& data);
+        void setString(size_type idx, const char* data, std::size_t length);
+        void setStringRef(size_type idx, const char* data, std::size_t length);
+        void setBlobRef(size_type idx, const char* data, std::size_t length);
+        void setDate(size_type idx, const Date& data);
+        void setTime(size_type idx, const Time& data);
+        void setDatetime(size_type idx, const tntdb::Datetime& data);
 
         size_type execute();
         tntdb::Result select();
         tntdb::Row selectRow();
         tntdb::Value selectValue();
         ICursor* createCursor(unsigned fetchsize);
+        void prepare();
+        size_type executeBatch(const Batch& batch);
 
         // getter
         Connection* getConnection() const     { return conn; }
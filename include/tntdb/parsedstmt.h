@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TNTDB_PARSEDSTMT_H
+#define TNTDB_PARSEDSTMT_H
+
+#include <cxxtools/refcounted.h>
+#include <cxxtools/smartptr.h>
+#include <string>
+#include <map>
+#include <vector>
+
+namespace tntdb
+{
+  /** Immutable result of parsing a query with host variables.
+
+      Drivers, which pass positional placeholders to the database, need the
+      rewritten query and the positions of each host variable. Both depend
+      only on the query text and the placeholder style of the driver, so the
+      result is parsed once and shared between all statements and connections
+      using the same query.
+
+      Parsed statements are obtained with ParsedStmt::get. The cache is bounded;
+      entries, which are not referenced by any statement, are dropped when it is
+      full.
+   */
+  class ParsedStmt : public cxxtools::AtomicRefCounted
+  {
+    public:
+      enum Style {
+        /// placeholders are numbered $1, $2, ...; a repeated host variable reuses its number
+        NUMBERED,
+        /// each occurrence of a host variable is replaced by a '?'
+        QUESTIONMARK
+      };
+
+      typedef std::map<std::string, unsigned> hostvarMapType;
+      typedef std::vector<unsigned> positionsType;
+      typedef std::vector<positionsType> paramsType;
+
+    private:
+      std::string _sql;
+      hostvarMapType _hostvarMap;   // index into _params by name
+      paramsType _params;           // positions of each host variable in the query
+      unsigned _placeholderCount;
+
+      ParsedStmt(const std::string& query, Style style);
+
+      // adds to the cache; caller holds the cache mutex
+      static cxxtools::SmartPtr<ParsedStmt> insert(const std::string& query, Style style,
+        cxxtools::SmartPtr<ParsedStmt> parsed);
+
+    public:
+      /// Creates a parse result from parts computed elsewhere, e.g. by StaticSql at compile time.
+      ParsedStmt(const std::string& sql, const hostvarMapType& hostvarMap,
+                 const paramsType& params, unsigned placeholderCount)
+        : _sql(sql),
+          _hostvarMap(hostvarMap),
+          _params(params),
+          _placeholderCount(placeholderCount)
+        { }
+
+      /// Returns the parse result for the query, parsing it only if it is not cached yet.
+      static cxxtools::SmartPtr<ParsedStmt> get(const std::string& query, Style style);
+
+      /// Returns true, if the query is cached for the style.
+      static bool isCached(const std::string& query, Style style);
+
+      /// Adds a parse result to the cache, unless the query is cached already.
+      static void put(const std::string& query, Style style, cxxtools::SmartPtr<ParsedStmt> parsed);
+
+      /// Sets the maximum number of cached parse results. 0 disables the cache.
+      static void setCacheSize(unsigned n);
+      static unsigned getCacheSize();
+
+      /// Removes all unreferenced parse results from the cache.
+      static void clearCache();
+
+      /// The query with host variables replaced by placeholders.
+      const std::string& getSql() const          { return _sql; }
+      /// Maps host variable names to parameter indexes.
+      const hostvarMapType& getHostvarMap() const { return _hostvarMap; }
+      /// Placeholder positions indexed by parameter index.
+      const paramsType& getParams() const         { return _params; }
+      /// Number of distinct host variables.
+      unsigned getParamCount() const              { return _params.size(); }
+      /// Number of placeholders in the rewritten query.
+      unsigned getPlaceholderCount() const        { return _placeholderCount; }
+  };
+}
+
+#endif // TNTDB_PARSEDSTMT_H
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#ifndef TNTDB_POOLSTATISTICS_H
+#define TNTDB_POOLSTATISTICS_H
+
+#include <cxxtools/timespan.h>
+#include <string>
+
+namespace cxxtools
+{
+  class SerializationInfo;
+}
+
+namespace tntdb
+{
+  /** Histogram of durations with fixed buckets
+
+      The buckets have upper bounds from 1 ms to 10 s; longer durations are
+      counted in the last bucket.
+   */
+  class PoolHistogram
+  {
+    public:
+      static const unsigned bucketCount = 14;
+
+    private:
+      unsigned long _counts[bucketCount];
+      unsigned long _count;
+      cxxtools::Timespan _sum;
+
+    public:
+      PoolHistogram();
+
+      /// Adds a duration to the histogram
+      void add(const cxxtools::Timespan& t);
+
+      /// Returns the upper bound of the bucket in milliseconds; the last bucket has no limit
+      static unsigned bound(unsigned bucket);
+
+      /// Returns the number of durations counted in the given bucket
+      unsigned long count(unsigned bucket) const   { return _counts[bucket]; }
+      /// Returns the total number of durations
+      unsigned long count() const                  { return _count; }
+      /// Returns the sum of all durations
+      const cxxtools::Timespan& sum() const        { return _sum; }
+  };
+
+  /// Snapshot of the state and the counters of a connection pool
+  struct PoolStatistics
+  {
+    std::string url;
+    /// connections currently handed out to the application
+    unsigned inUse;
+    /// unused connections kept in the pool, including those being validated
+    unsigned idle;
+    /// callers currently waiting for a connection
+    unsigned waiting;
+    /// connections created since the pool exists
+    unsigned long created;
+    /// connections dropped since they were found dead
+    unsigned long droppedDead;
+    /// calls of connect, which had to wait
+    unsigned long waits;
+    /// calls of connect, which timed out
+    unsigned long timeouts;
+    /// calls of connect, which were rejected since too many callers were waiting
+    unsigned long rejected;
+    /// time spent in connect
+    PoolHistogram checkoutWait;
+    /// time the application held the connections
+    PoolHistogram holdTime;
+
+    PoolStatistics()
+      : inUse(0),
+        idle(0),
+        waiting(0),
+        created(0),
+        droppedDead(0),
+        waits(0),
+        timeouts(0),
+        rejected(0)
+      { }
+  };
+
+  void operator<<= (cxxtools::SerializationInfo& si, const PoolHistogram& histogram);
+  void operator<<= (cxxtools::SerializationInfo& si, const PoolStatistics& statistics);
+}
+
+#endif // TNTDB_POOLSTATISTICS_H
+
@@ -65,6 +65,7 @@ namespace tntdb
         unsigned transactionActive;
         unsigned stmtCounter;
         std::vector<std::string> stmtsToDeallocate;
+        bool broken;   // the state of the session is unknown after a failure
 
       public:
         explicit Connection(const char* conninfo);
@@ -80,10 +81,14 @@ namespace tntdb
         tntdb::Value selectValue(const std::string& query);
         tntdb::Statement prepare(const std::string& query);
         bool ping();
+        bool isAlive();
+        bool reset();
         long lastInsertId(const std::string& name);
         void lockTable(const std::string& tablename, bool exclusive);
 
         PGconn* getPGConn() const      { return conn; }
+        /// Marks the connection as unusable; ping, isAlive and reset fail then
+        void setBroken()               { broken = true; }
         unsigned getNextStmtNumber()   { return ++stmtCounter; }
         void deallocateStatement(const std::string& stmtName);
         void deallocateStatements();
@@ -31,6 +31,8 @@
 
 #include <tntdb/iface/iresult.h>
 #include <tntdb/bits/connection.h>
+#include <tntdb/impl/columndescriptor.h>
+#include <cxxtools/smartptr.h>
 #include <libpq-fe.h>
 
 namespace tntdb
@@ -41,16 +43,28 @@ namespace tntdb
     {
         tntdb::Connection conn;
         PGresult* result;
+        mutable cxxtools::SmartPtr<ColumnDescriptor> columns;
 
       public:
         Result(const tntdb::Connection& conn, PGresult* result);
         ~Result();
 
         PGresult* getPGresult() const  { return result; }
+        /// Replaces the result with one with the same columns
+        void reset(PGresult* r);
+        /// Returns the column names, which are read on first use
+        const ColumnDescriptor& getColumns() const;
 
         Row getRow(size_type tup_num) const;
         size_type size() const;
         size_type getFieldCount() const;
+
+        void getColumn(size_type field_num, std::vector<int64_t>& values,
+          std::vector<bool>& nulls) const;
+        void getColumn(size_type field_num, std::vector<double>& values,
+          std::vector<bool>& nulls) const;
+        void getColumn(size_type field_num, std::vector<std::string>& values,
+          std::vector<bool>& nulls) const;
     };
   }
 }
@@ -31,6 +31,8 @@
 
 #include <tntdb/bits/result.h>
 #include <tntdb/iface/irow.h>
+#include <tntdb/impl/valueslots.h>
+#include <tntdb/postgresql/impl/resultvalue.h>
 #include <libpq-fe.h>
 
 namespace tntdb
@@ -46,6 +48,7 @@ namespace tntdb
         Result* result; // redundant type-safe pointer to tntdbResult
                         // (tntdbResult.getImpl() == result)
         size_type rownumber;
+        ValueSlots<ResultValue> values;
 
       public:
         ResultRow(Result* result, size_type rownumber);
@@ -54,6 +57,14 @@ namespace tntdb
         Value getValueByNumber(size_type field_num) const;
         Value getValueByName(const std::string& field_name) const;
         std::string getColumnName(size_type field_num) const;
+        size_type getColumnIndex(const std::string& field_name) const;
+        bool isNull(size_type field_num) const;
+        bool getBool(size_type field_num) const;
+        int getInt(size_type field_num) const;
+        int64_t getInt64(size_type field_num) const;
+        uint64_t getUnsigned64(size_type field_num) const;
+        double getDouble(size_type field_num) const;
+        void getString(size_type field_num, std::string& ret) const;
 
         size_type getRowNumber() const   { return rownumber; }
         PGresult* getPGresult() const;
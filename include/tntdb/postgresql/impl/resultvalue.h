@@ -30,25 +30,24 @@
 #define TNTDB_POSTGRESQL_IMPL_RESULTVALUE_H
 
 #include <tntdb/iface/ivalue.h>
-#include <tntdb/postgresql/impl/resultrow.h>
-#include <tntdb/bits/row.h>
 #include <libpq-fe.h>
+#include <string>
 
 namespace tntdb
 {
   namespace postgresql
   {
+    class ResultRow;
+
+    /// Value of a ResultRow; the value is stored in the row
     class ResultValue : public IValue
     {
-        tntdb::Row tntdbRow; // keeps a reference to the row
-        ResultRow* row; // redundant type-safe pointer to tntdbRow
-                        // (tntdbRow.getImpl() == row)
+        const ResultRow* row;
         int tup_num;
 
       public:
-        ResultValue(ResultRow* row_, int tup_num_)
-          : tntdbRow(row_),
-            row(row_),
+        ResultValue(const ResultRow* row_, int tup_num_)
+          : row(row_),
             tup_num(tup_num_)
         { }
 
@@ -75,7 +74,8 @@ namespace tntdb
         virtual Datetime getDatetime() const;
 
         std::string getString() const    { std::string ret; getString(ret); return ret; }
-        PGresult* getPGresult() const    { return row->getPGresult(); }
+        PGresult* getPGresult() const;
+        template <typename T> T getNumber(const char* tname) const;
     };
   }
 }
@@ -31,7 +31,9 @@
 
 #include <tntdb/iface/istatement.h>
 #include <tntdb/bits/connection.h>
-#include <map>
+#include <tntdb/parsedstmt.h>
+#include <tntdb/blob.h>
+#include <tntdb/decimal.h>
 #include <vector>
 #include <libpq-fe.h>
 
@@ -44,30 +46,50 @@ namespace tntdb
     class Statement : public IStatement
     {
         Connection* conn;
-        std::string query;
+        cxxtools::SmartPtr<ParsedStmt> parsed;
         std::string stmtName;
-        typedef std::map<std::string, unsigned> hostvarMapType;
-        hostvarMapType hostvarMap;
 
         class valueType
         {
             bool isNull;
             std::string value;
+            // borrowed data, which is passed to libpq instead of value
+            const char* ref;
+            unsigned refLength;
+            bool textRef;
+            Blob blob;
 #ifndef HAVE_PQPREPARE
             std::string type;
 #endif
 
           public:
-#ifndef HAVE_PQPREPARE
             valueType()
-              : type("text")
-              { }
+              : isNull(true),
+                ref(0),
+                refLength(0),
+                textRef(false)
+#ifndef HAVE_PQPREPARE
+                , type("text")
 #endif
-            void setNull()            { isNull = true; }
+              { }
+
+            void setNull()            { isNull = true; ref = 0; textRef = false; }
             void setValue(const std::string& v)
-                                      { value = v; isNull = false; }
-            const char* getValue()    { return isNull ? 0 : value.data(); }
-            unsigned getLength()      { return isNull ? 0 : value.size(); }
+                                      { value = v; isNull = false; ref = 0; textRef = false; }
+            // reuses the buffer of the previous value
+            void setValue(const char* v, unsigned length)
+                                      { value.assign(v, length); isNull = false; ref = 0; textRef = false; }
+            void setDecimal(const Decimal& d)
+                                      { d.toString(value); isNull = false; ref = 0; textRef = false; }
+            void setRef(const char* data, unsigned length, bool text)
+                                      { ref = data; refLength = length; isNull = false; textRef = text; }
+            void setBlob(const Blob& b)
+                                      { blob = b; setRef(blob.data(), blob.size(), false); }
+            // copies borrowed text since the text format needs a terminating zero
+            void copyRef()            { value.assign(ref, refLength); ref = 0; textRef = false; }
+            bool isTextRef() const    { return textRef; }
+            const char* getValue()    { return isNull ? 0 : ref ? ref : value.data(); }
+            unsigned getLength()      { return isNull ? 0 : ref ? refLength : value.size(); }
 #ifndef HAVE_PQPREPARE
             void setType(const std::string& t)   { type = t; }
             const std::string& getType() const   { return type; }
@@ -80,19 +102,20 @@ namespace tntdb
         std::vector<const char*> paramValues;
         std::vector<int> paramLengths;
         std::vector<int> paramFormats;
+        std::vector<Oid> paramTypes;
 
         // helper-methods for setting values
         template <typename T>
-        void setValue(const std::string& col, T data);
+        void setValue(size_type idx, T data);
 
         template <typename T>
-        void setStringValue(const std::string& col, T data, bool binary = false);
+        void setStringValue(size_type idx, T data, bool binary = false);
 
         template <typename T>
-        void setIsoValue(const std::string& col, T data);
+        void setIsoValue(size_type idx, T data);
 
 #ifndef HAVE_PQPREPARE
-        void setType(const std::string& col, const std::string& type);
+        void setType(size_type idx, const std::string& type);
 #endif
 
         void doPrepare();
@@ -105,41 +128,55 @@ namespace tntdb
         // methods of IStatement
 
         void clear();
-        void setNull(const std::string& col);
-        void setBool(const std::string& col, bool data);
-        void setShort(const std::string& col, short data);
-        void setInt(const std::string& col, int data);
-        void setLong(const std::string& col, long data);
-        void setUnsignedShort(const std::string& col, unsigned short data);
-        void setUnsigned(const std::string& col, unsigned data);
-        void setUnsignedLong(const std::string& col, unsigned long data);
-        void setInt32(const std::string& col, int32_t data);
-        void setUnsigned32(const std::string& col, uint32_t data);
-        void setInt64(const std::string& col, int64_t data);
-        void setUnsigned64(const std::string& col, uint64_t data);
-        void setDecimal(const std::string& col, const Decimal& data);
-        void setFloat(const std::string& col, float data);
-        void setDouble(const std::string& col, double data);
-        void setChar(const std::string& col, char data);
-        void setString(const std::string& col, const std::string& data);
-        void setBlob(const std::string& col, const Blob& data);
-        void setDate(const std::string& col, const Date& data);
-        void setTime(const std::string& col, const Time& data);
-        void setDatetime(const std::string& col, const Datetime& data);
+        size_type paramIndex(const std::string& col);
+        size_type findParam(const std::string& col);
+        void setNull(size_type idx);
+        void setBool(size_type idx, bool data);
+        void setShort(size_type idx, short data);
+        void setInt(size_type idx, int data);
+        void setLong(size_type idx, long data);
+        void setUnsignedShort(size_type idx, unsigned short data);
+        void setUnsigned(size_type idx, unsigned data);
+        void setUnsignedLong(size_type idx, unsigned long data);
+        void setInt32(size_type idx, int32_t data);
+        void setUnsigned32(size_type idx, uint32_t data);
+        void setInt64(size_type idx, int64_t data);
+        void setUnsigned64(size_type idx, uint64_t data);
+        void setDecimal(size_type idx, const Decimal& data);
+        void setFloat(size_type idx, float data);
+        void setDouble(size_type idx, double data);
+        void setChar(size_type idx, char data);
+        void setString(size_type idx, const std::string& data);
+        void setBlob(size_type idx, const Blob& data);
+        void setString(size_type idx, const char* data, std::size_t length);
+        void setStringRef(size_type idx, const char* data, std::size_t length);
+        void setBlobRef(size_type idx, const char* data, std::size_t length);
+        void setDate(size_type idx, const Date& data);
+        void setTime(size_type idx, const Time& data);
+        void setDatetime(size_type idx, const Datetime& data);
 
         size_type execute();
         tntdb::Result select();
         tntdb::Row selectRow();
         tntdb::Value selectValue();
         ICursor* createCursor(unsigned fetchsize);
+        void prepare();
+#ifdef HAVE_PQSETSINGLEROWMODE
+        size_type forEach(RowVisitor& visitor, unsigned fetchsize);
+#endif
+#ifdef LIBPQ_HAS_PIPELINING
+        size_type executeBatch(const Batch& batch);
+#endif
 
         // specific methods
-        const std::string& getQuery() const   { return query; }
+        const std::string& getQuery() const   { return parsed->getSql(); }
         int getNParams()               { return values.size(); }
         const char* const* getParamValues();
         const int* getParamLengths();
         const int* getParamFormats()
             { return &paramFormats[0]; }
+        // decides, how borrowed strings are passed; must be called before passing the parameters
+        void resolveTextRefs(bool prepared);
         PGconn* getPGConn();
         Connection* getConnection()    { return conn; }
     };
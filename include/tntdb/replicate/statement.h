@@ -31,6 +31,7 @@
 
 #include <tntdb/iface/istatement.h>
 #include <tntdb/statement.h>
+#include <map>
 #include <vector>
 
 namespace tntdb
@@ -44,6 +45,10 @@ namespace tntdb
         Connection* conn;
         typedef std::vector<tntdb::Statement> Statements;
         Statements statements;
+        typedef std::map<std::string, size_type> HostvarMapType;
+        typedef std::vector<std::vector<size_type> > ParamsType;
+        HostvarMapType hostvarMap;  // index into params by name
+        ParamsType params;          // index of a host variable in each statement
 
       public:
         Statement(Connection* conn, const std::string& query);
@@ -51,33 +56,41 @@ namespace tntdb
         // methods of IStatement
 
         void clear();
-        void setNull(const std::string& col);
-        void setBool(const std::string& col, bool data);
-        void setShort(const std::string& col, short data);
-        void setInt(const std::string& col, int data);
-        void setLong(const std::string& col, long data);
-        void setUnsignedShort(const std::string& col, unsigned short data);
-        void setUnsigned(const std::string& col, unsigned data);
-        void setUnsignedLong(const std::string& col, unsigned long data);
-        void setInt32(const std::string& col, int32_t data);
-        void setUnsigned32(const std::string& col, uint32_t data);
-        void setInt64(const std::string& col, int64_t data);
-        void setUnsigned64(const std::string& col, uint64_t data);
-        void setDecimal(const std::string& col, const Decimal& data);
-        void setFloat(const std::string& col, float data);
-        void setDouble(const std::string& col, double data);
-        void setChar(const std::string& col, char data);
-        void setString(const std::string& col, const std::string& data);
-        void setBlob(const std::string& col, const Blob& data);
-        void setDate(const std::string& col, const Date& data);
-        void setTime(const std::string& col, const Time& data);
-        void setDatetime(const std::string& col, const Datetime& data);
+        size_type paramIndex(const std::string& col);
+        size_type findParam(const std::string& col);
+        void setNull(size_type idx);
+        void setBool(size_type idx, bool data);
+        void setShort(size_type idx, short data);
+        void setInt(size_type idx, int data);
+        void setLong(size_type idx, long data);
+        void setUnsignedShort(size_type idx, unsigned short data);
+        void setUnsigned(size_type idx, unsigned data);
+        void setUnsignedLong(size_type idx, unsigned long data);
+        void setInt32(size_type idx, int32_t data);
+        void setUnsigned32(size_type idx, uint32_t data);
+        void setInt64(size_type idx, int64_t data);
+        void setUnsigned64(size_type idx, uint64_t data);
+        void setDecimal(size_type idx, const Decimal& data);
+        void setFloat(size_type idx, float data);
+        void setDouble(size_type idx, double data);
+        void setChar(size_type idx, char data);
+        void setString(size_type idx, const std::string& data);
+        void setBlob(size_type idx, const Blob& data);
+        void setString(size_type idx, const char* data, std::size_t length);
+        void setStringRef(size_type idx, const char* data, std::size_t length);
+        void setBlobRef(size_type idx, const char* data, std::size_t length);
+        void setDate(size_type idx, const Date& data);
+        void setTime(size_type idx, const Time& data);
+        void setDatetime(size_type idx, const Datetime& data);
 
         size_type execute();
+        size_type executeBatch(const Batch& batch);
         tntdb::Result select();
         tntdb::Row selectRow();
         tntdb::Value selectValue();
         ICursor* createCursor(unsigned fetchsize);
+        size_type forEach(RowVisitor& visitor, unsigned fetchsize);
+        void prepare();
 
     };
   }
@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TNTDB_ROWVISITOR_H
+#define TNTDB_ROWVISITOR_H
+
+namespace tntdb
+{
+  class Row;
+
+  /** Receives the rows of a query one at a time (see Statement::forEach).
+
+      The driver calls visit from inside its fetch loop. The row passed is
+      valid only during the call: the driver reuses the row and its buffers
+      for the next row, so neither the row nor values read from it may be
+      kept. Copy the data, which is needed later.
+
+      Example:
+      @code
+        class SumVisitor : public tntdb::RowVisitor
+        {
+          public:
+            double sum;
+            SumVisitor() : sum(0) { }
+            void visit(const tntdb::Row& row)
+              { sum += row.getDouble(0); }
+        };
+
+        SumVisitor v;
+        conn.prepare("select amount from orders").forEach(v);
+      @endcode
+   */
+  class RowVisitor
+  {
+    public:
+      virtual ~RowVisitor() { }
+
+      /// Called for each row of the result
+      virtual void visit(const Row& row) = 0;
+  };
+}
+
+#endif // TNTDB_ROWVISITOR_H
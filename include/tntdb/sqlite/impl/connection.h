@@ -78,6 +78,7 @@ namespace tntdb
         bool ping();
         long lastInsertId(const std::string& name);
         void lockTable(const std::string& tablename, bool exclusive);
+        bool reset();
 
         sqlite3* getSqlite3() const  { return db; }
     };
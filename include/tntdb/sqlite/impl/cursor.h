@@ -30,6 +30,7 @@
 #define TNTDB_SQLITE_IMPL_CURSOR_H
 
 #include <tntdb/iface/icursor.h>
+#include <tntdb/row.h>
 #include <cxxtools/smartptr.h>
 #include <sqlite3.h>
 
@@ -43,6 +44,7 @@ namespace tntdb
     {
         cxxtools::SmartPtr<Statement> statement;
         sqlite3_stmt* stmt;
+        Row row;  // reads the current values of stmt, so it serves all steps
 
       public:
         Cursor(Statement* statement, sqlite3_stmt* stmt);
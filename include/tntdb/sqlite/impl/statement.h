@@ -30,7 +30,11 @@
 #define TNTDB_SQLITE_IMPL_SQLSTATEMENT_H
 
 #include <tntdb/iface/istatement.h>
+#include <tntdb/blob.h>
+#include <tntdb/impl/columndescriptor.h>
+#include <cxxtools/smartptr.h>
 #include <sqlite3.h>
+#include <vector>
 
 namespace tntdb
 {
@@ -46,11 +50,13 @@ namespace tntdb
         const std::string query;
 
         sqlite3_stmt* getBindStmt();
-        int getBindIndex(const std::string& col);
 
         bool needReset;
         void reset();
 
+        // blobs, which are bound without copying the data
+        std::vector<Blob> blobs;
+
       public:
         Statement(Connection* conn, const std::string& query);
         ~Statement();
@@ -58,38 +64,49 @@ namespace tntdb
         // methods of IStatement
 
         virtual void clear();
-        virtual void setNull(const std::string& col);
-        virtual void setBool(const std::string& col, bool data);
-        virtual void setShort(const std::string& col, short data);
-        virtual void setInt(const std::string& col, int data);
-        virtual void setLong(const std::string& col, long data);
-        virtual void setUnsignedShort(const std::string& col, unsigned short data);
-        virtual void setUnsigned(const std::string& col, unsigned data);
-        virtual void setUnsignedLong(const std::string& col, unsigned long data);
-        virtual void setInt32(const std::string& col, int32_t data);
-        virtual void setUnsigned32(const std::string& col, uint32_t data);
-        virtual void setInt64(const std::string& col, int64_t data);
-        virtual void setUnsigned64(const std::string& col, uint64_t data);
-        virtual void setDecimal(const std::string& col, const Decimal& data);
-        virtual void setFloat(const std::string& col, float data);
-        virtual void setDouble(const std::string& col, double data);
-        virtual void setChar(const std::string& col, char data);
-        virtual void setString(const std::string& col, const std::string& data);
-        virtual void setBlob(const std::string& col, const Blob& data);
-        virtual void setDate(const std::string& col, const Date& data);
-        virtual void setTime(const std::string& col, const Time& data);
-        virtual void setDatetime(const std::string& col, const Datetime& data);
+        virtual size_type paramIndex(const std::string& col);
+        virtual size_type findParam(const std::string& col);
+        virtual void setNull(size_type idx);
+        virtual void setBool(size_type idx, bool data);
+        virtual void setShort(size_type idx, short data);
+        virtual void setInt(size_type idx, int data);
+        virtual void setLong(size_type idx, long data);
+        virtual void setUnsignedShort(size_type idx, unsigned short data);
+        virtual void setUnsigned(size_type idx, unsigned data);
+        virtual void setUnsignedLong(size_type idx, unsigned long data);
+        virtual void setInt32(size_type idx, int32_t data);
+        virtual void setUnsigned32(size_type idx, uint32_t data);
+        virtual void setInt64(size_type idx, int64_t data);
+        virtual void setUnsigned64(size_type idx, uint64_t data);
+        virtual void setDecimal(size_type idx, const Decimal& data);
+        virtual void setFloat(size_type idx, float data);
+        virtual void setDouble(size_type idx, double data);
+        virtual void setChar(size_type idx, char data);
+        virtual void setString(size_type idx, const std::string& data);
+        virtual void setBlob(size_type idx, const Blob& data);
+        virtual void setString(size_type idx, const char* data, std::size_t length);
+        virtual void setStringRef(size_type idx, const char* data, std::size_t length);
+        virtual void setBlobRef(size_type idx, const char* data, std::size_t length);
+        virtual void setDate(size_type idx, const Date& data);
+        virtual void setTime(size_type idx, const Time& data);
+        virtual void setDatetime(size_type idx, const Datetime& data);
 
         virtual size_type execute();
         virtual tntdb::Result select();
         virtual tntdb::Row selectRow();
         virtual tntdb::Value selectValue();
         virtual ICursor* createCursor(unsigned fetchsize);
+        virtual size_type forEach(RowVisitor& visitor, unsigned fetchsize);
+        virtual void prepare();
+        virtual size_type executeBatch(const Batch& batch);
 
         // specific methods of sqlite-driver
         sqlite3_stmt* getStmt() const   { return stmt; }
 
         void putback(sqlite3_stmt* stmt);
+
+        /// Reads the column names and declared types of a prepared statement
+        static cxxtools::SmartPtr<ColumnDescriptor> createColumnDescriptor(sqlite3_stmt* stmt);
     };
   }
 }
@@ -31,6 +31,10 @@
 
 #include <tntdb/iface/irow.h>
 #include <tntdb/sqlite/impl/statement.h>
+#include <tntdb/impl/columndescriptor.h>
+#include <tntdb/impl/valueslots.h>
+#include <tntdb/sqlite/impl/stmtvalue.h>
+#include <cxxtools/smartptr.h>
 
 namespace tntdb
 {
@@ -40,16 +44,24 @@ namespace tntdb
     class StmtRow : public IRow
     {
         sqlite3_stmt* stmt;
+        cxxtools::SmartPtr<ColumnDescriptor> columns;
+        ValueSlots<StmtValue> values;
 
       public:
-        StmtRow(sqlite3_stmt* stmt_)
-          : stmt(stmt_)
-          { }
+        StmtRow(sqlite3_stmt* stmt_, ColumnDescriptor* columns_);
 
         unsigned size() const;
         Value getValueByNumber(size_type field_num) const;
         Value getValueByName(const std::string& field_name) const;
         std::string getColumnName(size_type field_num) const;
+        size_type getColumnIndex(const std::string& field_name) const;
+        bool isNull(size_type field_num) const;
+        bool getBool(size_type field_num) const;
+        int getInt(size_type field_num) const;
+        int64_t getInt64(size_type field_num) const;
+        uint64_t getUnsigned64(size_type field_num) const;
+        double getDouble(size_type field_num) const;
+        void getString(size_type field_num, std::string& ret) const;
 
         // specific methods of sqlite-driver
         sqlite3_stmt* getStmt() const   { return stmt; }
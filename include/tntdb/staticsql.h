@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TNTDB_STATICSQL_H
+#define TNTDB_STATICSQL_H
+
+#if __cplusplus >= 201402L
+
+#include <tntdb/parsedstmt.h>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace tntdb
+{
+  /** A statement literal parsed at compile time
+
+      The host variables of the literal are parsed by the compiler with the
+      same rules as StmtParser. The result holds the query rewritten for
+      drivers with positional placeholders ('?' and '$n') and the table of
+      host variables. Passing it to Connection::prepare stores the result in
+      the cache of ParsedStmt, so that the driver does not parse the query
+      at runtime.
+
+      Use the macro TNTDB_SQL to create a StaticSql from a literal and
+      TNTDB_PARAM to refer to a host variable. A misspelled host variable
+      in TNTDB_PARAM is a compile error:
+
+      @code
+        constexpr auto sel = TNTDB_SQL("select name from person where id = :id");
+
+        tntdb::Statement st = conn.prepare(sel);
+        st.set(TNTDB_PARAM(sel, "id"), 42);
+      @endcode
+
+      This class needs C++14.
+   */
+  template <std::size_t N>
+  class StaticSql
+  {
+      // the numbered output grows, when a short name gets a long number
+      static constexpr std::size_t OutSize = 3 * N;
+      static constexpr std::size_t MaxParams = N / 2 + 1;
+
+      char _query[N];
+      char _numbered[OutSize];
+      std::size_t _numberedSize;
+      char _questionmark[N];
+      std::size_t _questionmarkSize;
+
+      std::size_t _nameOffset[MaxParams];
+      std::size_t _nameLength[MaxParams];
+      std::size_t _paramCount;
+
+      std::size_t _placeholderParam[MaxParams];
+      std::size_t _placeholderCount;
+
+      constexpr void append(char ch)
+      {
+        _numbered[_numberedSize++] = ch;
+        _questionmark[_questionmarkSize++] = ch;
+      }
+
+      constexpr bool sameName(std::size_t offset, std::size_t length, std::size_t n) const
+      {
+        if (_nameLength[n] != length)
+          return false;
+        for (std::size_t i = 0; i < length; ++i)
+          if (_query[_nameOffset[n] + i] != _query[offset + i])
+            return false;
+        return true;
+      }
+
+      constexpr void onHostVar(std::size_t offset, std::size_t length)
+      {
+        std::size_t idx = 0;
+        while (idx < _paramCount && !sameName(offset, length, idx))
+          ++idx;
+
+        if (idx == _paramCount)
+        {
+          _nameOffset[_paramCount] = offset;
+          _nameLength[_paramCount] = length;
+          ++_paramCount;
+        }
+
+        _placeholderParam[_placeholderCount++] = idx;
+
+        _questionmark[_questionmarkSize++] = '?';
+
+        char digits[24] = { };
+        std::size_t d = 0;
+        std::size_t n = idx + 1;
+        do
+        {
+          digits[d++] = static_cast<char>('0' + n % 10);
+          n /= 10;
+        } while (n > 0);
+
+        _numbered[_numberedSize++] = '$';
+        while (d > 0)
+          _numbered[_numberedSize++] = digits[--d];
+      }
+
+      static constexpr bool isNameStart(char ch)
+      { return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z'); }
+
+      static constexpr bool isNameChar(char ch)
+      { return isNameStart(ch) || (ch >= '0' && ch <= '9') || ch == '_'; }
+
+    public:
+      constexpr explicit StaticSql(const char (&query)[N])
+        : _query(),
+          _numbered(),
+          _numberedSize(0),
+          _questionmark(),
+          _questionmarkSize(0),
+          _nameOffset(),
+          _nameLength(),
+          _paramCount(0),
+          _placeholderParam(),
+          _placeholderCount(0)
+      {
+        // same state machine as StmtParser with ':' as prefix
+        enum { STATE_0, STATE_NAME0, STATE_NAME, STATE_STRING, STATE_STRING_ESC, STATE_ESC };
+        int state = STATE_0;
+        char endToken = '\0';
+        std::size_t nameStart = 0;
+
+        for (std::size_t i = 0; i + 1 < N; ++i)
+        {
+          char ch = query[i];
+          _query[i] = ch;
+
+          switch (state)
+          {
+            case STATE_0:
+              if (ch == ':')
+                state = STATE_NAME0;
+              else if (ch == '\\')
+                state = STATE_ESC;
+              else
+              {
+                append(ch);
+                if (ch == '\'' || ch == '"' || ch == '`')
+                {
+                  state = STATE_STRING;
+                  endToken = ch;
+                }
+              }
+              break;
+
+            case STATE_NAME0:
+              if (isNameStart(ch))
+              {
+                nameStart = i;
+                state = STATE_NAME;
+              }
+              else if (ch == ':')
+              {
+                append(':');
+                append(':');
+                state = STATE_0;
+              }
+              else if (ch == '\\')
+              {
+                append(':');
+                state = STATE_ESC;
+              }
+              break;
+
+            case STATE_NAME:
+              if (!isNameChar(ch))
+              {
+                onHostVar(nameStart, i - nameStart);
+                if (ch == '\\')
+                  state = STATE_ESC;
+                else if (ch == ':')
+                  state = STATE_NAME0;
+                else
+                {
+                  append(ch);
+                  state = STATE_0;
+                }
+              }
+              break;
+
+            case STATE_STRING:
+              append(ch);
+              if (ch == endToken)
+                state = STATE_0;
+              else if (ch == '\\')
+                state = STATE_STRING_ESC;
+              break;
+
+            case STATE_STRING_ESC:
+              append(ch);
+              state = (ch == endToken ? STATE_0 : STATE_STRING);
+              break;
+
+            case STATE_ESC:
+              append(ch);
+              state = STATE_0;
+              break;
+          }
+        }
+
+        if (state == STATE_NAME0)
+          append(':');
+        else if (state == STATE_NAME)
+          onHostVar(nameStart, N - 1 - nameStart);
+      }
+
+      /// The query as written
+      const char* query() const                  { return _query; }
+      std::size_t querySize() const              { return N - 1; }
+
+      /// Number of distinct host variables
+      constexpr std::size_t paramCount() const   { return _paramCount; }
+
+      /// Number of placeholders in the rewritten query
+      constexpr std::size_t placeholderCount() const  { return _placeholderCount; }
+
+      /** Returns the index of a host variable in order of first appearance
+
+          When evaluated at compile time, an unknown name is a compile error.
+       */
+      constexpr std::size_t paramIndex(const char* name) const
+      {
+        for (std::size_t n = 0; n < _paramCount; ++n)
+        {
+          std::size_t i = 0;
+          while (i < _nameLength[n] && name[i] == _query[_nameOffset[n] + i])
+            ++i;
+          if (i == _nameLength[n] && name[i] == '\0')
+            return n;
+        }
+
+        throw std::invalid_argument("unknown host variable");
+      }
+
+      /// Name of a host variable
+      std::string paramName(std::size_t n) const
+        { return std::string(_query + _nameOffset[n], _nameLength[n]); }
+
+      /// The query rewritten for a placeholder style
+      std::string sql(ParsedStmt::Style style) const
+      {
+        return style == ParsedStmt::NUMBERED ? std::string(_numbered, _numberedSize)
+                                             : std::string(_questionmark, _questionmarkSize);
+      }
+
+      /// Stores the parse results in the cache of ParsedStmt, if not already there.
+      void registerParsed() const
+      {
+        std::string q(_query, N - 1);
+        ParsedStmt::Style styles[] = { ParsedStmt::NUMBERED, ParsedStmt::QUESTIONMARK };
+        for (ParsedStmt::Style style : styles)
+        {
+          if (ParsedStmt::isCached(q, style))
+            continue;
+
+          ParsedStmt::hostvarMapType hostvarMap;
+          for (std::size_t n = 0; n < _paramCount; ++n)
+            hostvarMap[paramName(n)] = n;
+
+          ParsedStmt::paramsType params(_paramCount);
+          for (std::size_t p = 0; p < _placeholderCount; ++p)
+            params[_placeholderParam[p]].push_back(p);
+
+          ParsedStmt::put(q, style,
+            new ParsedStmt(sql(style), hostvarMap, params, _placeholderCount));
+        }
+      }
+
+      /// The query as written, which is what the drivers are prepared with
+      operator std::string() const
+      {
+        registerParsed();
+        return std::string(_query, N - 1);
+      }
+  };
+
+  /// Returns the name; used by TNTDB_PARAM to force the check at compile time
+  template <std::size_t Idx>
+  constexpr const char* staticSqlParam(const char* name)
+  { return name; }
+}
+
+/// Creates a tntdb::StaticSql from a string literal
+#define TNTDB_SQL(query) ::tntdb::StaticSql<sizeof(query)>(query)
+
+/// The name of a host variable of a StaticSql, checked at compile time
+#define TNTDB_PARAM(sql, name) ::tntdb::staticSqlParam<(sql).paramIndex(name)>(name)
+
+#endif // __cplusplus >= 201402L
+
+#endif // TNTDB_STATICSQL_H
@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TNTDB_STMTCACHESTATISTICS_H
+#define TNTDB_STMTCACHESTATISTICS_H
+
+namespace cxxtools
+{
+  class SerializationInfo;
+}
+
+namespace tntdb
+{
+  /// Snapshot of the state and the counters of the statement cache of a connection
+  struct StmtCacheStatistics
+  {
+    /// maximum number of cached statements; 0 means unlimited
+    unsigned capacity;
+    /// statements currently in the cache
+    unsigned size;
+    /// calls of prepareCached, which found the statement in the cache
+    unsigned long hits;
+    /// calls of prepareCached, which had to prepare the statement
+    unsigned long misses;
+    /// statements removed from the cache since the capacity was exceeded
+    unsigned long evictions;
+
+    StmtCacheStatistics()
+      : capacity(0),
+        size(0),
+        hits(0),
+        misses(0),
+        evictions(0)
+      { }
+  };
+
+  void operator<<= (cxxtools::SerializationInfo& si, const StmtCacheStatistics& statistics);
+}
+
+#endif // TNTDB_STMTCACHESTATISTICS_H
@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#ifndef TNTDB_STRUCTMAP_H
+#define TNTDB_STRUCTMAP_H
+
+#include <tntdb/statement.h>
+#include <tntdb/row.h>
+#include <tntdb/rowvisitor.h>
+#include <tntdb/error.h>
+#include <string>
+#include <vector>
+
+namespace tntdb
+{
+  /** Mapping of the members of a struct to columns and host variables.
+
+      The mapping is defined with the macro TNTDB_MAP, which takes the type
+      followed by the names of its members. The columns and host variables
+      have the same names as the members. The macro must be used in the
+      global namespace.
+
+      Example:
+      @code
+        struct Order
+        {
+          int id;
+          std::string customer;
+          double amount;
+          tntdb::Datetime created;
+        };
+
+        TNTDB_MAP(Order, id, customer, amount, created)
+
+        std::vector<Order> orders;
+        conn.prepare("select id, customer, amount, created from orders")
+            .selectInto(orders);
+
+        conn.prepare("insert into orders (id, customer, amount, created)"
+                     " values (:id, :customer, :amount, :created)")
+            .setStruct(order)
+            .execute();
+      @endcode
+
+      The columns are looked up once per result. Each member is read with
+      Row::getValue, so the conversion is chosen at compile time by the type
+      of the member.
+
+      TNTDB_MAP needs variadic macros and is therefore available with C++11
+      only. With an older compiler StructMap can be specialized by hand like
+      TNTDB_MAP does.
+   */
+  template <typename T>
+  struct StructMap;
+
+  namespace structmap
+  {
+    /// Reads the members from the columns of a row
+    class ColumnReader
+    {
+        const Row& _row;
+        const Row::size_type* _column;
+
+      public:
+        ColumnReader(const Row& row, const Row::size_type* column)
+          : _row(row),
+            _column(column)
+          { }
+
+        template <typename M>
+        void operator() (M& member)
+          { _row.getValue(*_column++, member); }
+    };
+
+    /// Sets the host variables named like the members
+    template <typename T>
+    class ParamWriter
+    {
+        Statement& _stmt;
+        unsigned _n;
+
+      public:
+        explicit ParamWriter(Statement& stmt)
+          : _stmt(stmt),
+            _n(0)
+          { }
+
+        template <typename M>
+        void operator() (const M& member)
+        {
+          const std::string& name = StructMap<T>::name(_n++);
+          Statement::size_type idx = _stmt.findParam(name);
+          if (idx != IStatement::npos)
+            Hostvar(_stmt, name, idx).set(member);
+        }
+    };
+
+    /// Looks up the column of each member; throws FieldNotFound when a column is missing
+    template <typename T>
+    void resolveColumns(const Row& row, std::vector<Row::size_type>& columns)
+    {
+      columns.resize(StructMap<T>::size());
+      for (unsigned n = 0; n < columns.size(); ++n)
+      {
+        columns[n] = row.getColumnIndex(StructMap<T>::name(n));
+        if (columns[n] == IRow::npos)
+          throw FieldNotFound(StructMap<T>::name(n));
+      }
+    }
+
+    /// Reads a row into obj; the columns are resolved, when columns is empty
+    template <typename T>
+    void readRow(const Row& row, T& obj, std::vector<Row::size_type>& columns)
+    {
+      if (columns.empty())
+        resolveColumns<T>(row, columns);
+      ColumnReader reader(row, &columns[0]);
+      StructMap<T>::visit(obj, reader);
+    }
+
+    /// Appends each visited row to a vector
+    template <typename T>
+    class VectorReader : public RowVisitor
+    {
+        std::vector<T>& _ret;
+        std::vector<Row::size_type> _columns;
+
+      public:
+        explicit VectorReader(std::vector<T>& ret)
+          : _ret(ret)
+          { }
+
+        void visit(const Row& row)
+        {
+          _ret.push_back(T());
+          try
+          {
+            readRow(row, _ret.back(), _columns);
+          }
+          catch (...)
+          {
+            _ret.pop_back();
+            throw;
+          }
+        }
+    };
+  }
+
+  template <typename T>
+  Statement::size_type Statement::selectInto(std::vector<T>& ret)
+  {
+    structmap::VectorReader<T> reader(ret);
+    return forEach(reader);
+  }
+
+  template <typename T>
+  Statement& Statement::setStruct(const T& data)
+  {
+    structmap::ParamWriter<T> writer(*this);
+    StructMap<T>::visit(data, writer);
+    return *this;
+  }
+
+  template <typename T>
+  bool Statement::const_iterator::fetchInto(T& obj)
+  {
+    if (!cursor)
+      return false;
+    structmap::readRow(current, obj, structColumns);
+    operator++();
+    return true;
+  }
+}
+
+#if __cplusplus >= 201103L
+
+#define TNTDB_MAP(Type, ...) \
+  namespace tntdb \
+  { \
+    template <> \
+    struct StructMap<Type> \
+    { \
+      static unsigned size() \
+        { return TNTDB_MAP_COUNT(__VA_ARGS__); } \
+      static const std::string& name(unsigned n) \
+      { \
+        static const std::string names[] = { TNTDB_MAP_EACH(TNTDB_MAP_NAME, __VA_ARGS__) }; \
+        return names[n]; \
+      } \
+      template <typename Obj, typename Visitor> \
+      static void visit(Obj& obj, Visitor& visitor) \
+        { TNTDB_MAP_EACH(TNTDB_MAP_VISIT, __VA_ARGS__) } \
+    }; \
+  }
+
+/// @cond internal
+#define TNTDB_MAP_NAME(member) #member,
+#define TNTDB_MAP_VISIT(member) visitor(obj.member);
+
+#define TNTDB_MAP_CAT(a, b) TNTDB_MAP_CAT_(a, b)
+#define TNTDB_MAP_CAT_(a, b) a ## b
+
+// counts up to 24 arguments
+#define TNTDB_MAP_COUNT(...) TNTDB_MAP_COUNT_(__VA_ARGS__, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+#define TNTDB_MAP_COUNT_(_1, _2, _3, _4, _5, _6, _7, _8, _9, _10, _11, _12, _13, _14, _15, _16, _17, _18, _19, _20, _21, _22, _23, _24, n, ...) n
+
+#define TNTDB_MAP_EACH(F, ...) TNTDB_MAP_CAT(TNTDB_MAP_EACH_, TNTDB_MAP_COUNT(__VA_ARGS__))(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_1(F, m) F(m)
+#define TNTDB_MAP_EACH_2(F, m, ...) F(m) TNTDB_MAP_EACH_1(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_3(F, m, ...) F(m) TNTDB_MAP_EACH_2(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_4(F, m, ...) F(m) TNTDB_MAP_EACH_3(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_5(F, m, ...) F(m) TNTDB_MAP_EACH_4(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_6(F, m, ...) F(m) TNTDB_MAP_EACH_5(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_7(F, m, ...) F(m) TNTDB_MAP_EACH_6(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_8(F, m, ...) F(m) TNTDB_MAP_EACH_7(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_9(F, m, ...) F(m) TNTDB_MAP_EACH_8(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_10(F, m, ...) F(m) TNTDB_MAP_EACH_9(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_11(F, m, ...) F(m) TNTDB_MAP_EACH_10(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_12(F, m, ...) F(m) TNTDB_MAP_EACH_11(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_13(F, m, ...) F(m) TNTDB_MAP_EACH_12(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_14(F, m, ...) F(m) TNTDB_MAP_EACH_13(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_15(F, m, ...) F(m) TNTDB_MAP_EACH_14(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_16(F, m, ...) F(m) TNTDB_MAP_EACH_15(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_17(F, m, ...) F(m) TNTDB_MAP_EACH_16(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_18(F, m, ...) F(m) TNTDB_MAP_EACH_17(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_19(F, m, ...) F(m) TNTDB_MAP_EACH_18(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_20(F, m, ...) F(m) TNTDB_MAP_EACH_19(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_21(F, m, ...) F(m) TNTDB_MAP_EACH_20(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_22(F, m, ...) F(m) TNTDB_MAP_EACH_21(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_23(F, m, ...) F(m) TNTDB_MAP_EACH_22(F, __VA_ARGS__)
+#define TNTDB_MAP_EACH_24(F, m, ...) F(m) TNTDB_MAP_EACH_23(F, __VA_ARGS__)
+/// @endcond
+
+#endif // __cplusplus >= 201103L
+
+#endif // TNTDB_STRUCTMAP_H
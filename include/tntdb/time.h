@@ -97,12 +97,25 @@ namespace tntdb
       /// Get the time in ISO format (hh:mm:ss.hhh)
       std::string getIso() const;
 
+      /// Number of characters written by getIso(char*)
+      static const unsigned isoLength = 12;
+
+      /** Write the time in ISO format into buf and return the number of characters written.
+
+          The buffer must have room for isoLength characters. No terminating
+          zero is written.
+       */
+      unsigned getIso(char* buf) const;
+
       /** Construct a Time object from the given ISO date string
 
           If the string is not in ISO format, an exception of type tntdb::TypeError is thrown.
        */
       static Time fromIso(const std::string& s);
 
+      /// Construct a Time object from the ISO string at s with len characters
+      static Time fromIso(const char* s, unsigned len);
+
       bool operator== (const Time& dt) const
       {
         return _hour == dt._hour
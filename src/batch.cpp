@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <tntdb/batch.h>
+#include <cxxtools/log.h>
+
+log_define("tntdb.batch")
+
+namespace tntdb
+{
+  Batch::Cell& Batch::cell(size_type col)
+  {
+    std::vector<Cell>& cells = _columns[col].cells;
+    if (cells.size() <= _rows)
+      cells.resize(_rows + 1);
+    return cells[_rows];
+  }
+
+  const Batch::Cell* Batch::cell(size_type col, size_type row) const
+  {
+    const std::vector<Cell>& cells = _columns[col].cells;
+    return row < cells.size() ? &cells[row] : 0;
+  }
+
+  Batch::size_type Batch::column(const std::string& name)
+  {
+    ColumnMapType::const_iterator it = _columnMap.find(name);
+    if (it != _columnMap.end())
+      return it->second;
+
+    size_type col = _columns.size();
+    _columns.push_back(Column());
+    _columns.back().name = name;
+    _columnMap.insert(ColumnMapType::value_type(name, col));
+    return col;
+  }
+
+  void Batch::clear()
+  {
+    _columns.clear();
+    _columnMap.clear();
+    _rows = 0;
+    _strings.clear();
+    _decimals.clear();
+    _blobs.clear();
+    _dates.clear();
+    _times.clear();
+    _datetimes.clear();
+  }
+
+  Batch& Batch::setBool(size_type col, bool data)
+  {
+    Cell& c = cell(col);
+    c.type = BOOL;
+    c.value.b = data;
+    return *this;
+  }
+
+  Batch& Batch::setInt64(size_type col, int64_t data)
+  {
+    Cell& c = cell(col);
+    c.type = INT64;
+    c.value.i = data;
+    return *this;
+  }
+
+  Batch& Batch::setUnsigned64(size_type col, uint64_t data)
+  {
+    Cell& c = cell(col);
+    c.type = UNSIGNED64;
+    c.value.u = data;
+    return *this;
+  }
+
+  Batch& Batch::setDouble(size_type col, double data)
+  {
+    Cell& c = cell(col);
+    c.type = DOUBLE;
+    c.value.d = data;
+    return *this;
+  }
+
+  Batch& Batch::setString(size_type col, const std::string& data)
+  {
+    Cell& c = cell(col);
+    c.type = STRING;
+    c.value.ref = _strings.size();
+    _strings.push_back(data);
+    return *this;
+  }
+
+  Batch& Batch::setDecimal(size_type col, const Decimal& data)
+  {
+    Cell& c = cell(col);
+    c.type = DECIMAL;
+    c.value.ref = _decimals.size();
+    _decimals.push_back(data);
+    return *this;
+  }
+
+  Batch& Batch::setBlob(size_type col, const Blob& data)
+  {
+    Cell& c = cell(col);
+    c.type = BLOB;
+    c.value.ref = _blobs.size();
+    _blobs.push_back(data);
+    return *this;
+  }
+
+  Batch& Batch::setDate(size_type col, const Date& data)
+  {
+    if (data.isNull())
+      return setNull(col);
+
+    Cell& c = cell(col);
+    c.type = DATE;
+    c.value.ref = _dates.size();
+    _dates.push_back(data);
+    return *this;
+  }
+
+  Batch& Batch::setTime(size_type col, const Time& data)
+  {
+    if (data.isNull())
+      return setNull(col);
+
+    Cell& c = cell(col);
+    c.type = TIME;
+    c.value.ref = _times.size();
+    _times.push_back(data);
+    return *this;
+  }
+
+  Batch& Batch::setDatetime(size_type col, const Datetime& data)
+  {
+    if (data.isNull())
+      return setNull(col);
+
+    Cell& c = cell(col);
+    c.type = DATETIME;
+    c.value.ref = _datetimes.size();
+    _datetimes.push_back(data);
+    return *this;
+  }
+
+  void Batch::paramIndexes(IStatement& stmt, std::vector<IStatement::size_type>& idx) const
+  {
+    idx.resize(_columns.size());
+    for (size_type col = 0; col < _columns.size(); ++col)
+      idx[col] = stmt.paramIndex(_columns[col].name);
+  }
+
+  void Batch::bindRow(IStatement& stmt, const std::vector<IStatement::size_type>& idx,
+    size_type row) const
+  {
+    for (size_type col = 0; col < _columns.size(); ++col)
+    {
+      switch (getType(col, row))
+      {
+        case NULLVALUE:  stmt.setNull(idx[col]); break;
+        case BOOL:       stmt.setBool(idx[col], getBool(col, row)); break;
+        case INT64:      stmt.setInt64(idx[col], getInt64(col, row)); break;
+        case UNSIGNED64: stmt.setUnsigned64(idx[col], getUnsigned64(col, row)); break;
+        case DOUBLE:     stmt.setDouble(idx[col], getDouble(col, row)); break;
+        case STRING:     stmt.setString(idx[col], getString(col, row)); break;
+        case DECIMAL:    stmt.setDecimal(idx[col], getDecimal(col, row)); break;
+        case BLOB:       stmt.setBlob(idx[col], getBlob(col, row)); break;
+        case DATE:       stmt.setDate(idx[col], getDate(col, row)); break;
+        case TIME:       stmt.setTime(idx[col], getTime(col, row)); break;
+        case DATETIME:   stmt.setDatetime(idx[col], getDatetime(col, row)); break;
+      }
+    }
+  }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <tntdb/columnarresult.h>
+#include <stdexcept>
+
+namespace tntdb
+{
+  ColumnarResult::ColumnarResult(const Result& result)
+    : _result(result),
+      _columns(!result ? 0 : result.getFieldCount())
+  { }
+
+  ColumnarResult::Column& ColumnarResult::column(size_type field_num) const
+  {
+    if (field_num >= _columns.size())
+      throw std::out_of_range("column index out of range in ColumnarResult");
+    return _columns[field_num];
+  }
+
+  const std::vector<int64_t>& ColumnarResult::getInt64Column(size_type field_num) const
+  {
+    Column& c = column(field_num);
+    if (!(c.decoded & Column::INT64))
+    {
+      _result.getColumn(field_num, c.int64Values, c.nulls);
+      c.decoded |= Column::INT64;
+    }
+
+    return c.int64Values;
+  }
+
+  const std::vector<double>& ColumnarResult::getDoubleColumn(size_type field_num) const
+  {
+    Column& c = column(field_num);
+    if (!(c.decoded & Column::DOUBLE))
+    {
+      _result.getColumn(field_num, c.doubleValues, c.nulls);
+      c.decoded |= Column::DOUBLE;
+    }
+
+    return c.doubleValues;
+  }
+
+  const std::vector<std::string>& ColumnarResult::getStringColumn(size_type field_num) const
+  {
+    Column& c = column(field_num);
+    if (!(c.decoded & Column::STRING))
+    {
+      _result.getColumn(field_num, c.stringValues, c.nulls);
+      c.decoded |= Column::STRING;
+    }
+
+    return c.stringValues;
+  }
+
+  const std::vector<bool>& ColumnarResult::getNulls(size_type field_num) const
+  {
+    Column& c = column(field_num);
+    if (c.decoded == 0)
+      getStringColumn(field_num);  // strings can be decoded from every type
+    return c.nulls;
+  }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/impl/columndescriptor.h>
+#include <tntdb/error.h>
+
+namespace tntdb
+{
+  const ColumnDescriptor::size_type ColumnDescriptor::npos;
+
+  void ColumnDescriptor::add(const std::string& name, const std::string& type)
+  {
+    _index.insert(IndexType::value_type(name, _columns.size()));
+    _columns.push_back(Column(name, type));
+  }
+
+  ColumnDescriptor::size_type ColumnDescriptor::find(const std::string& field_name) const
+  {
+    IndexType::const_iterator it = _index.find(field_name);
+    return it == _index.end() ? npos : it->second;
+  }
+
+  ColumnDescriptor::size_type ColumnDescriptor::getIndex(const std::string& field_name) const
+  {
+    IndexType::const_iterator it = _index.find(field_name);
+    if (it == _index.end())
+      throw FieldNotFound(field_name);
+    return it->second;
+  }
+}
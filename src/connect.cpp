@@ -83,6 +83,12 @@ namespace tntdb
     return connectionPools.connect(url);
   }
 
+  Connection connectCached(const std::string& url, long msecs)
+  {
+    log_debug("connectCached(\"" << url << "\", " << msecs << ')');
+    return connectionPools.connect(url, msecs);
+  }
+
   void dropCached(unsigned keep)
   {
     connectionPools.drop(keep);
@@ -102,4 +108,116 @@ namespace tntdb
   {
     return connectionPools.getMaximumSize();
   }
+
+  void setPoolTimeout(long msecs)
+  {
+    connectionPools.setTimeout(msecs);
+  }
+
+  long getPoolTimeout()
+  {
+    return connectionPools.getTimeout();
+  }
+
+  void setPoolMaxWaiters(unsigned n)
+  {
+    connectionPools.setMaximumWaiters(n);
+  }
+
+  unsigned getPoolMaxWaiters()
+  {
+    return connectionPools.getMaximumWaiters();
+  }
+
+  PoolStatistics getPoolStatistics(const std::string& url)
+  {
+    return connectionPools.getStatistics(url);
+  }
+
+  void setPoolThreadCache(bool enable)
+  {
+    connectionPools.setThreadCache(enable);
+  }
+
+  void setPoolMaxLifetime(unsigned msecs)
+  {
+    connectionPools.setMaxLifetime(msecs);
+  }
+
+  void setPoolIdleTimeout(unsigned msecs)
+  {
+    connectionPools.setIdleTimeout(msecs);
+  }
+
+  void startPoolMaintainer(unsigned intervalMsecs)
+  {
+    connectionPools.startMaintainer(intervalMsecs);
+  }
+
+  void stopPoolMaintainer()
+  {
+    connectionPools.stopMaintainer();
+  }
+
+  void setPoolValidationIdleTime(unsigned msecs)
+  {
+    connectionPools.setValidationIdleTime(msecs);
+  }
+
+  unsigned getPoolValidationIdleTime()
+  {
+    return connectionPools.getValidationIdleTime();
+  }
+
+  void setPoolMinIdle(unsigned n)
+  {
+    connectionPools.setMinIdle(n);
+  }
+
+  unsigned getPoolMinIdle()
+  {
+    return connectionPools.getMinIdle();
+  }
+
+  void warmUpCached(const std::string& url, unsigned threads, bool wait)
+  {
+    log_debug("warmUpCached(\"" << url << "\", " << threads << ')');
+    connectionPools.warmUp(url, threads, wait);
+  }
+
+  void registerCachedStatement(const std::string& url, const std::string& key,
+    const std::string& query)
+  {
+    connectionPools.registerStatement(url, key, query);
+  }
+
+  bool unregisterCachedStatement(const std::string& url, const std::string& key)
+  {
+    return connectionPools.unregisterStatement(url, key);
+  }
+
+  void setPoolPrepareInBackground(bool sw)
+  {
+    connectionPools.setPrepareInBackground(sw);
+  }
+
+  void setPoolRecordStatements(bool sw)
+  {
+    connectionPools.setRecordStatements(sw);
+  }
+
+  void setPoolMaxStatements(unsigned n)
+  {
+    connectionPools.setMaxStatements(n);
+  }
+
+  void dumpCachedStatements(const std::string& url, std::ostream& out)
+  {
+    connectionPools.dumpStatements(url, out);
+  }
+
+  void loadCachedStatements(const std::string& url, std::istream& in)
+  {
+    connectionPools.loadStatements(url, in);
+  }
 }
@@ -31,6 +31,7 @@
 #include <tntdb/row.h>
 #include <tntdb/value.h>
 #include <tntdb/statement.h>
+#include <tntdb/impl/stmtcache.h>
 #include <cxxtools/log.h>
 
 log_define("tntdb.connection")
@@ -90,7 +91,7 @@ namespace tntdb
   {
     log_trace("Connection::prepare(\"" << query << "\")");
 
-    return _conn->prepare(query);
+    return _conn->prepareShared(query);
   }
 
   Statement Connection::prepareCached(const std::string& query, const std::string& key)
@@ -100,23 +101,33 @@ namespace tntdb
     return _conn->prepareCached(query, key);
   }
 
+  IStmtCacheConnection::IStmtCacheConnection()
+    : stmtCache(new StmtCache()),
+      statementCaching(false)
+  { }
+
+  IStmtCacheConnection::~IStmtCacheConnection()
+  {
+    delete stmtCache;
+  }
+
   Statement IStmtCacheConnection::prepareCached(const std::string& query, const std::string& key)
   {
     log_trace("IStmtCacheConnection::prepare(\"" << query << ", " << key << "\")");
 
-    stmtCacheType::iterator it = stmtCache.find(key);
-    if (it == stmtCache.end())
+    IStatement* cached = stmtCache->get(key);
+    if (cached == 0)
     {
       log_debug("statement for query \"" << key << "\" not found in cache");
       Statement stmt = prepare(query);
       IStatement* istmt = const_cast<IStatement*>(stmt.getImpl());
-      stmtCache.insert(stmtCacheType::value_type(key, istmt));
+      stmtCache->put(key, istmt);
       return stmt;
     }
     else
     {
       log_debug("statement for query \"" << key << "\" fetched from cache");
-      return Statement(it->second.getPointer());
+      return Statement(cached);
     }
   }
 
@@ -124,20 +135,104 @@ namespace tntdb
   {
     log_trace("IStmtCacheConnection::clearStatementCache()");
 
-    stmtCache.clear();
+    stmtCache->clear();
   }
 
   bool IStmtCacheConnection::clearStatementCache(const std::string& key)
   {
     log_trace("IStmtCacheConnection::clearStatementCache(\"" << key << "\")");
 
-    stmtCacheType::iterator it = stmtCache.find(key);
-    if (it != stmtCache.end())
-      return  false;
+    if (!stmtCache->erase(key))
+      return false;
+
+    log_debug("removed statement for query \"" << key << "\" from cache");
+    return true;
+  }
+
+  Statement IStmtCacheConnection::prepareShared(const std::string& query)
+  {
+    if (!statementCaching)
+      return prepare(query);
+
+    log_trace("IStmtCacheConnection::prepareShared(\"" << query << "\")");
+
+    bool found;
+    IStatement* cached = stmtCache->getIdle(query, found);
+    if (cached)
+    {
+      log_debug("statement for query \"" << query << "\" fetched from cache");
+      cached->clear();
+      return Statement(cached);
+    }
+
+    Statement stmt = prepare(query);
+    if (found)
+    {
+      // the cached statement is in use, so we return an independent one
+      log_debug("statement for query \"" << query << "\" busy; use a new one");
+    }
+    else
+    {
+      log_debug("statement for query \"" << query << "\" not found in cache");
+      stmtCache->put(query, const_cast<IStatement*>(stmt.getImpl()));
+    }
+
+    return stmt;
+  }
+
+  void IStmtCacheConnection::setStatementCaching(bool sw)
+  {
+    log_debug("statement caching " << (sw ? "enabled" : "disabled"));
+    statementCaching = sw;
+  }
+
+  bool IStmtCacheConnection::getStatementCaching()
+  {
+    return statementCaching;
+  }
+
+  void IStmtCacheConnection::setStatementCacheCapacity(unsigned capacity)
+  {
+    log_debug("set statement cache capacity to " << capacity);
+    stmtCache->setCapacity(capacity);
+  }
+
+  StmtCacheStatistics IStmtCacheConnection::getStatementCacheStatistics()
+  {
+    return stmtCache->getStatistics();
+  }
+
+  Statement IConnection::prepareShared(const std::string& query)
+  {
+    return prepare(query);
+  }
+
+  void IConnection::setStatementCaching(bool)
+  {
+  }
+
+  bool IConnection::getStatementCaching()
+  {
+    return false;
+  }
 
-    log_debug("remove statement for query \"" << key << "\" from cache");
-    stmtCache.erase(it);
+  void IConnection::setStatementCacheCapacity(unsigned)
+  {
+  }
+
+  StmtCacheStatistics IConnection::getStatementCacheStatistics()
+  {
+    return StmtCacheStatistics();
+  }
+
+  bool IConnection::isAlive()
+  {
     return true;
   }
+
+  bool IConnection::reset()
+  {
+    return false;
+  }
 }
 
@@ -29,77 +29,1263 @@
 #include <tntdb/connectionpool.h>
 #include <tntdb/connect.h>
 #include <tntdb/impl/poolconnection.h>
+#include <tntdb/error.h>
+#include <tntdb/statement.h>
+#include <tntdb/iface/istatement.h>
+#include <cxxtools/clock.h>
+#include <cxxtools/thread.h>
 #include <cxxtools/log.h>
+#include <algorithm>
+#include <istream>
+#include <ostream>
+#include <set>
+#include <pthread.h>
 
 log_define("tntdb.connectionpool")
 
 namespace tntdb
 {
   ////////////////////////////////////////////////////////////////////////
-  // Connector
+  // ConnectionPool::Entry
   //
-  Connection* ConnectionPool::Connector::operator() ()
+  ConnectionPool::Entry::Entry(const Connection& connection_)
+    : connection(connection_),
+      created(cxxtools::Clock::getSystemTicks()),
+      lastUsed(created),
+      lastValidated(created)
+  { }
+
+  ////////////////////////////////////////////////////////////////////////
+  // ConnectionPool::ThreadCache
+  //
+  // Each thread has a slot per pool, which holds at most one connection.
+  // The owning thread parks and takes the connection without locking the
+  // pool. Other threads may steal it while holding the mutex of the pool.
+  // The state of a slot is switched atomically, so that only one thread
+  // accesses the entry at a time.
+  struct ConnectionPool::ThreadCache
+  {
+    struct Slot
+    {
+      enum { Empty, Full, Busy };
+
+      ConnectionPool* pool;
+      Entry entry;
+      volatile cxxtools::atomic_t state;
+
+      explicit Slot(ConnectionPool* pool_)
+        : pool(pool_),
+          state(Empty)
+        { }
+
+      bool park(const Entry& e)
+      {
+        if (cxxtools::atomicCompareExchange(state, Busy, Empty) != Empty)
+          return false;
+        entry = e;
+        cxxtools::atomicExchange(state, Full);
+        return true;
+      }
+
+      bool take(Entry& e)
+      {
+        if (cxxtools::atomicCompareExchange(state, Busy, Full) != Full)
+          return false;
+        e = entry;
+        entry = Entry();
+        cxxtools::atomicExchange(state, Empty);
+        return true;
+      }
+    };
+
+    typedef std::set<Slot*> SlotsType;
+
+    pthread_key_t key;
+    bool hasKey;       // false, when the process ran out of thread specific keys
+    SlotsType slots;   // protected by the mutex of the pool
+
+    ThreadCache()
+      : hasKey(pthread_key_create(&key, &ConnectionPool::releaseThreadSlot) == 0)
+      { }
+
+    ~ThreadCache()
+    {
+      if (hasKey)
+        pthread_key_delete(key);
+      for (SlotsType::iterator it = slots.begin(); it != slots.end(); ++it)
+        delete *it;
+    }
+  };
+
+  namespace
+  {
+    class AtomicCount
+    {
+        volatile cxxtools::atomic_t& count;
+
+      public:
+        explicit AtomicCount(volatile cxxtools::atomic_t& count_)
+          : count(count_)
+          { cxxtools::atomicIncrement(count); }
+        ~AtomicCount()
+          { cxxtools::atomicDecrement(count); }
+    };
+
+    void escapeStatementField(std::ostream& out, const std::string& s)
+    {
+      for (std::string::const_iterator it = s.begin(); it != s.end(); ++it)
+      {
+        switch (*it)
+        {
+          case '\\': out << "\\\\"; break;
+          case '\t': out << "\\t"; break;
+          case '\n': out << "\\n"; break;
+          case '\r': out << "\\r"; break;
+          default: out << *it;
+        }
+      }
+    }
+
+    std::string unescapeStatementField(const std::string& s)
+    {
+      std::string ret;
+      ret.reserve(s.size());
+      for (std::string::const_iterator it = s.begin(); it != s.end(); ++it)
+      {
+        if (*it != '\\' || it + 1 == s.end())
+        {
+          ret += *it;
+          continue;
+        }
+
+        switch (*++it)
+        {
+          case 't': ret += '\t'; break;
+          case 'n': ret += '\n'; break;
+          case 'r': ret += '\r'; break;
+          default: ret += *it;
+        }
+      }
+
+      return ret;
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////
+  // ConnectionPool
+  //
+  ConnectionPool::ConnectionPool(const std::string& url_, unsigned maxcount_,
+      unsigned minIdle_)
+    : url(url_),
+      maxcount(maxcount_),
+      currentSize(0),
+      validationIdleTime(defaultValidationIdleTime * 1000),
+      minIdle(minIdle_),
+      connecting(0),
+      validating(0),
+      runningWarmUpThreads(0),
+      maxWaiters(0),
+      timeout(-1),
+      waitCount(0),
+      timeoutCount(0),
+      rejectCount(0),
+      createdCount(0),
+      droppedDeadCount(0),
+      threadCache(0),
+      useThreadCache(0),
+      waitingCount(0),
+      maxStatements(defaultMaxStatements),
+      prepareInBackground(false),
+      statementCaching(false),
+      recordStatements(0),
+      users(0)
+  {
+    if (minIdle > 0)
+      warmUp();
+  }
+
+  ConnectionPool::~ConnectionPool()
+  {
+    joinWarmUpThreads();
+    delete threadCache;
+  }
+
+  ConnectionPool::Entry ConnectionPool::create(bool background)
+  {
+    log_debug("create new connection for url \"" << url << '"');
+    Entry entry(tntdb::connect(url));
+
+    bool prepare;
+    bool caching;
+
+    {
+      cxxtools::MutexLock lock(mutex);
+      ++createdCount;
+      prepare = !statements.empty() && (background || !prepareInBackground);
+      caching = statementCaching;
+    }
+
+    if (caching)
+      entry.connection.setStatementCaching(true);
+
+    if (prepare)
+      prepareStatements(entry.connection);
+
+    return entry;
+  }
+
+  void ConnectionPool::prepareStatements(Connection& conn)
+  {
+    StatementsType s = getStatements();
+
+    log_debug("prepare " << s.size() << " statements for url \"" << url << '"');
+
+    for (StatementsType::const_iterator it = s.begin(); it != s.end(); ++it)
+    {
+      try
+      {
+        Statement stmt = conn.prepareCached(it->second, it->first);
+        stmt.getImpl()->prepare();
+      }
+      catch (const std::exception& e)
+      {
+        // the statement is prepared again on first use
+        log_warn("preparing statement \"" << it->first << "\" for url \"" << url << "\" failed: " << e.what());
+      }
+    }
+  }
+
+  void ConnectionPool::recordStatement(const std::string& key, const std::string& query)
+  {
+    if (cxxtools::atomicGet(recordStatements) == 0)
+      return;
+
+    cxxtools::MutexLock lock(mutex);
+    putStatement(key, query);
+  }
+
+  // Registers the statement as the most recently used one and evicts the
+  // least recently used ones above the maximum. The mutex must be locked by
+  // the caller.
+  void ConnectionPool::putStatement(const std::string& key, const std::string& query)
+  {
+    RegistryType::iterator it = statements.find(key);
+    if (it != statements.end())
+    {
+      it->second.query = query;
+      statementOrder.splice(statementOrder.begin(), statementOrder, it->second.order);
+      return;
+    }
+
+    statementOrder.push_front(key);
+    RegisteredStatement& r = statements[key];
+    r.query = query;
+    r.order = statementOrder.begin();
+
+    while (maxStatements > 0 && statements.size() > maxStatements)
+    {
+      log_debug("evict statement \"" << statementOrder.back() << "\" from registry of url \"" << url << '"');
+      statements.erase(statementOrder.back());
+      statementOrder.pop_back();
+    }
+  }
+
+  void ConnectionPool::warmUpConnections()
+  {
+    while (true)
+    {
+      {
+        cxxtools::MutexLock lock(mutex);
+        if (idle.size() + connecting >= minIdle
+          || (maxcount > 0 && currentSize >= maxcount))
+          return;
+        ++connecting;
+        ++currentSize;
+      }
+
+      try
+      {
+        Entry entry = create(true);
+
+        {
+          cxxtools::MutexLock lock(mutex);
+          --connecting;
+        }
+
+        put(entry);
+      }
+      catch (const std::exception& e)
+      {
+        log_warn("warm up of pool for url \"" << url << "\" failed: " << e.what());
+        cxxtools::MutexLock lock(mutex);
+        --connecting;
+        --currentSize;
+        serveWaiters();
+        return;
+      }
+    }
+  }
+
+  void ConnectionPool::runWarmUpThread()
+  {
+    warmUpConnections();
+
+    cxxtools::MutexLock lock(mutex);
+    --runningWarmUpThreads;
+  }
+
+  // Without wait the threads are only joined, when all of them have
+  // finished, so that a caller never blocks on a running warm up.
+  void ConnectionPool::joinWarmUpThreads(bool wait)
+  {
+    std::vector<cxxtools::AttachedThread*> threads;
+
+    {
+      cxxtools::MutexLock lock(mutex);
+      if (!wait && runningWarmUpThreads > 0)
+        return;
+      threads.swap(warmUpThreads);
+    }
+
+    // the destructor of an attached thread joins it
+    for (unsigned n = 0; n < threads.size(); ++n)
+      delete threads[n];
+  }
+
+  void ConnectionPool::warmUp(unsigned threads, bool wait)
+  {
+    // release the threads of a previous warm up, when they are done
+    joinWarmUpThreads(false);
+
+    {
+      cxxtools::MutexLock lock(mutex);
+      unsigned missing = minIdle > idle.size() ? minIdle - idle.size() : 0;
+      if (threads > missing)
+        threads = missing;
+
+      log_debug("warm up pool for url \"" << url << "\"; " << missing << " connections missing; start " << threads << " threads");
+
+      for (unsigned n = 0; n < threads; ++n)
+      {
+        cxxtools::AttachedThread* thread = new cxxtools::AttachedThread(
+          cxxtools::callable(*this, &ConnectionPool::runWarmUpThread));
+        warmUpThreads.push_back(thread);
+        thread->start();
+        // the thread decrements the counter under the mutex held here
+        ++runningWarmUpThreads;
+      }
+    }
+
+    if (wait)
+      joinWarmUpThreads();
+  }
+
+  bool ConnectionPool::validate(Entry& entry)
+  {
+    cxxtools::Timespan now = cxxtools::Clock::getSystemTicks();
+    cxxtools::Timespan idleTime = now - std::max(entry.lastUsed, entry.lastValidated);
+    if (idleTime > validationIdleTime)
+    {
+      log_debug("connection idle for " << idleTime.totalMSecs() << " ms; ping");
+      if (!entry.connection.ping())
+        return false;
+      entry.lastValidated = now;
+      return true;
+    }
+
+    return entry.connection.getImpl()->isAlive();
+  }
+
+  void ConnectionPool::put(Entry& entry)
+  {
+    entry.lastUsed = cxxtools::Clock::getSystemTicks();
+
+    cxxtools::MutexLock lock(mutex);
+    handOver(entry);
+  }
+
+  // Passes the connection to the longest waiting caller or puts it into
+  // the pool. The mutex must be locked by the caller.
+  void ConnectionPool::handOver(Entry& entry)
+  {
+    if (waiters.empty())
+    {
+      idle.push_back(entry);
+      return;
+    }
+
+    Waiter* waiter = waiters.front();
+    waiters.pop_front();
+    waiter->entry = entry;
+    waiter->served = true;
+    waiter->cond.signal();
+  }
+
+  void ConnectionPool::discard(Entry& entry)
+  {
+    {
+      cxxtools::MutexLock lock(mutex);
+      --currentSize;
+      serveWaiters();
+    }
+
+    entry.connection = Connection();
+  }
+
+  void ConnectionPool::release(Entry& entry, bool reuse)
+  {
+    cxxtools::Timespan now = cxxtools::Clock::getSystemTicks();
+
+    {
+      cxxtools::MutexLock lock(mutex);
+      holdTime.add(now - entry.checkedOut);
+
+      if (reuse && maxLifetime > cxxtools::Timespan(0) && now - entry.created > maxLifetime)
+      {
+        log_debug("connection reached maximum lifetime");
+        reuse = false;
+      }
+    }
+
+    if (!reuse)
+      discard(entry);
+    else if (!parkInThreadCache(entry))
+      put(entry);
+  }
+
+  void ConnectionPool::releaseThreadSlot(void* p)
+  {
+    // called at thread exit
+    ThreadCache::Slot* slot = static_cast<ThreadCache::Slot*>(p);
+    ConnectionPool* pool = slot->pool;
+
+    Entry entry;
+    bool full = slot->take(entry);
+
+    {
+      cxxtools::MutexLock lock(pool->mutex);
+      pool->threadCache->slots.erase(slot);
+    }
+
+    delete slot;
+
+    if (full)
+      pool->put(entry);
+  }
+
+  bool ConnectionPool::parkInThreadCache(Entry& entry)
+  {
+    if (!cxxtools::atomicGet(useThreadCache))
+      return false;
+
+    ThreadCache::Slot* slot = static_cast<ThreadCache::Slot*>(pthread_getspecific(threadCache->key));
+    if (slot == 0)
+    {
+      slot = new ThreadCache::Slot(this);
+
+      {
+        cxxtools::MutexLock lock(mutex);
+        threadCache->slots.insert(slot);
+      }
+
+      pthread_setspecific(threadCache->key, slot);
+    }
+
+    entry.lastUsed = cxxtools::Clock::getSystemTicks();
+    if (!slot->park(entry))
+      return false;
+
+    // A caller, which started waiting meanwhile, may have missed the parked
+    // connection. It is passed to the shared pool then.
+    if (cxxtools::atomicGet(waitingCount) > 0 && slot->take(entry))
+      return false;
+
+    return true;
+  }
+
+  bool ConnectionPool::takeFromThreadCache(Entry& entry)
+  {
+    if (!cxxtools::atomicGet(useThreadCache))
+      return false;
+
+    ThreadCache::Slot* slot = static_cast<ThreadCache::Slot*>(pthread_getspecific(threadCache->key));
+    return slot && slot->take(entry);
+  }
+
+  // The mutex must be locked by the caller.
+  bool ConnectionPool::stealFromThreadCaches(Entry& entry)
+  {
+    if (threadCache == 0)
+      return false;
+
+    for (ThreadCache::SlotsType::iterator it = threadCache->slots.begin();
+        it != threadCache->slots.end(); ++it)
+    {
+      if ((*it)->take(entry))
+      {
+        log_debug("take over connection from thread cache");
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  // Moves the connections of the thread caches to the shared pool. The
+  // mutex must be locked by the caller.
+  void ConnectionPool::drainThreadCaches()
+  {
+    Entry entry;
+    while (stealFromThreadCaches(entry))
+      idle.push_front(entry);
+  }
+
+  void ConnectionPool::droppedDead()
+  {
+    cxxtools::MutexLock lock(mutex);
+    ++droppedDeadCount;
+  }
+
+  Connection ConnectionPool::checkedOut(const Connection& conn, const cxxtools::Timespan& start)
+  {
+    cxxtools::MutexLock lock(mutex);
+    checkoutWait.add(cxxtools::Clock::getSystemTicks() - start);
+    return conn;
+  }
+
+  // Passes free slots to waiting callers, which then create a new
+  // connection themselves. The mutex must be locked by the caller.
+  void ConnectionPool::serveWaiters()
+  {
+    while (!waiters.empty() && (maxcount == 0 || currentSize < maxcount))
+    {
+      Waiter* waiter = waiters.front();
+      waiters.pop_front();
+      ++currentSize;
+      waiter->served = true;
+      waiter->cond.signal();
+    }
+  }
+
+  Connection ConnectionPool::connect()
+  {
+    long t;
+
+    {
+      cxxtools::MutexLock lock(mutex);
+      t = timeout;
+    }
+
+    return connect(t);
+  }
+
+  Connection ConnectionPool::connect(long msecs)
+  {
+    log_debug("ConnectionPool::connect(" << msecs << ')');
+
+    cxxtools::Timespan start = cxxtools::Clock::getSystemTicks();
+    cxxtools::Timespan deadline;
+    if (msecs > 0)
+      deadline = start + cxxtools::Timespan(static_cast<int64_t>(msecs) * 1000);
+
+    while (true)
+    {
+      Entry entry;
+
+      if (!takeFromThreadCache(entry))
+      {
+        cxxtools::MutexLock lock(mutex);
+        log_debug("current pool-size " << idle.size() << " total " << currentSize << " waiting " << waiters.size());
+
+        if (waiters.empty() && idle.empty() && stealFromThreadCaches(entry))
+          ;
+        else if (!waiters.empty() || (idle.empty() && maxcount > 0 && currentSize >= maxcount))
+        {
+          if (maxWaiters > 0 && waiters.size() >= maxWaiters)
+          {
+            ++rejectCount;
+            log_warn("too many callers waiting for a connection to \"" << url << '"');
+            throw PoolExhausted(url);
+          }
+
+          AtomicCount waiting(waitingCount);
+          Waiter waiter;
+          waiters.push_back(&waiter);
+          ++waitCount;
+
+          // connections parked in thread caches go to the waiting callers
+          Entry parked;
+          while (!waiters.empty() && stealFromThreadCaches(parked))
+            handOver(parked);
+
+          while (!waiter.served)
+          {
+            if (msecs < 0)
+            {
+              waiter.cond.wait(lock);
+              continue;
+            }
+
+            cxxtools::Timespan now = cxxtools::Clock::getSystemTicks();
+            if (msecs == 0 || now >= deadline)
+            {
+              waiters.erase(std::find(waiters.begin(), waiters.end(), &waiter));
+              ++timeoutCount;
+              log_warn("timeout while waiting for a connection to \"" << url << '"');
+              throw PoolTimeout(url);
+            }
+
+            waiter.cond.wait(lock, deadline - now);
+          }
+
+          if (!waiter.entry.connection)
+          {
+            // we got a free slot
+            lock.unlock();
+            return checkedOut(createConnection(), start);
+          }
+
+          entry = waiter.entry;
+        }
+        else if (!idle.empty())
+        {
+          entry = idle.back();
+          idle.pop_back();
+        }
+        else
+        {
+          ++currentSize;
+          lock.unlock();
+          return checkedOut(createConnection(), start);
+        }
+      }
+
+      if (validate(entry))
+        return checkedOut(Connection(new PoolConnection(*this, entry, false)), start);
+
+      log_warn("drop dead connection from pool");
+      droppedDead();
+      discard(entry);
+    }
+  }
+
+  Connection ConnectionPool::createConnection()
+  {
+    try
+    {
+      return Connection(new PoolConnection(*this, create(), true));
+    }
+    catch (...)
+    {
+      cxxtools::MutexLock lock(mutex);
+      --currentSize;
+      serveWaiters();
+      throw;
+    }
+  }
+
+  void ConnectionPool::drop(unsigned keep)
+  {
+    IdleType released;
+
+    {
+      cxxtools::MutexLock lock(mutex);
+      drainThreadCaches();
+      while (idle.size() > keep)
+      {
+        // release the connections, which were unused for the longest time
+        released.push_back(idle.front());
+        idle.pop_front();
+        --currentSize;
+      }
+
+      serveWaiters();
+    }
+
+    log_debug(released.size() << " connections released");
+  }
+
+  void ConnectionPool::setMaximumSize(unsigned m)
+  {
+    cxxtools::MutexLock lock(mutex);
+    maxcount = m;
+    serveWaiters();
+  }
+
+  // The mutex must be locked by the caller.
+  unsigned ConnectionPool::countParked() const
+  {
+    unsigned parked = 0;
+    if (threadCache)
+    {
+      for (ThreadCache::SlotsType::const_iterator it = threadCache->slots.begin();
+          it != threadCache->slots.end(); ++it)
+        if (cxxtools::atomicGet((*it)->state) != ThreadCache::Slot::Empty)
+          ++parked;
+    }
+
+    return parked;
+  }
+
+  unsigned ConnectionPool::getCurrentSize() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return idle.size() + countParked();
+  }
+
+  unsigned ConnectionPool::getTotalSize() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return currentSize;
+  }
+
+  void ConnectionPool::setValidationIdleTime(unsigned msecs)
+  {
+    cxxtools::MutexLock lock(mutex);
+    validationIdleTime = cxxtools::Timespan(static_cast<int64_t>(msecs) * 1000);
+  }
+
+  unsigned ConnectionPool::getValidationIdleTime() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return static_cast<unsigned>(validationIdleTime.totalMSecs());
+  }
+
+  void ConnectionPool::setMinIdle(unsigned n)
+  {
+    cxxtools::MutexLock lock(mutex);
+    minIdle = n;
+  }
+
+  unsigned ConnectionPool::getMinIdle() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return minIdle;
+  }
+
+  void ConnectionPool::setTimeout(long msecs)
+  {
+    cxxtools::MutexLock lock(mutex);
+    timeout = msecs;
+  }
+
+  long ConnectionPool::getTimeout() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return timeout;
+  }
+
+  void ConnectionPool::setMaximumWaiters(unsigned n)
+  {
+    cxxtools::MutexLock lock(mutex);
+    maxWaiters = n;
+  }
+
+  unsigned ConnectionPool::getMaximumWaiters() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return maxWaiters;
+  }
+
+  unsigned ConnectionPool::getWaiting() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return waiters.size();
+  }
+
+  unsigned long ConnectionPool::getWaitCount() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return waitCount;
+  }
+
+  unsigned long ConnectionPool::getTimeoutCount() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return timeoutCount;
+  }
+
+  unsigned long ConnectionPool::getRejectCount() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return rejectCount;
+  }
+
+  PoolStatistics ConnectionPool::getStatistics() const
+  {
+    PoolStatistics statistics;
+    statistics.url = url;
+
+    cxxtools::MutexLock lock(mutex);
+
+    statistics.idle = idle.size() + countParked() + validating;
+    statistics.inUse = currentSize - statistics.idle - connecting;
+    statistics.waiting = waiters.size();
+    statistics.created = createdCount;
+    statistics.droppedDead = droppedDeadCount;
+    statistics.waits = waitCount;
+    statistics.timeouts = timeoutCount;
+    statistics.rejected = rejectCount;
+    statistics.checkoutWait = checkoutWait;
+    statistics.holdTime = holdTime;
+
+    return statistics;
+  }
+
+  void ConnectionPool::maintain()
+  {
+    joinWarmUpThreads(false);
+
+    IdleType retired;
+    IdleType check;
+
+    {
+      cxxtools::MutexLock lock(mutex);
+
+      cxxtools::Timespan now = cxxtools::Clock::getSystemTicks();
+      bool lifetimeLimited = maxLifetime > cxxtools::Timespan(0);
+      bool idleLimited = idleTimeout > cxxtools::Timespan(0);
+
+      // the least recently used connections are at the front
+      IdleType keep;
+      unsigned remaining = idle.size();
+      for (IdleType::iterator it = idle.begin(); it != idle.end(); ++it)
+      {
+        if ((lifetimeLimited && now - it->created > maxLifetime)
+          || (idleLimited && now - it->lastUsed > idleTimeout && remaining > minIdle))
+        {
+          retired.push_back(*it);
+          --remaining;
+        }
+        else if (now - std::max(it->lastUsed, it->lastValidated) > validationIdleTime)
+          check.push_back(*it);
+        else
+          keep.push_back(*it);
+      }
+
+      idle.swap(keep);
+      currentSize -= retired.size();
+      validating += check.size();
+      serveWaiters();
+    }
+
+    if (!retired.empty())
+      log_debug(retired.size() << " connections to \"" << url << "\" retired");
+
+    // validate the connections here, so that connect() does not need to
+    while (!check.empty())
+    {
+      Entry& entry = check.back();
+      bool alive = entry.connection.ping();
+      if (alive)
+        entry.lastValidated = cxxtools::Clock::getSystemTicks();
+      else
+        log_warn("drop dead connection to \"" << url << "\" from pool");
+
+      {
+        cxxtools::MutexLock lock(mutex);
+        --validating;
+        if (!alive)
+        {
+          ++droppedDeadCount;
+          --currentSize;
+          serveWaiters();
+        }
+        else if (waiters.empty())
+          idle.push_front(entry);
+        else
+          handOver(entry);
+      }
+
+      if (!alive)
+        entry.connection = Connection();
+
+      check.pop_back();
+    }
+
+    warmUpConnections();
+  }
+
+  void ConnectionPool::setMaxLifetime(unsigned msecs)
   {
-    log_debug("create new connection for url \"" << url << '"');
-    return new Connection(tntdb::connect(url));
+    cxxtools::MutexLock lock(mutex);
+    maxLifetime = cxxtools::Timespan(static_cast<int64_t>(msecs) * 1000);
   }
 
-  ////////////////////////////////////////////////////////////////////////
-  // ConnectionPool
-  //
-  Connection ConnectionPool::connect()
+  unsigned ConnectionPool::getMaxLifetime() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return static_cast<unsigned>(maxLifetime.totalMSecs());
+  }
+
+  void ConnectionPool::setIdleTimeout(unsigned msecs)
+  {
+    cxxtools::MutexLock lock(mutex);
+    idleTimeout = cxxtools::Timespan(static_cast<int64_t>(msecs) * 1000);
+  }
+
+  unsigned ConnectionPool::getIdleTimeout() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return static_cast<unsigned>(idleTimeout.totalMSecs());
+  }
+
+  void ConnectionPool::setThreadCache(bool enable)
+  {
+    cxxtools::MutexLock lock(mutex);
+
+    if (enable)
+    {
+      if (threadCache == 0)
+      {
+        ThreadCache* c = new ThreadCache();
+        if (!c->hasKey)
+        {
+          log_warn("no thread specific key available; thread cache of pool \"" << url << "\" disabled");
+          delete c;
+          return;
+        }
+        threadCache = c;
+      }
+      cxxtools::atomicSet(useThreadCache, 1);
+    }
+    else
+    {
+      cxxtools::atomicSet(useThreadCache, 0);
+      drainThreadCaches();
+    }
+  }
+
+  bool ConnectionPool::getThreadCache() const
+  {
+    return cxxtools::atomicGet(const_cast<volatile cxxtools::atomic_t&>(useThreadCache)) != 0;
+  }
+
+  void ConnectionPool::registerStatement(const std::string& key, const std::string& query)
+  {
+    log_debug("register statement \"" << key << "\" for url \"" << url << '"');
+    cxxtools::MutexLock lock(mutex);
+    putStatement(key, query);
+  }
+
+  bool ConnectionPool::unregisterStatement(const std::string& key)
+  {
+    cxxtools::MutexLock lock(mutex);
+    RegistryType::iterator it = statements.find(key);
+    if (it == statements.end())
+      return false;
+
+    statementOrder.erase(it->second.order);
+    statements.erase(it);
+    return true;
+  }
+
+  ConnectionPool::StatementsType ConnectionPool::getStatements() const
   {
-    log_debug("ConnectionPool::connect()");
+    StatementsType ret;
+
+    cxxtools::MutexLock lock(mutex);
+    for (RegistryType::const_iterator it = statements.begin(); it != statements.end(); ++it)
+      ret.insert(ret.end(), StatementsType::value_type(it->first, it->second.query));
 
-    log_debug("current pool-size " << getCurrentSize());
+    return ret;
+  }
 
-    unsigned max = getCurrentSize() * 2;
+  void ConnectionPool::setMaxStatements(unsigned n)
+  {
+    cxxtools::MutexLock lock(mutex);
+    maxStatements = n;
 
-    for (unsigned n = 0; n < max; ++n)
+    while (maxStatements > 0 && statements.size() > maxStatements)
     {
-      Connection conn(new PoolConnection(pool.get()));
+      statements.erase(statementOrder.back());
+      statementOrder.pop_back();
+    }
+  }
 
-      if (conn.ping())
-        return conn;
+  unsigned ConnectionPool::getMaxStatements() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return maxStatements;
+  }
 
-      // a pool-connection don't put itself back into the pool after a failed ping
-      log_warn("drop dead connection from pool");
+  void ConnectionPool::setPrepareInBackground(bool sw)
+  {
+    cxxtools::MutexLock lock(mutex);
+    prepareInBackground = sw;
+  }
+
+  bool ConnectionPool::getPrepareInBackground() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return prepareInBackground;
+  }
+
+  void ConnectionPool::setStatementCaching(bool sw)
+  {
+    cxxtools::MutexLock lock(mutex);
+    statementCaching = sw;
+  }
+
+  bool ConnectionPool::getStatementCaching() const
+  {
+    cxxtools::MutexLock lock(mutex);
+    return statementCaching;
+  }
+
+  void ConnectionPool::setRecordStatements(bool sw)
+  {
+    cxxtools::atomicSet(recordStatements, sw ? 1 : 0);
+  }
+
+  bool ConnectionPool::getRecordStatements() const
+  {
+    return cxxtools::atomicGet(const_cast<volatile cxxtools::atomic_t&>(recordStatements)) != 0;
+  }
+
+  void ConnectionPool::dumpStatements(std::ostream& out) const
+  {
+    StatementsType s = getStatements();
+    for (StatementsType::const_iterator it = s.begin(); it != s.end(); ++it)
+    {
+      escapeStatementField(out, it->first);
+      out << '\t';
+      escapeStatementField(out, it->second);
+      out << '\n';
     }
+  }
+
+  void ConnectionPool::loadStatements(std::istream& in)
+  {
+    std::string line;
+    while (std::getline(in, line))
+    {
+      if (line.empty())
+        continue;
+
+      std::string::size_type n = line.find('\t');
+      if (n == std::string::npos)
+      {
+        log_warn("invalid statement line \"" << line << "\" ignored");
+        continue;
+      }
 
-    return Connection(new PoolConnection(pool.get()));
+      registerStatement(unescapeStatementField(line.substr(0, n)),
+                        unescapeStatementField(line.substr(n + 1)));
+    }
   }
 
   ////////////////////////////////////////////////////////////////////////
   // ConnectionPools
   //
+  ConnectionPools::ConnectionPools(unsigned maxcount_)
+    : pools(new PoolsType()),
+      readers(0),
+      retiredCount(0),
+      maxcount(maxcount_),
+      validationIdleTime(ConnectionPool::defaultValidationIdleTime),
+      minIdle(0),
+      timeout(-1),
+      maxWaiters(0),
+      threadCache(false),
+      maxLifetime(0),
+      idleTimeout(0),
+      prepareInBackground(false),
+      recordStatements(false),
+      maxStatements(ConnectionPool::defaultMaxStatements),
+      statementCaching(false),
+      maintainer(0),
+      maintainInterval(0),
+      maintainerRunning(false)
+  { }
+
   ConnectionPools::~ConnectionPools()
   {
+    stopMaintainer();
+
     cxxtools::MutexLock lock(mutex);
-    for (PoolsType::iterator it = pools.begin(); it != pools.end(); ++it)
+
+    const PoolsType& p = getPools();
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
       delete it->second;
+    delete &p;
+
+    for (unsigned n = 0; n < retiredPools.size(); ++n)
+      delete retiredPools[n];
+    for (unsigned n = 0; n < retiredMaps.size(); ++n)
+      delete retiredMaps[n];
   }
 
-  Connection ConnectionPools::connect(const std::string& url)
+  // Pins a pool for the duration of a call without holding the mutex.
+  class ConnectionPools::PoolRef
   {
-    log_debug("ConnectionPools::connect(\"" << url << "\")");
+      ConnectionPools& pools;
+      PoolType* pool;
+
+      PoolRef(const PoolRef&);
+      PoolRef& operator=(const PoolRef&);
+
+    public:
+      PoolRef(ConnectionPools& pools_, const std::string& url)
+        : pools(pools_),
+          pool(pools_.pinPool(url))
+        { }
+
+      ~PoolRef()
+        { pools.unpinPool(pool); }
+
+      PoolType* operator->() const
+        { return pool; }
+  };
 
-    PoolsType::iterator it;
+  // Reads the map of pools without lock. A compare exchange, which never
+  // matches, is an atomic load and pairs with the exchange in replacePools.
+  const ConnectionPools::PoolsType& ConnectionPools::loadPools()
+  {
+    return *static_cast<const PoolsType*>(cxxtools::atomicCompareExchange(pools, 0, 0));
+  }
+
+  void ConnectionPools::enterReader()
+  {
+    cxxtools::atomicIncrement(readers);
+  }
 
+  void ConnectionPools::leaveReader()
+  {
+    // the last reader deletes what was retired meanwhile unless a writer
+    // holds the mutex, which then does it
+    if (cxxtools::atomicDecrement(readers) == 0
+      && cxxtools::atomicGet(retiredCount) > 0
+      && mutex.tryLock())
     {
-      cxxtools::MutexLock lock(mutex);
-      it = pools.find(url);
-      if (it == pools.end())
+      cxxtools::MutexLock lock(mutex, false, true);
+      reclaimRetired();
+    }
+  }
+
+  // Publishes a new map of pools. The mutex must be locked by the caller.
+  void ConnectionPools::replacePools(PoolsType* newPools)
+  {
+    void* oldPools = cxxtools::atomicExchange(pools, newPools);
+    retiredMaps.push_back(static_cast<PoolsType*>(oldPools));
+    reclaimRetired();
+  }
+
+  // Deletes retired maps and pools, when no thread can see them any more.
+  // The mutex must be locked by the caller.
+  void ConnectionPools::reclaimRetired()
+  {
+    // a reader, which starts now, finds the current map
+    if (cxxtools::atomicGet(readers) != 0)
+      return;
+
+    for (unsigned n = 0; n < retiredMaps.size(); ++n)
+      delete retiredMaps[n];
+    retiredMaps.clear();
+
+    std::vector<PoolType*> keep;
+    for (unsigned n = 0; n < retiredPools.size(); ++n)
+    {
+      PoolType* pool = retiredPools[n];
+      if (cxxtools::atomicGet(pool->users) == 0)
       {
-        log_debug("create pool for url \"" << url << "\" with " << maxcount << " connections");
-        PoolType* pool = new PoolType(url, maxcount);
-        it = pools.insert(PoolsType::value_type(url, pool)).first;
+        // a caller, which pinned the pool before it was removed, may have
+        // left connections in it
+        pool->drop(0);
+        if (pool->getTotalSize() == 0)
+        {
+          log_debug("delete removed connectionpool for \"" << pool->url << '"');
+          delete pool;
+          continue;
+        }
       }
-      else
-        log_debug("pool for url \"" << url << "\" found");
+
+      keep.push_back(pool);
+    }
+
+    retiredPools.swap(keep);
+    cxxtools::atomicSet(retiredCount, retiredMaps.size() + retiredPools.size());
+  }
+
+  ConnectionPools::PoolType* ConnectionPools::pinPool(const std::string& url)
+  {
+    enterReader();
+
+    const PoolsType& rp = loadPools();
+    PoolsType::const_iterator rit = rp.find(url);
+    if (rit != rp.end())
+    {
+      log_debug("pool for url \"" << url << "\" found");
+      PoolType* pool = rit->second;
+      cxxtools::atomicIncrement(pool->users);
+      leaveReader();
+      return pool;
+    }
+
+    leaveReader();
+
+    cxxtools::MutexLock lock(mutex);
+
+    // another thread may have created the pool meanwhile
+    const PoolsType& p = getPools();
+    PoolsType::const_iterator it = p.find(url);
+    if (it != p.end())
+    {
+      cxxtools::atomicIncrement(it->second->users);
+      return it->second;
     }
 
-    log_debug("current pool-size " << it->second->getCurrentSize());
-    return it->second->connect();
+    log_debug("create pool for url \"" << url << "\" with " << maxcount << " connections");
+    PoolType* pool = new PoolType(url, maxcount);
+    pool->setValidationIdleTime(validationIdleTime);
+    pool->setTimeout(timeout);
+    pool->setMaximumWaiters(maxWaiters);
+    pool->setThreadCache(threadCache);
+    pool->setMaxLifetime(maxLifetime);
+    pool->setIdleTimeout(idleTimeout);
+    pool->setPrepareInBackground(prepareInBackground);
+    pool->setRecordStatements(recordStatements);
+    pool->setMaxStatements(maxStatements);
+    pool->setStatementCaching(statementCaching);
+    if (minIdle > 0)
+    {
+      pool->setMinIdle(minIdle);
+      pool->warmUp();
+    }
+
+    PoolsType* newPools = new PoolsType(p);
+    newPools->insert(PoolsType::value_type(url, pool));
+    replacePools(newPools);
+
+    cxxtools::atomicIncrement(pool->users);
+    return pool;
+  }
+
+  void ConnectionPools::unpinPool(PoolType* pool)
+  {
+    cxxtools::atomicDecrement(pool->users);
+  }
+
+  Connection ConnectionPools::connect(const std::string& url)
+  {
+    log_debug("ConnectionPools::connect(\"" << url << "\")");
+
+    PoolRef pool(*this, url);
+
+    log_debug("current pool-size " << pool->getCurrentSize());
+    return pool->connect();
+  }
+
+  Connection ConnectionPools::connect(const std::string& url, long msecs)
+  {
+    log_debug("ConnectionPools::connect(\"" << url << "\", " << msecs << ')');
+    return PoolRef(*this, url)->connect(msecs);
+  }
+
+  void ConnectionPools::warmUp(const std::string& url, unsigned threads, bool wait)
+  {
+    log_debug("ConnectionPools::warmUp(\"" << url << "\", " << threads << ')');
+    PoolRef(*this, url)->warmUp(threads, wait);
   }
 
   void ConnectionPools::drop(unsigned keep)
@@ -107,10 +1293,11 @@ namespace tntdb
     log_debug("drop(" << keep << ')');
 
     cxxtools::MutexLock lock(mutex);
-    for (PoolsType::iterator it = pools.begin(); it != pools.end(); ++it)
+    const PoolsType& p = getPools();
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
     {
       log_debug("pool \"" << it->first << "\"; current size " << it->second->getCurrentSize());
-      it->second->drop();
+      it->second->drop(keep);
       log_debug("connections released " << it->second->getCurrentSize() << " kept");
     }
   }
@@ -120,19 +1307,26 @@ namespace tntdb
     log_debug("drop(\"" << url << "\", " << keep << ')');
 
     cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
 
-    PoolsType::iterator it = pools.find(url);
-    if (it != pools.end())
+    PoolsType::const_iterator it = p.find(url);
+    if (it != p.end())
     {
       log_debug("pool \"" << url << "\" found; current size " << it->second->getCurrentSize());
       it->second->drop(keep);
       log_debug("connections released " << it->second->getCurrentSize() << " kept");
 
-      if (it->second->getCurrentSize() == 0)
+      // connections in use still refer to their pool; registered
+      // statements are kept for the next connections
+      if (it->second->getTotalSize() == 0 && it->second->getStatements().empty())
       {
-        log_debug("delete connectionpool for \"" << url << "\"");
-        delete it->second;
-        pools.erase(it);
+        log_debug("remove connectionpool for \"" << url << "\"");
+        retiredPools.push_back(it->second);
+        cxxtools::atomicIncrement(retiredCount);
+
+        PoolsType* newPools = new PoolsType(p);
+        newPools->erase(url);
+        replacePools(newPools);
       }
     }
     else
@@ -142,17 +1336,238 @@ namespace tntdb
   unsigned ConnectionPools::getCurrentSize(const std::string& url) const
   {
     cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
 
-    PoolsType::const_iterator it = pools.find(url);
-    return it == pools.end() ? 0
+    PoolsType::const_iterator it = p.find(url);
+    return it == p.end() ? 0
                              : it->second->getCurrentSize();
   }
 
+  PoolStatistics ConnectionPools::getStatistics(const std::string& url) const
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+
+    PoolsType::const_iterator it = p.find(url);
+    if (it != p.end())
+      return it->second->getStatistics();
+
+    PoolStatistics statistics;
+    statistics.url = url;
+    return statistics;
+  }
+
+  std::map<std::string, PoolStatistics> ConnectionPools::getStatistics() const
+  {
+    std::map<std::string, PoolStatistics> ret;
+
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      ret[it->first] = it->second->getStatistics();
+
+    return ret;
+  }
+
   void ConnectionPools::setMaximumSize(unsigned m)
   {
     cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
     maxcount = m;
-    for (PoolsType::const_iterator it = pools.begin(); it != pools.end(); ++it)
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
       it->second->setMaximumSize(m);
   }
+
+  void ConnectionPools::setValidationIdleTime(unsigned msecs)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    validationIdleTime = msecs;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setValidationIdleTime(msecs);
+  }
+
+  void ConnectionPools::setMinIdle(unsigned n)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    minIdle = n;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setMinIdle(n);
+  }
+
+  void ConnectionPools::setTimeout(long msecs)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    timeout = msecs;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setTimeout(msecs);
+  }
+
+  void ConnectionPools::setMaximumWaiters(unsigned n)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    maxWaiters = n;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setMaximumWaiters(n);
+  }
+
+  void ConnectionPools::setThreadCache(bool enable)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    threadCache = enable;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setThreadCache(enable);
+  }
+
+  void ConnectionPools::setMaxLifetime(unsigned msecs)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    maxLifetime = msecs;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setMaxLifetime(msecs);
+  }
+
+  void ConnectionPools::setIdleTimeout(unsigned msecs)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    idleTimeout = msecs;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setIdleTimeout(msecs);
+  }
+
+  void ConnectionPools::registerStatement(const std::string& url,
+    const std::string& key, const std::string& query)
+  {
+    PoolRef(*this, url)->registerStatement(key, query);
+  }
+
+  bool ConnectionPools::unregisterStatement(const std::string& url, const std::string& key)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+
+    PoolsType::const_iterator it = p.find(url);
+    return it != p.end() && it->second->unregisterStatement(key);
+  }
+
+  void ConnectionPools::dumpStatements(const std::string& url, std::ostream& out) const
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+
+    PoolsType::const_iterator it = p.find(url);
+    if (it != p.end())
+      it->second->dumpStatements(out);
+  }
+
+  void ConnectionPools::loadStatements(const std::string& url, std::istream& in)
+  {
+    PoolRef(*this, url)->loadStatements(in);
+  }
+
+  void ConnectionPools::setPrepareInBackground(bool sw)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    prepareInBackground = sw;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setPrepareInBackground(sw);
+  }
+
+  void ConnectionPools::setRecordStatements(bool sw)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    recordStatements = sw;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setRecordStatements(sw);
+  }
+
+  void ConnectionPools::setMaxStatements(unsigned n)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    maxStatements = n;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setMaxStatements(n);
+  }
+
+  void ConnectionPools::setStatementCaching(bool sw)
+  {
+    cxxtools::MutexLock lock(mutex);
+    const PoolsType& p = getPools();
+    statementCaching = sw;
+    for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      it->second->setStatementCaching(sw);
+  }
+
+  void ConnectionPools::runMaintainer()
+  {
+    log_debug("maintainer thread started");
+
+    cxxtools::MutexLock lock(mutex);
+    while (maintainerRunning)
+    {
+      maintainerCond.wait(lock, cxxtools::Timespan(static_cast<int64_t>(maintainInterval) * 1000));
+      if (!maintainerRunning)
+        break;
+
+      // as a reader the maintainer keeps the map and its pools alive
+      enterReader();
+      const PoolsType& p = getPools();
+      lock.unlock();
+
+      for (PoolsType::const_iterator it = p.begin(); it != p.end(); ++it)
+      {
+        try
+        {
+          it->second->maintain();
+        }
+        catch (const std::exception& e)
+        {
+          log_warn("maintenance of pool \"" << it->first << "\" failed: " << e.what());
+        }
+      }
+
+      leaveReader();
+      lock.lock();
+    }
+
+    log_debug("maintainer thread stopped");
+  }
+
+  void ConnectionPools::startMaintainer(unsigned intervalMsecs)
+  {
+    stopMaintainer();
+
+    cxxtools::MutexLock lock(mutex);
+    log_debug("start maintainer with interval " << intervalMsecs << " ms");
+    maintainInterval = intervalMsecs;
+    maintainerRunning = true;
+    maintainer = new cxxtools::AttachedThread(
+      cxxtools::callable(*this, &ConnectionPools::runMaintainer));
+    maintainer->start();
+  }
+
+  void ConnectionPools::stopMaintainer()
+  {
+    cxxtools::AttachedThread* thread;
+
+    {
+      cxxtools::MutexLock lock(mutex);
+      thread = maintainer;
+      maintainer = 0;
+      maintainerRunning = false;
+      maintainerCond.broadcast();
+    }
+
+    // the destructor of an attached thread joins it
+    delete thread;
+  }
 }
@@ -27,8 +27,8 @@
  */
 
 #include <tntdb/date.h>
+#include <tntdb/impl/isodatetime.h>
 #include <tntdb/error.h>
-#include <cctype>
 #include <sys/time.h>
 #include <time.h>
 #include <string.h>
@@ -74,11 +74,12 @@ namespace tntdb
   }
 
 
-  std::string Date::getIso() const
+  const unsigned Date::isoLength;
+
+  unsigned Date::getIso(char* ret) const
   {
     // format YYYY-MM-DD
     //        0....+....1
-    char ret[10];
     unsigned short n = _year;
     ret[3] = '0' + n % 10;
     n /= 10;
@@ -94,49 +95,26 @@ namespace tntdb
     ret[8] = '0' + _day / 10;
     ret[9] = '0' + _day % 10;
 
-    return std::string(ret, 10);
+    return isoLength;
   }
 
-  inline unsigned short getNumber2(const char* s)
+  std::string Date::getIso() const
   {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1]))
-      throw TypeError();
-    return (s[0] - '0') * 10
-         + (s[1] - '0');
+    char ret[isoLength];
+    return std::string(ret, getIso(ret));
   }
 
-  inline unsigned short getNumber4(const char* s)
+  Date Date::fromIso(const std::string& s)
   {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1])
-      || !std::isdigit(s[2])
-      || !std::isdigit(s[3]))
-      throw TypeError();
-    return (s[0] - '0') * 1000
-         + (s[1] - '0') * 100
-         + (s[2] - '0') * 10
-         + (s[3] - '0');
+    return fromIso(s.data(), s.size());
   }
 
-  Date Date::fromIso(const std::string& s)
+  Date Date::fromIso(const char* s, unsigned len)
   {
     Date ret;
-    const char* d = s.data();
-    try
-    {
-      if (s.size() < 10
-        || d[4] != '-'
-        || d[7] != '-')
-        throw TypeError();
-      ret.set(getNumber4(d), getNumber2(d + 5), getNumber2(d + 8));
-    }
-    catch (const TypeError&)
-    {
-      throw TypeError("failed to convert string \"" + s + "\" into date");
-    }
-
+    std::size_t n = parseIsoDate(s, len, ret);
+    if (n == 0)
+      throw TypeError("failed to convert string \"" + std::string(s, len) + "\" into date");
     return ret;
   }
-
 }
@@ -27,8 +27,8 @@
  */
 
 #include <tntdb/datetime.h>
+#include <tntdb/impl/isodatetime.h>
 #include <tntdb/error.h>
-#include <cctype>
 #include <sys/time.h>
 #include <time.h>
 
@@ -62,11 +62,12 @@ namespace tntdb
                     tv.tv_usec / 1000);
   }
 
-  std::string Datetime::getIso() const
+  const unsigned Datetime::isoLength;
+
+  unsigned Datetime::getIso(char* ret) const
   {
     // format YYYY-MM-DD hh:mm:ss.sss
     //        0....+....1....+....2....+
-    char ret[25];
     unsigned short n = _year;
     ret[3] = '0' + n % 10;
     n /= 10;
@@ -98,79 +99,26 @@ namespace tntdb
     n /= 10;
     ret[20] = '0' + n % 10;
 
-    return std::string(ret, 23);
-  }
-
-  inline unsigned short getNumber2(const char* s)
-  {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1]))
-      throw TypeError();
-    return (s[0] - '0') * 10
-         + (s[1] - '0');
+    return isoLength;
   }
 
-  inline unsigned short getNumber3(const char* s)
+  std::string Datetime::getIso() const
   {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1])
-      || !std::isdigit(s[2]))
-      throw TypeError();
-    return (s[0] - '0') * 100
-         + (s[1] - '0') * 10
-         + (s[2] - '0');
+    char ret[isoLength];
+    return std::string(ret, getIso(ret));
   }
 
-  inline unsigned short getNumber4(const char* s)
+  Datetime Datetime::fromIso(const std::string& s)
   {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1])
-      || !std::isdigit(s[2])
-      || !std::isdigit(s[3]))
-      throw TypeError();
-    return (s[0] - '0') * 1000
-         + (s[1] - '0') * 100
-         + (s[2] - '0') * 10
-         + (s[3] - '0');
+    return fromIso(s.data(), s.size());
   }
 
-  Datetime Datetime::fromIso(const std::string& s)
+  Datetime Datetime::fromIso(const char* s, unsigned len)
   {
     Datetime ret;
-    const char* d = s.data();
-    try
-    {
-      if (s.size() == 23
-        && d[4] == '-'
-        && d[7] == '-'
-        && d[10] == ' '
-        && d[13] == ':'
-        && d[16] == ':'
-        && d[19] == '.')
-      {
-        ret.set(getNumber4(d), getNumber2(d + 5), getNumber2(d + 8),
-                getNumber2(d + 11), getNumber2(d + 14), getNumber2(d + 17),
-                getNumber3(d + 20));
-      }
-      else if (s.size() == 19
-        && d[4] == '-'
-        && d[7] == '-'
-        && d[10] == ' '
-        && d[13] == ':'
-        && d[16] == ':')
-      {
-        ret.set(getNumber4(d), getNumber2(d + 5), getNumber2(d + 8),
-                getNumber2(d + 11), getNumber2(d + 14), getNumber2(d + 17));
-      }
-      else
-        throw TypeError();
-    }
-    catch (const TypeError&)
-    {
-      throw TypeError("failed to convert string \"" + s + "\" into datetime");
-    }
-
+    std::size_t n = parseIsoDatetime(s, len, ret);
+    if (n == 0 || n != len)
+      throw TypeError("failed to convert string \"" + std::string(s, len) + "\" into datetime");
     return ret;
   }
 }
-
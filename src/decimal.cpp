@@ -27,10 +27,10 @@
  */
 
 #include <tntdb/decimal.h>
+#include <tntdb/impl/numconvert.h>
 #include <cctype>
 #include <stdexcept>
 #include <iostream>
-#include <cxxtools/convert.h>
 #include <cxxtools/log.h>
 #include <cmath>
 
@@ -472,17 +472,29 @@ namespace tntdb
   Decimal::Decimal(const std::string& value)
     : _exponent(0),
       _negative(false)
+  {
+    _parse(value.data(), value.size());
+  }
+
+  Decimal::Decimal(const char* value, std::string::size_type len)
+    : _exponent(0),
+      _negative(false)
+  {
+    _parse(value, len);
+  }
+
+  void Decimal::_parse(const char* value, std::string::size_type len)
   {
     Parser parser;
 
     parser.begin(*this);
 
-    for (std::string::const_iterator it = value.begin(); it != value.end(); ++it)
+    for (const char* it = value; it != value + len; ++it)
       parser.parse(*it);
 
     parser.finish();
 
-    log_debug("string value \"" << value << "\" => negative=" << _negative << " mantissa=" << _mantissa << " exponent=" << _exponent);
+    log_debug("string value \"" << std::string(value, len) << "\" => negative=" << _negative << " mantissa=" << _mantissa << " exponent=" << _exponent);
   }
 
   long double Decimal::getDouble() const
@@ -533,7 +545,8 @@ namespace tntdb
 
   void Decimal::_setInteger(LongType l, short exponent)
   {
-    _mantissa = cxxtools::convert<std::string>(l);
+    char buf[numberBufferSize];
+    _mantissa.assign(buf, formatInteger(l, buf));
 
     if (_mantissa[0] == '-')
     {
@@ -550,7 +563,8 @@ namespace tntdb
 
   void Decimal::_setUnsigned(UnsignedLongType l, short exponent)
   {
-    _mantissa = cxxtools::convert<std::string>(l);
+    char buf[numberBufferSize];
+    _mantissa.assign(buf, formatInteger(l, buf));
     _negative = false;
     _exponent = exponent + _mantissa.size();
     stripZeros(_mantissa);
@@ -570,20 +584,44 @@ namespace tntdb
 
   std::string Decimal::toString() const
   {
-    return (_exponent < 0 || _exponent > 8) ? toStringSci() : toStringFix();
+    std::string ret;
+    toString(ret);
+    return ret;
+  }
+
+  void Decimal::toString(std::string& ret) const
+  {
+    if (_exponent < 0 || _exponent > 8)
+      _printSci(ret);
+    else
+      _printFix(ret);
   }
 
   std::string Decimal::toStringSci() const
+  {
+    std::string ret;
+    _printSci(ret);
+    return ret;
+  }
+
+  std::string Decimal::toStringFix() const
+  {
+    std::string ret;
+    _printFix(ret);
+    return ret;
+  }
+
+  void Decimal::_printSci(std::string& ret) const
   {
     if (isPositiveInfinity())
-      return "inf";
+      ret = "inf";
     else if (isNegativeInfinity())
-      return "-inf";
+      ret = "-inf";
     else if (isNaN())
-      return "nan";
+      ret = "nan";
     else
     {
-      std::string ret;
+      ret.clear();
       if (_negative)
         ret = '-';
       ret += _mantissa[0];
@@ -594,43 +632,42 @@ namespace tntdb
       }
 
       ret += 'e';
-      ret += cxxtools::convert<std::string>(_exponent - 1);
-
-      return ret;
+      char buf[numberBufferSize];
+      ret.append(buf, formatNumber(static_cast<int>(_exponent - 1), buf));
     }
   }
 
-  std::string Decimal::toStringFix() const
+  void Decimal::_printFix(std::string& ret) const
   {
     if (isPositiveInfinity())
-      return "inf";
+      ret = "inf";
     else if (isNegativeInfinity())
-      return "-inf";
+      ret = "-inf";
     else if (isNaN())
-      return "nan";
+      ret = "nan";
     else
     {
-      std::string ret;
+      ret.clear();
+      if (_negative)
+        ret = '-';
 
       if (_exponent < 1)
       {
-        ret = "0.";
+        ret += "0.";
         ret.append(-_exponent, '0');
         ret.append(_mantissa);
       }
+      else if (_exponent < static_cast<short>(_mantissa.size()))
+      {
+        ret.append(_mantissa, 0, _exponent);
+        ret += '.';
+        ret.append(_mantissa, _exponent, std::string::npos);
+      }
       else
       {
-        ret = _mantissa;
-        if (_exponent < static_cast<short>(_mantissa.size()))
-          ret.insert(_exponent, 1, '.');
-        else
-          ret.append(_exponent - _mantissa.size(), '0');
+        ret.append(_mantissa);
+        ret.append(_exponent - _mantissa.size(), '0');
       }
-
-      if (_negative)
-        ret.insert(0u, 1u, '-');
-
-      return ret;
     }
   }
 
@@ -28,6 +28,7 @@
 
 #include <tntdb/error.h>
 #include <cxxtools/log.h>
+#include <sstream>
 
 log_define("tntdb.error")
 
@@ -61,4 +62,34 @@ namespace tntdb
       field(field_)
   {
   }
+
+  namespace
+  {
+    std::string batchErrorMessage(unsigned row, const std::string& msg)
+    {
+      std::ostringstream s;
+      s << "batch row " << row << " failed: " << msg;
+      return s.str();
+    }
+  }
+
+  BatchError::BatchError(unsigned row_, const std::string& msg, unsigned affectedRows_)
+    : Error(batchErrorMessage(row_, msg)),
+      row(row_),
+      rowMessage(msg),
+      affectedRows(affectedRows_)
+  {
+  }
+
+  PoolTimeout::PoolTimeout(const std::string& url_)
+    : Error("timeout while waiting for a connection to \"" + url_ + '"'),
+      url(url_)
+  {
+  }
+
+  PoolExhausted::PoolExhausted(const std::string& url_)
+    : Error("too many requests waiting for a connection to \"" + url_ + '"'),
+      url(url_)
+  {
+  }
 }
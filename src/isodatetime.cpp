@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <tntdb/impl/isodatetime.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+
+namespace tntdb
+{
+  namespace
+  {
+    // returns the value of a digit or a value greater than 9 for other characters
+    inline unsigned digit(char ch)
+    {
+      return static_cast<unsigned char>(ch - '0');
+    }
+
+    // the digits are checked together, so that there is only one branch per value
+    inline unsigned short getNumber2(const char* s, unsigned& bad)
+    {
+      unsigned d0 = digit(s[0]);
+      unsigned d1 = digit(s[1]);
+      bad |= (d0 > 9) | (d1 > 9);
+      return d0 * 10 + d1;
+    }
+
+    inline unsigned short getNumber4(const char* s, unsigned& bad)
+    {
+      unsigned d0 = digit(s[0]);
+      unsigned d1 = digit(s[1]);
+      unsigned d2 = digit(s[2]);
+      unsigned d3 = digit(s[3]);
+      bad |= (d0 > 9) | (d1 > 9) | (d2 > 9) | (d3 > 9);
+      return d0 * 1000 + d1 * 100 + d2 * 10 + d3;
+    }
+  }
+
+  std::size_t parseIsoDate(const char* s, std::size_t len, Date& ret)
+  {
+    // format YYYY-MM-DD
+    //        0....+....1
+    if (len < 10 || s[4] != '-' || s[7] != '-')
+      return 0;
+
+    unsigned bad = 0;
+    unsigned short year = getNumber4(s, bad);
+    unsigned short month = getNumber2(s + 5, bad);
+    unsigned short day = getNumber2(s + 8, bad);
+    if (bad)
+      return 0;
+
+    ret.set(year, month, day);
+    return 10;
+  }
+
+  std::size_t parseIsoTime(const char* s, std::size_t len, Time& ret)
+  {
+    // format hh:mm:ss[.fff...]
+    //        0....+....1
+    if (len < 8 || s[2] != ':' || s[5] != ':')
+      return 0;
+
+    unsigned bad = 0;
+    unsigned short hour = getNumber2(s, bad);
+    unsigned short minute = getNumber2(s + 3, bad);
+    unsigned short second = getNumber2(s + 6, bad);
+    if (bad)
+      return 0;
+
+    std::size_t n = 8;
+    unsigned short millis = 0;
+    if (n < len && s[n] == '.')
+    {
+      ++n;
+      unsigned digits = 0;
+      for ( ; n < len && digit(s[n]) <= 9; ++n, ++digits)
+      {
+        if (digits < 3)
+          millis = millis * 10 + digit(s[n]);
+      }
+
+      if (digits == 0)
+        return 0;
+
+      for ( ; digits < 3; ++digits)
+        millis *= 10;
+    }
+
+    ret.set(hour, minute, second, millis);
+    return n;
+  }
+
+  std::size_t parseIsoDatetime(const char* s, std::size_t len, Datetime& ret)
+  {
+    Date date;
+    Time time;
+    if (parseIsoDate(s, len, date) == 0
+      || len < 11 || (s[10] != ' ' && s[10] != 'T'))
+      return 0;
+
+    std::size_t n = parseIsoTime(s + 11, len - 11, time);
+    if (n == 0)
+      return 0;
+
+    ret = Datetime(date, time);
+    return n + 11;
+  }
+}
@@ -33,6 +33,7 @@
 #include <tntdb/time.h>
 #include <tntdb/datetime.h>
 #include <tntdb/decimal.h>
+#include <tntdb/impl/numconvert.h>
 #include <cxxtools/log.h>
 #include <sstream>
 #include <string.h>
@@ -185,12 +186,10 @@ namespace tntdb
         case MYSQL_TYPE_VAR_STRING:
         case MYSQL_TYPE_STRING:
         {
-          std::string data(static_cast<char*>(bind.buffer), *bind.length);
-          log_debug("extract integer-type from string \"" << data << '"');
-          std::istringstream in(data);
+          const char* data = static_cast<const char*>(bind.buffer);
+          log_debug("extract integer-type from string \"" << std::string(data, *bind.length) << '"');
           int_type ret;
-          in >> ret;
-          if (in.eof() || !in.fail())
+          if (parseInteger(data, *bind.length, ret))
             return ret;
 
           // no break!!!
@@ -227,12 +226,10 @@ namespace tntdb
         case MYSQL_TYPE_VAR_STRING:
         case MYSQL_TYPE_STRING:
         {
-          std::string data(static_cast<char*>(bind.buffer), *bind.length);
-          log_debug("extract float-type from string \"" << data << '"');
-          std::istringstream in(data);
+          const char* data = static_cast<const char*>(bind.buffer);
+          log_debug("extract float-type from string \"" << std::string(data, *bind.length) << '"');
           float_type ret;
-          in >> ret;
-          if (in.eof() || !in.fail())
+          if (parseNumber(data, *bind.length, ret))
             return ret;
 
           // no break!!!
@@ -383,6 +380,18 @@ namespace tntdb
       bind.length = &length;
     }
 
+    void setString(MYSQL_BIND& bind, unsigned long& length,
+      const char* data, unsigned long size)
+    {
+      reserve(bind, size);
+      memcpy(static_cast<char*>(bind.buffer), data, size);
+
+      bind.buffer_type = MYSQL_TYPE_VAR_STRING;
+      bind.is_null = 0;
+      length = size;
+      bind.length = &length;
+    }
+
     void setDate(MYSQL_BIND& bind, const Date& data)
     {
       reserve(bind, sizeof(MYSQL_TIME));
@@ -523,8 +532,7 @@ namespace tntdb
         case MYSQL_TYPE_VAR_STRING:
         case MYSQL_TYPE_STRING:
         {
-          std::string data(static_cast<char*>(bind.buffer), *bind.length);
-          return Decimal(data);
+          return Decimal(static_cast<const char*>(bind.buffer), *bind.length);
           // no break!!!
         }
 
@@ -591,14 +599,16 @@ namespace tntdb
         case MYSQL_TYPE_DATE:
         {
           MYSQL_TIME* ts = static_cast<MYSQL_TIME*>(bind.buffer);
-          ret.assign(Date(ts->year, ts->month, ts->day).getIso());
+          char iso[Date::isoLength];
+          ret.assign(iso, Date(ts->year, ts->month, ts->day).getIso(iso));
           break;
         }
 
         case MYSQL_TYPE_TIME:
         {
           MYSQL_TIME* ts = static_cast<MYSQL_TIME*>(bind.buffer);
-          ret.assign(Time(ts->hour, ts->minute, ts->second).getIso());
+          char iso[Time::isoLength];
+          ret.assign(iso, Time(ts->hour, ts->minute, ts->second).getIso(iso));
           break;
         }
 
@@ -606,14 +616,16 @@ namespace tntdb
         case MYSQL_TYPE_TIMESTAMP:
         {
           MYSQL_TIME* ts = static_cast<MYSQL_TIME*>(bind.buffer);
-          ret.assign(Datetime(ts->year, ts->month, ts->day,
-                          ts->hour, ts->minute, ts->second, ts->second_part).getIso());
+          char iso[Datetime::isoLength];
+          ret.assign(iso, Datetime(ts->year, ts->month, ts->day,
+                          ts->hour, ts->minute, ts->second, ts->second_part).getIso(iso));
           break;
         }
 
         default:
         {
-          std::ostringstream s;
+          char s[numberBufferSize];
+          std::size_t n;
           switch (bind.buffer_type)
           {
             case MYSQL_TYPE_TINY:
@@ -621,31 +633,31 @@ namespace tntdb
             case MYSQL_TYPE_INT24:
             case MYSQL_TYPE_LONG:
               if (bind.is_unsigned)
-                s << getInteger<unsigned int>(bind);
+                n = formatInteger(getInteger<unsigned int>(bind), s);
               else
-                s << getInteger<int>(bind);
+                n = formatInteger(getInteger<int>(bind), s);
               break;
 
             case MYSQL_TYPE_LONGLONG:
               if (bind.is_unsigned)
-                s << *static_cast<long long unsigned*>(bind.buffer);
+                n = formatInteger(*static_cast<long long unsigned*>(bind.buffer), s);
               else
-                s << *static_cast<long long int*>(bind.buffer);
+                n = formatInteger(*static_cast<long long int*>(bind.buffer), s);
               break;
 
             case MYSQL_TYPE_FLOAT:
-              s << *static_cast<float*>(bind.buffer);
+              n = formatFloat(*static_cast<float*>(bind.buffer), s);
               break;
 
             case MYSQL_TYPE_DOUBLE:
-              s << *static_cast<double*>(bind.buffer);
+              n = formatDouble(*static_cast<double*>(bind.buffer), s);
               break;
 
             default:
               log_error("type-error in getString, type=" << bind.buffer_type);
               throw TypeError("type-error in getString");
           }
-          ret.assign(s.str());
+          ret.assign(s, n);
         }
       }
     }
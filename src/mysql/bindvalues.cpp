@@ -59,10 +59,18 @@ namespace tntdb
     }
 
     BindValues::~BindValues()
+    {
+      releaseAll();
+    }
+
+    void BindValues::releaseAll()
     {
       if (values)
         for (unsigned n = 0; n < valuesSize; ++n)
+        {
+          own(n);
           delete[] static_cast<char*>(values[n].buffer);
+        }
 
       delete[] values;
       delete[] bindAttributes;
@@ -73,13 +81,7 @@ namespace tntdb
       if (valuesSize == n)
         return;
 
-      if (values)
-      {
-        for (unsigned nn = 0; nn < valuesSize; ++nn)
-          delete[] static_cast<char*>(values[nn].buffer);
-        delete[] values;
-        delete[] bindAttributes;
-      }
+      releaseAll();
 
       valuesSize = n,
       values = new MYSQL_BIND[n];
@@ -93,11 +95,41 @@ namespace tntdb
       }
     }
 
+    void BindValues::restoreBuffer(unsigned n)
+    {
+      BindAttributes& attr = bindAttributes[n];
+      values[n].buffer = attr.ownBuffer;
+      values[n].buffer_length = attr.ownBufferLength;
+      attr.ownBuffer = 0;
+      attr.ownBufferLength = 0;
+      attr.borrowed = false;
+      attr.blob = Blob();
+    }
+
+    void BindValues::setRef(unsigned n, const char* data, unsigned long length)
+    {
+      BindAttributes& attr = bindAttributes[n];
+      if (!attr.borrowed)
+      {
+        attr.ownBuffer = values[n].buffer;
+        attr.ownBufferLength = values[n].buffer_length;
+        attr.borrowed = true;
+      }
+
+      values[n].buffer = const_cast<char*>(data);
+      values[n].buffer_length = length;
+      values[n].buffer_type = MYSQL_TYPE_VAR_STRING;
+      values[n].is_null = 0;
+      attr.length = length;
+      values[n].length = &attr.length;
+    }
+
     void BindValues::initOutBuffer(unsigned n, MYSQL_FIELD& f)
     {
       log_debug("initOutBuffer name=" << f.name << " n=" << n << " length=" << f.length << " type=" << f.type
         << " max_length=" << f.max_length);
 
+      own(n);
       reserve(values[n], std::max(f.length, f.max_length));
       if (f.type == 0)
         log_debug("no type in metadata for field " << n << "; using MYSQL_TYPE_VAR_STRING");
@@ -35,6 +35,28 @@ namespace tntdb
 {
   namespace mysql
   {
+    BoundRow::BoundRow(unsigned n)
+      : BindValues(n)
+    {
+      values.reserve(n);
+      for (unsigned i = 0; i < n; ++i)
+        values.add(BoundValue(getMysqlBind()[i]));
+    }
+
+    const ColumnDescriptor& BoundRow::getColumns() const
+    {
+      if (!columns)
+      {
+        cxxtools::SmartPtr<ColumnDescriptor> c = new ColumnDescriptor();
+        c->reserve(size());
+        for (size_type n = 0; n < size(); ++n)
+          c->add(getName(n));
+        columns = c;
+      }
+
+      return *columns;
+    }
+
     BoundRow::size_type BoundRow::size() const
     {
       return BindValues::getSize();
@@ -42,23 +64,12 @@ namespace tntdb
 
     Value BoundRow::getValueByNumber(size_type field_num) const
     {
-      // TODO eliminate creation of BoundValue, by preallocating them.
-      // We can maintain a vector<BoundValue> and prevent dynamic deallocation
-      // of elements by overriding BoundValue::release
-      return Value(new BoundValue(const_cast<IRow*>(static_cast<const IRow*>(this)), getMysqlBind()[field_num]));
+      return values.get(field_num, const_cast<IRow*>(static_cast<const IRow*>(this)));
     }
 
     Value BoundRow::getValueByName(const std::string& field_name) const
     {
-      size_type field_num;
-      for (field_num = 0; field_num < size(); ++field_num)
-        if (getName(field_num) == field_name)
-          break;
-
-      if (field_num >= size())
-        throw FieldNotFound(field_name);
-
-      return getValueByNumber(field_num);
+      return getValueByNumber(getColumns().getIndex(field_name));
     }
 
     std::string BoundRow::getColumnName(size_type field_num) const
@@ -66,5 +77,45 @@ namespace tntdb
       return getName(field_num);
     }
 
+    BoundRow::size_type BoundRow::getColumnIndex(const std::string& field_name) const
+    {
+      return getColumns().find(field_name);
+    }
+
+    bool BoundRow::isNull(size_type field_num) const
+    {
+      return values.at(field_num).isNull();
+    }
+
+    bool BoundRow::getBool(size_type field_num) const
+    {
+      return values.at(field_num).getBool();
+    }
+
+    int BoundRow::getInt(size_type field_num) const
+    {
+      return values.at(field_num).getInt();
+    }
+
+    int64_t BoundRow::getInt64(size_type field_num) const
+    {
+      return values.at(field_num).getInt64();
+    }
+
+    uint64_t BoundRow::getUnsigned64(size_type field_num) const
+    {
+      return values.at(field_num).getUnsigned64();
+    }
+
+    double BoundRow::getDouble(size_type field_num) const
+    {
+      return values.at(field_num).getDouble();
+    }
+
+    void BoundRow::getString(size_type field_num, std::string& ret) const
+    {
+      values.at(field_num).getString(ret);
+    }
+
   }
 }
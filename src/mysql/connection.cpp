@@ -33,6 +33,9 @@
 #include <tntdb/statement.h>
 #include <tntdb/mysql/error.h>
 #include <cctype>
+#include <errno.h>
+#include <poll.h>
+#include <sys/socket.h>
 
 #include <cxxtools/log.h>
 
@@ -365,6 +368,40 @@ namespace tntdb
       return ret == 0;
     }
 
+    bool Connection::isAlive()
+    {
+      // an idle connection has nothing to read unless the server closed it
+      struct pollfd fd;
+      fd.fd = mysql.net.fd;
+      fd.events = POLLIN;
+      if (::poll(&fd, 1, 0) == 0)
+        return true;
+
+      char ch;
+      ssize_t ret = ::recv(fd.fd, &ch, 1, MSG_PEEK | MSG_DONTWAIT);
+      log_debug("input pending on idle connection; recv => " << ret);
+      return ret > 0 || (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+    }
+
+    bool Connection::reset()
+    {
+      if (transactionActive > 0)
+      {
+        // rolls back, unlocks the tables and restores autocommit
+        transactionActive = 1;
+        rollbackTransaction();
+      }
+      else if (!lockTablesQuery.empty())
+      {
+        log_debug("mysql_query(\"UNLOCK TABLES\")");
+        if (::mysql_query(&mysql, "UNLOCK TABLES") != 0)
+          throw MysqlError("mysql_query", &mysql);
+        lockTablesQuery.clear();
+      }
+
+      return true;
+    }
+
     long Connection::lastInsertId(const std::string& name)
     {
       return static_cast<long>(::mysql_insert_id(&mysql));
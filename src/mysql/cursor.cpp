@@ -47,6 +47,7 @@ namespace tntdb
     {
       MYSQL_FIELD* fields = statement->getFields();
       unsigned field_count = row->getSize();
+      row->setColumns(statement->getColumns());
 
       for (unsigned n = 0; n < field_count; ++n)
       {
@@ -71,6 +72,11 @@ namespace tntdb
     }
 
     Row Cursor::fetch()
+    {
+      return next() ? Row(&*row) : Row();
+    }
+
+    bool Cursor::next()
     {
       log_debug("mysql_stmt_fetch(" << stmt << ')');
       int ret = mysql_stmt_fetch(stmt);
@@ -98,12 +104,12 @@ namespace tntdb
       {
         log_debug("MYSQL_NO_DATA");
         row = 0;
-        return Row();
+        return false;
       }
       else if (ret == 1)
         throw MysqlStmtError("mysql_stmt_fetch", stmt);
 
-      return Row(&*row);
+      return true;
     }
   }
 }
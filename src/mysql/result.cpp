@@ -31,6 +31,7 @@
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/connection.h>
 #include <tntdb/mysql/error.h>
+#include <cxxtools/convert.h>
 #include <cxxtools/log.h>
 
 log_define("tntdb.mysql.result")
@@ -59,6 +60,23 @@ namespace tntdb
       }
     }
 
+    const ColumnDescriptor& Result::getColumns() const
+    {
+      if (!columns)
+      {
+        log_debug("mysql_fetch_fields");
+        MYSQL_FIELD* fields = ::mysql_fetch_fields(result);
+
+        cxxtools::SmartPtr<ColumnDescriptor> c = new ColumnDescriptor();
+        c->reserve(field_count);
+        for (size_type n = 0; n < field_count; ++n)
+          c->add(fields[n].name);
+        columns = c;
+      }
+
+      return *columns;
+    }
+
     Row Result::getRow(size_type tup_num) const
     {
       log_debug("mysql_data_seek(" << tup_num << ')');
@@ -71,7 +89,7 @@ namespace tntdb
 
       const IResult* resc = this;
       IResult* res = const_cast<IResult*>(resc);
-      return Row(new ResultRow(tntdb::Result(res), result, row));
+      return Row(new ResultRow(tntdb::Result(res), getColumns(), result, row));
     }
 
     Result::size_type Result::size() const
@@ -84,5 +102,86 @@ namespace tntdb
     {
       return field_count;
     }
+
+    namespace
+    {
+      // Reads the rows sequentially, which avoids the linear seek of
+      // mysql_data_seek for each row.
+      template <typename T>
+      void convertColumn(MYSQL* mysql, MYSQL_RES* result, unsigned field_count,
+        unsigned field_num, std::vector<T>& values, std::vector<bool>& nulls)
+      {
+        if (field_num >= field_count)
+          throw FieldNotFound(cxxtools::convert<std::string>(field_num));
+
+        unsigned n = ::mysql_num_rows(result);
+        values.clear();
+        values.resize(n);
+        nulls.resize(n);
+
+        log_debug("mysql_data_seek(0)");
+        ::mysql_data_seek(result, 0);
+
+        std::string s;
+        for (unsigned row = 0; row < n; ++row)
+        {
+          MYSQL_ROW r = ::mysql_fetch_row(result);
+          if (r == 0)
+            throw MysqlError("mysql_fetch_row", mysql);
+
+          nulls[row] = (r[field_num] == 0);
+          if (!nulls[row])
+          {
+            s.assign(r[field_num], ::mysql_fetch_lengths(result)[field_num]);
+            values[row] = cxxtools::convert<T>(s);
+          }
+        }
+      }
+
+      template <>
+      void convertColumn(MYSQL* mysql, MYSQL_RES* result, unsigned field_count,
+        unsigned field_num, std::vector<std::string>& values, std::vector<bool>& nulls)
+      {
+        if (field_num >= field_count)
+          throw FieldNotFound(cxxtools::convert<std::string>(field_num));
+
+        unsigned n = ::mysql_num_rows(result);
+        values.clear();
+        values.resize(n);
+        nulls.resize(n);
+
+        log_debug("mysql_data_seek(0)");
+        ::mysql_data_seek(result, 0);
+
+        for (unsigned row = 0; row < n; ++row)
+        {
+          MYSQL_ROW r = ::mysql_fetch_row(result);
+          if (r == 0)
+            throw MysqlError("mysql_fetch_row", mysql);
+
+          nulls[row] = (r[field_num] == 0);
+          if (!nulls[row])
+            values[row].assign(r[field_num], ::mysql_fetch_lengths(result)[field_num]);
+        }
+      }
+    }
+
+    void Result::getColumn(size_type field_num, std::vector<int64_t>& values,
+      std::vector<bool>& nulls) const
+    {
+      convertColumn(mysql, result, field_count, field_num, values, nulls);
+    }
+
+    void Result::getColumn(size_type field_num, std::vector<double>& values,
+      std::vector<bool>& nulls) const
+    {
+      convertColumn(mysql, result, field_count, field_num, values, nulls);
+    }
+
+    void Result::getColumn(size_type field_num, std::vector<std::string>& values,
+      std::vector<bool>& nulls) const
+    {
+      convertColumn(mysql, result, field_count, field_num, values, nulls);
+    }
   }
 }
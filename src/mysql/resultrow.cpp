@@ -38,16 +38,18 @@ namespace tntdb
 {
   namespace mysql
   {
-    ResultRow::ResultRow(const tntdb::Result& result_, MYSQL_RES* res,
-      MYSQL_ROW row_)
+    ResultRow::ResultRow(const tntdb::Result& result_,
+      const ColumnDescriptor& columns_, MYSQL_RES* res, MYSQL_ROW row_)
       : result(result_),
-        row(row_)
+        columns(columns_)
     {
       log_debug("mysql_fetch_lengths");
-      lengths = ::mysql_fetch_lengths(res);
+      unsigned long* lengths = ::mysql_fetch_lengths(res);
 
-      log_debug("mysql_fetch_fields");
-      fields = ::mysql_fetch_fields(res);
+      size_type fc = columns.size();
+      values.reserve(fc);
+      for (size_type n = 0; n < fc; ++n)
+        values.add(RowValue(row_, n, lengths[n]));
     }
 
     unsigned ResultRow::size() const
@@ -57,25 +59,57 @@ namespace tntdb
 
     Value ResultRow::getValueByNumber(size_type field_num) const
     {
-      return Value(new RowValue(result, row, field_num, lengths[field_num]));
+      return values.get(field_num, const_cast<ResultRow*>(this));
     }
 
     Value ResultRow::getValueByName(const std::string& field_name) const
     {
-      size_type field_num;
-      for (field_num = 0; field_num < size(); ++field_num)
-        if (fields[field_num].name == field_name)
-          break;
+      return getValueByNumber(columns.getIndex(field_name));
+    }
 
-      if (field_num >= size())
-        throw FieldNotFound(field_name);
+    std::string ResultRow::getColumnName(size_type field_num) const
+    {
+      return columns.getName(field_num);
+    }
 
-      return getValueByNumber(field_num);
+    ResultRow::size_type ResultRow::getColumnIndex(const std::string& field_name) const
+    {
+      return columns.find(field_name);
     }
 
-    std::string ResultRow::getColumnName(size_type field_num) const
+    bool ResultRow::isNull(size_type field_num) const
+    {
+      return values.at(field_num).isNull();
+    }
+
+    bool ResultRow::getBool(size_type field_num) const
+    {
+      return values.at(field_num).getBool();
+    }
+
+    int ResultRow::getInt(size_type field_num) const
+    {
+      return values.at(field_num).getInt();
+    }
+
+    int64_t ResultRow::getInt64(size_type field_num) const
+    {
+      return values.at(field_num).getInt64();
+    }
+
+    uint64_t ResultRow::getUnsigned64(size_type field_num) const
+    {
+      return values.at(field_num).getUnsigned64();
+    }
+
+    double ResultRow::getDouble(size_type field_num) const
+    {
+      return values.at(field_num).getDouble();
+    }
+
+    void ResultRow::getString(size_type field_num, std::string& ret) const
     {
-      return fields[field_num].name;
+      values.at(field_num).getString(ret);
     }
 
   }
@@ -27,7 +27,10 @@
  */
 
 #include <tntdb/mysql/impl/rowcontainer.h>
+#include <tntdb/mysql/impl/boundrow.h>
 #include <tntdb/row.h>
+#include <tntdb/error.h>
+#include <cxxtools/convert.h>
 #include <cxxtools/log.h>
 
 namespace tntdb
@@ -49,5 +52,62 @@ namespace tntdb
     {
       return rows.empty() ? 0 : (*rows.begin())->size();
     }
+
+    namespace
+    {
+      // The rows are BoundRows filled by Statement::select, so the values
+      // are read directly from the bound buffers.
+      template <typename T>
+      void readColumn(const std::vector<cxxtools::SmartPtr<IRow> >& rows,
+        unsigned field_num, std::vector<T>& values, std::vector<bool>& nulls,
+        T (BindValues::*getter)(unsigned) const)
+      {
+        values.clear();
+        values.resize(rows.size());
+        nulls.resize(rows.size());
+
+        for (unsigned row = 0; row < rows.size(); ++row)
+        {
+          const BoundRow* r = static_cast<const BoundRow*>(rows[row].getPointer());
+          if (field_num >= r->getSize())
+            throw FieldNotFound(cxxtools::convert<std::string>(field_num));
+
+          nulls[row] = r->isNull(field_num);
+          if (!nulls[row])
+            values[row] = (r->*getter)(field_num);
+        }
+      }
+    }
+
+    void RowContainer::getColumn(size_type field_num, std::vector<int64_t>& values,
+      std::vector<bool>& nulls) const
+    {
+      readColumn(rows, field_num, values, nulls, &BindValues::getInt64);
+    }
+
+    void RowContainer::getColumn(size_type field_num, std::vector<double>& values,
+      std::vector<bool>& nulls) const
+    {
+      readColumn(rows, field_num, values, nulls, &BindValues::getDouble);
+    }
+
+    void RowContainer::getColumn(size_type field_num, std::vector<std::string>& values,
+      std::vector<bool>& nulls) const
+    {
+      values.clear();
+      values.resize(rows.size());
+      nulls.resize(rows.size());
+
+      for (unsigned row = 0; row < rows.size(); ++row)
+      {
+        const BoundRow* r = static_cast<const BoundRow*>(rows[row].getPointer());
+        if (field_num >= r->getSize())
+          throw FieldNotFound(cxxtools::convert<std::string>(field_num));
+
+        nulls[row] = r->isNull(field_num);
+        if (!nulls[row])
+          r->getString(field_num, values[row]);
+      }
+    }
   }
 }
@@ -173,17 +173,17 @@ namespace tntdb
 
     Date RowValue::getDate() const
     {
-      return Date::fromIso(getString());
+      return Date::fromIso(row[col], len);
     }
 
     Time RowValue::getTime() const
     {
-      return Time::fromIso(getString());
+      return Time::fromIso(row[col], len);
     }
 
     Datetime RowValue::getDatetime() const
     {
-      return Datetime::fromIso(getString());
+      return Datetime::fromIso(row[col], len);
     }
 
   }
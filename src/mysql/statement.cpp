@@ -37,7 +37,10 @@
 #include <tntdb/time.h>
 #include <tntdb/datetime.h>
 #include <tntdb/mysql/error.h>
-#include <tntdb/stmtparser.h>
+#include <tntdb/batch.h>
+#include <tntdb/rowvisitor.h>
+#include <algorithm>
+#include <cctype>
 #include <sstream>
 #include <cxxtools/log.h>
 
@@ -47,33 +50,73 @@ namespace tntdb
 {
   namespace mysql
   {
-    typedef std::multimap<std::string, unsigned> hostvarMapType;
-
     namespace
     {
-      class SE : public StmtEvent
-      {
-          hostvarMapType& hostvarMap;
-          unsigned idx;
-          static const std::string hostvarInd;
-
-        public:
-          SE(hostvarMapType& hostvarMap_)
-            : hostvarMap(hostvarMap_),
-              idx(0)
-            { }
-          std::string onHostVar(const std::string& name);
-          unsigned getCount() const  { return idx; }
-      };
-
-      std::string SE::onHostVar(const std::string& name)
+      // Splits a query ending with "values (...)" into the text before the
+      // value list and the list itself. The list must contain all
+      // placeholders of the query, so that it can be repeated for each row.
+      bool splitValues(const std::string& sql, unsigned placeholders,
+        std::string& head, std::string& tuple)
       {
-        log_debug("hostvar :" << name << ", idx=" << idx);
-        hostvarMap.insert(hostvarMapType::value_type(name, idx++));
-        return hostvarInd;
+        std::string::size_type e = sql.find_last_not_of(" \t\r\n;");
+        if (e == std::string::npos || sql[e] != ')')
+          return false;
+
+        std::string::size_type b = e;
+        unsigned depth = 1;
+        while (depth > 0 && b > 0)
+        {
+          char ch = sql[--b];
+          if (ch == '\'' || ch == '"' || ch == '`')
+            return false;
+          else if (ch == ')')
+            ++depth;
+          else if (ch == '(')
+            --depth;
+        }
+
+        if (depth > 0 || b == 0)
+          return false;
+
+        std::string::size_type k = sql.find_last_not_of(" \t\r\n", b - 1);
+        if (k == std::string::npos || k < 5)
+          return false;
+
+        static const char values[] = "values";
+        for (unsigned n = 0; n < 6; ++n)
+          if (std::tolower(static_cast<unsigned char>(sql[k - 5 + n])) != values[n])
+            return false;
+
+        if (k > 5 && (std::isalnum(static_cast<unsigned char>(sql[k - 6])) || sql[k - 6] == '_'))
+          return false;
+
+        if (static_cast<unsigned>(std::count(sql.begin(), sql.end(), '?')) != placeholders
+          || static_cast<unsigned>(std::count(sql.begin() + b, sql.begin() + e, '?')) != placeholders)
+          return false;
+
+        head.assign(sql, 0, b);
+        tuple.assign(sql, b, e - b + 1);
+        return true;
       }
 
-      const std::string SE::hostvarInd = "?";
+      void setBatchValue(BindValues& vars, unsigned n, const Batch& batch,
+        Batch::size_type col, Batch::size_type row)
+      {
+        switch (batch.getType(col, row))
+        {
+          case Batch::NULLVALUE:  vars.setNull(n); break;
+          case Batch::BOOL:       vars.setBool(n, batch.getBool(col, row)); break;
+          case Batch::INT64:      vars.setInt64(n, batch.getInt64(col, row)); break;
+          case Batch::UNSIGNED64: vars.setUnsigned64(n, batch.getUnsigned64(col, row)); break;
+          case Batch::DOUBLE:     vars.setDouble(n, batch.getDouble(col, row)); break;
+          case Batch::STRING:     vars.setString(n, batch.getString(col, row)); break;
+          case Batch::DECIMAL:    vars.setDecimal(n, batch.getDecimal(col, row)); break;
+          case Batch::BLOB:       vars.setBlob(n, batch.getBlob(col, row)); break;
+          case Batch::DATE:       vars.setDate(n, batch.getDate(col, row)); break;
+          case Batch::TIME:       vars.setTime(n, batch.getTime(col, row)); break;
+          case Batch::DATETIME:   vars.setDatetime(n, batch.getDatetime(col, row)); break;
+        }
+      }
     }
 
     cxxtools::SmartPtr<BoundRow> Statement::getRow()
@@ -87,6 +130,7 @@ namespace tntdb
       getFields();
 
       rowPtr = new BoundRow(field_count);
+      rowPtr->setColumns(columns.getPointer());
 
       for (unsigned n = 0; n < field_count; ++n)
       {
@@ -140,20 +184,13 @@ namespace tntdb
     Statement::Statement(Connection* conn_, MYSQL* mysql_,
       const std::string& query_)
       : conn(conn_),
+        parsed(ParsedStmt::get(query_, ParsedStmt::QUESTIONMARK)),
         mysql(mysql_),
         stmt(0),
         fields(0),
         field_count(0)
     {
-      // parse hostvars
-      StmtParser parser;
-      SE se(hostvarMap);
-      parser.parse(query_, se);
-
-      log_debug("sql=\"" << parser.getSql() << "\" invars " << se.getCount());
-
-      query = parser.getSql();
-      inVars.setSize(se.getCount());
+      inVars.setSize(parsed->getPlaceholderCount());
     }
 
     Statement::~Statement()
@@ -168,356 +205,250 @@ namespace tntdb
     void Statement::clear()
     {
       log_debug("statement " << stmt << " clear()");
-      for (hostvarMapType::const_iterator it = hostvarMap.begin();
-           it != hostvarMap.end(); ++it)
-        inVars.setNull(it->second);
+      for (paramsType::const_iterator it = params().begin(); it != params().end(); ++it)
+        for (positionsType::const_iterator p = it->begin(); p != it->end(); ++p)
+          inVars.setNull(*p);
     }
 
-    void Statement::setNull(const std::string& col)
+    Statement::size_type Statement::paramIndex(const std::string& col)
     {
-      log_debug("statement " << stmt << " setNull(\"" << col << "\")");
-
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setNull(it->second);
-      }
-
-      if (!found)
+      size_type idx = findParam(col);
+      if (idx == npos)
         log_warn("hostvar \"" << col << "\" not found");
+      return idx;
     }
 
-    void Statement::setBool(const std::string& col, bool data)
+    Statement::size_type Statement::findParam(const std::string& col)
     {
-      log_debug("statement " << stmt << " setBool(\"" << col << "\", " << data << ')');
+      hostvarMapType::const_iterator it = parsed->getHostvarMap().find(col);
+      return it == parsed->getHostvarMap().end() ? npos : it->second;
+    }
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setBool(it->second, data);
-      }
+    void Statement::setNull(size_type idx)
+    {
+      log_debug("statement " << stmt << " setNull(" << idx << ")");
 
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setNull(*it);
     }
 
-    void Statement::setShort(const std::string& col, short data)
+    void Statement::setBool(size_type idx, bool data)
     {
-      log_debug("statement " << stmt << " setShort(\"" << col << "\", " << data << ')');
+      log_debug("statement " << stmt << " setBool(" << idx << ", " << data << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setShort(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setBool(*it, data);
     }
 
-    void Statement::setInt(const std::string& col, int data)
+    void Statement::setShort(size_type idx, short data)
     {
-      log_debug("statement " << stmt << " setInt(\"" << col << "\", " << data << ')');
+      log_debug("statement " << stmt << " setShort(" << idx << ", " << data << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setInt(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setShort(*it, data);
     }
 
-    void Statement::setLong(const std::string& col, long data)
+    void Statement::setInt(size_type idx, int data)
     {
-      log_debug("statement " << stmt << " setLong(\"" << col << "\", " << data << ')');
+      log_debug("statement " << stmt << " setInt(" << idx << ", " << data << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setLong(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setInt(*it, data);
     }
 
-    void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+    void Statement::setLong(size_type idx, long data)
     {
-      log_debug("statement " << stmt << " setUnsignedShort(\"" << col << "\", " << data << ')');
+      log_debug("statement " << stmt << " setLong(" << idx << ", " << data << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setUnsignedShort(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setLong(*it, data);
     }
 
-    void Statement::setUnsigned(const std::string& col, unsigned data)
+    void Statement::setUnsignedShort(size_type idx, unsigned short data)
     {
-      log_debug("statement " << stmt << " setUnsigned(\"" << col << "\", " << data << ')');
-
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setUnsigned(it->second, data);
-      }
+      log_debug("statement " << stmt << " setUnsignedShort(" << idx << ", " << data << ')');
 
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setUnsignedShort(*it, data);
     }
 
-    void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+    void Statement::setUnsigned(size_type idx, unsigned data)
     {
-      log_debug("statement " << stmt << " setUnsignedLong(\"" << col << "\", " << data << ')');
-
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setUnsignedLong(it->second, data);
-      }
+      log_debug("statement " << stmt << " setUnsigned(" << idx << ", " << data << ')');
 
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setUnsigned(*it, data);
     }
 
-    void Statement::setInt32(const std::string& col, int32_t data)
+    void Statement::setUnsignedLong(size_type idx, unsigned long data)
     {
-      log_debug("statement " << stmt << " setInt32(\"" << col << "\", " << data << ')');
+      log_debug("statement " << stmt << " setUnsignedLong(" << idx << ", " << data << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setInt32(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setUnsignedLong(*it, data);
     }
 
-    void Statement::setUnsigned32(const std::string& col, uint32_t data)
+    void Statement::setInt32(size_type idx, int32_t data)
     {
-      log_debug("statement " << stmt << " setUnsigned32(\"" << col << "\", " << data << ')');
+      log_debug("statement " << stmt << " setInt32(" << idx << ", " << data << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setUnsigned32(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setInt32(*it, data);
     }
 
-    void Statement::setInt64(const std::string& col, int64_t data)
+    void Statement::setUnsigned32(size_type idx, uint32_t data)
     {
-      log_debug("statement " << stmt << " setInt64(\"" << col << "\", " << data << ')');
+      log_debug("statement " << stmt << " setUnsigned32(" << idx << ", " << data << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setInt64(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setUnsigned32(*it, data);
     }
 
-    void Statement::setUnsigned64(const std::string& col, uint64_t data)
+    void Statement::setInt64(size_type idx, int64_t data)
     {
-      log_debug("statement " << stmt << " setUnsigned64(\"" << col << "\", " << data << ')');
-
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setUnsigned64(it->second, data);
-      }
+      log_debug("statement " << stmt << " setInt64(" << idx << ", " << data << ')');
 
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setInt64(*it, data);
     }
 
-    void Statement::setDecimal(const std::string& col, const Decimal& data)
+    void Statement::setUnsigned64(size_type idx, uint64_t data)
     {
-      log_debug("statement " << stmt << " setDecimal(\"" << col << "\", " << data << ')');
+      log_debug("statement " << stmt << " setUnsigned64(" << idx << ", " << data << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setDecimal(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setUnsigned64(*it, data);
     }
 
-    void Statement::setFloat(const std::string& col, float data)
+    void Statement::setDecimal(size_type idx, const Decimal& data)
     {
-      log_debug("statement " << stmt << " setFloat(\"" << col << "\", " << data << ')');
-
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setFloat(it->second, data);
-      }
+      log_debug("statement " << stmt << " setDecimal(" << idx << ", " << data << ')');
 
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setDecimal(*it, data);
     }
 
-    void Statement::setDouble(const std::string& col, double data)
+    void Statement::setFloat(size_type idx, float data)
     {
-      log_debug("statement " << stmt << " setDouble(\"" << col << "\", " << data << ')');
+      log_debug("statement " << stmt << " setFloat(" << idx << ", " << data << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setDouble(it->second, data);
-      }
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setFloat(*it, data);
+    }
 
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+    void Statement::setDouble(size_type idx, double data)
+    {
+      log_debug("statement " << stmt << " setDouble(" << idx << ", " << data << ')');
+
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setDouble(*it, data);
     }
 
-    void Statement::setChar(const std::string& col, char data)
+    void Statement::setChar(size_type idx, char data)
     {
-      log_debug("statement " << stmt << " setChar(\"" << col << "\", " << data << ')');
+      log_debug("statement " << stmt << " setChar(" << idx << ", " << data << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setChar(it->second, data);
-      }
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setChar(*it, data);
+    }
 
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+    void Statement::setString(size_type idx, const std::string& data)
+    {
+      log_debug("statement " << stmt << " setString(" << idx << ", \"" << data << "\")");
+
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setString(*it, data);
     }
 
-    void Statement::setString(const std::string& col, const std::string& data)
+    void Statement::setBlob(size_type idx, const Blob& data)
     {
-      log_debug("statement " << stmt << " setString(\"" << col << "\", \"" << data << "\")");
+      log_debug("statement " << stmt << " setBlob(" << idx << ", data {" << data.size() << "})");
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setString(it->second, data);
-      }
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setBlob(*it, data);
+    }
 
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+    void Statement::setString(size_type idx, const char* data, std::size_t length)
+    {
+      log_debug("statement " << stmt << " setString(" << idx << ", \"" << std::string(data, length) << "\")");
+
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setString(*it, data, length);
     }
 
-    void Statement::setBlob(const std::string& col, const Blob& data)
+    void Statement::setStringRef(size_type idx, const char* data, std::size_t length)
     {
-      log_debug("statement " << stmt << " setBlob(\"" << col << "\", data {" << data.size() << "})");
+      log_debug("statement " << stmt << " setStringRef(" << idx << ", data {" << length << "})");
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setBlob(it->second, data);
-      }
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setStringRef(*it, data, length);
+    }
 
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+    void Statement::setBlobRef(size_type idx, const char* data, std::size_t length)
+    {
+      log_debug("statement " << stmt << " setBlobRef(" << idx << ", data {" << length << "})");
+
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setStringRef(*it, data, length);
     }
 
-    void Statement::setDate(const std::string& col, const Date& data)
+    void Statement::setDate(size_type idx, const Date& data)
     {
-      log_debug("statement " << stmt << " setDate(\"" << col << "\", "
+      log_debug("statement " << stmt << " setDate(" << idx << ", "
         << data.getIso() << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setDate(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setDate(*it, data);
     }
 
-    void Statement::setTime(const std::string& col, const Time& data)
+    void Statement::setTime(size_type idx, const Time& data)
     {
-      log_debug("statement " << stmt << " setTime(\"" << col << "\", "
+      log_debug("statement " << stmt << " setTime(" << idx << ", "
         << data.getIso() << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setTime(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setTime(*it, data);
     }
 
-    void Statement::setDatetime(const std::string& col, const Datetime& data)
+    void Statement::setDatetime(size_type idx, const Datetime& data)
     {
-      log_debug("statement " << stmt << " setDatetime(\"" << col << "\", "
+      log_debug("statement " << stmt << " setDatetime(" << idx << ", "
         << data.getIso() << ')');
 
-      bool found = false;
-      for (hostvarMapType::const_iterator it = hostvarMap.find(col);
-           it != hostvarMap.end() && it->first == col; ++it)
-      {
-        found = true;
-        inVars.setDatetime(it->second, data);
-      }
-
-      if (!found)
-        log_warn("hostvar \"" << col << "\" not found");
+      if (idx < params().size())
+        for (positionsType::const_iterator it = params()[idx].begin(); it != params()[idx].end(); ++it)
+          inVars.setDatetime(*it, data);
     }
 
     Statement::size_type Statement::execute()
     {
       log_debug("execute statement " << stmt);
-      if (hostvarMap.empty())
+      if (params().empty())
       {
-        return conn->execute(query);
+        return conn->execute(parsed->getSql());
       }
       else
       {
@@ -532,8 +463,8 @@ namespace tntdb
     {
       log_debug("select");
 
-      if (hostvarMap.empty())
-        return conn->select(query);
+      if (params().empty())
+        return conn->select(parsed->getSql());
 
       if (fields)
         getRow();
@@ -558,8 +489,8 @@ namespace tntdb
     {
       log_debug("selectRow");
 
-      if (hostvarMap.empty())
-        return conn->selectRow(query);
+      if (params().empty())
+        return conn->selectRow(parsed->getSql());
 
       if (fields)
         getRow();
@@ -593,6 +524,152 @@ namespace tntdb
       return new Cursor(this, fetchsize);
     }
 
+    Statement::size_type Statement::forEach(RowVisitor& visitor, unsigned fetchsize)
+    {
+      cxxtools::SmartPtr<Cursor> cursor(new Cursor(this, fetchsize));
+
+      // mysql_stmt_fetch writes each row into the buffers of the bound row
+      Row row(cursor->getBoundRow());
+
+      size_type count = 0;
+      while (cursor->next())
+      {
+        visitor.visit(row);
+        ++count;
+      }
+
+      return count;
+    }
+
+    void Statement::prepare()
+    {
+      if (stmt == 0)
+        stmt = getStmt();
+    }
+
+    // An INSERT or REPLACE ending with a values list is rewritten to insert
+    // many rows with one statement:
+    //   insert into t(a, b) values (?, ?), (?, ?), ...
+    // Other statements are executed row by row. When a multi row statement
+    // fails, its rows are executed one by one to find the failing row.
+    Statement::size_type Statement::executeBatch(const Batch& batch)
+    {
+      // mysql allows at most 65535 placeholders in one statement
+      static const Batch::size_type maxRows = 1000;
+      static const unsigned maxPlaceholders = 65535;
+
+      Batch::size_type rows = batch.getRowCount();
+      unsigned placeholders = parsed->getPlaceholderCount();
+      std::string head;
+      std::string tuple;
+
+      if (rows < 2 || placeholders == 0 || placeholders > maxPlaceholders / 2
+        || !splitValues(parsed->getSql(), placeholders, head, tuple))
+        return IStatement::executeBatch(batch);
+
+      // all host variables must be taken from the batch
+      std::vector<size_type> idx;
+      batch.paramIndexes(*this, idx);
+      std::vector<bool> covered(params().size());
+      for (std::vector<size_type>::const_iterator it = idx.begin(); it != idx.end(); ++it)
+        if (*it != npos)
+          covered[*it] = true;
+      if (std::find(covered.begin(), covered.end(), false) != covered.end())
+        return IStatement::executeBatch(batch);
+
+      Batch::size_type chunkRows = std::min(maxRows, maxPlaceholders / placeholders);
+
+      size_type count = 0;
+      BindValues vars;
+      MYSQL_STMT* batchStmt = 0;
+      Batch::size_type batchStmtRows = 0;
+
+      try
+      {
+        for (Batch::size_type first = 0; first < rows; first += batchStmtRows)
+        {
+          Batch::size_type n = std::min(chunkRows, rows - first);
+          if (n != batchStmtRows)
+          {
+            if (batchStmt)
+            {
+              log_debug("mysql_stmt_close(" << batchStmt << ')');
+              ::mysql_stmt_close(batchStmt);
+              batchStmt = 0;
+            }
+
+            std::string sql = head;
+            sql.reserve(head.size() + n * (tuple.size() + 1));
+            for (Batch::size_type r = 0; r < n; ++r)
+            {
+              if (r > 0)
+                sql += ',';
+              sql += tuple;
+            }
+
+            log_debug("mysql_stmt_init(" << mysql << ')');
+            batchStmt = ::mysql_stmt_init(mysql);
+            if (batchStmt == 0)
+              throw MysqlError(mysql);
+
+            log_debug("mysql_stmt_prepare(" << batchStmt << ", \"" << head << tuple << "\" * " << n << ')');
+            if (mysql_stmt_prepare(batchStmt, sql.data(), sql.size()) != 0)
+              throw MysqlStmtError("mysql_stmt_prepare", batchStmt);
+
+            batchStmtRows = n;
+            vars.setSize(n * placeholders);
+          }
+
+          for (Batch::size_type r = 0; r < n; ++r)
+            for (Batch::size_type col = 0; col < idx.size(); ++col)
+              if (idx[col] != npos)
+                for (positionsType::const_iterator it = params()[idx[col]].begin(); it != params()[idx[col]].end(); ++it)
+                  setBatchValue(vars, r * placeholders + *it, batch, col, first + r);
+
+          log_debug("mysql_stmt_bind_param(" << batchStmt << ')');
+          if (mysql_stmt_bind_param(batchStmt, vars.getMysqlBind()) != 0)
+            throw MysqlStmtError("mysql_stmt_bind_param", batchStmt);
+
+          log_debug("mysql_stmt_execute(" << batchStmt << ") rows " << first << '-' << (first + n - 1));
+          if (mysql_stmt_execute(batchStmt) == 0)
+            count += mysql_stmt_affected_rows(batchStmt);
+          else
+          {
+            log_debug("rows " << first << '-' << (first + n - 1) << " failed: "
+              << ::mysql_stmt_error(batchStmt) << "; execute them one by one");
+
+            // the failed statement wrote nothing, since it is atomic
+            for (Batch::size_type r = first; r < first + n; ++r)
+            {
+              batch.bindRow(*this, idx, r);
+              try
+              {
+                count += execute();
+              }
+              catch (const std::exception& e)
+              {
+                throw BatchError(r, e.what(), count);
+              }
+            }
+          }
+        }
+      }
+      catch (const std::exception&)
+      {
+        if (batchStmt)
+        {
+          log_debug("mysql_stmt_close(" << batchStmt << ')');
+          ::mysql_stmt_close(batchStmt);
+        }
+        throw;
+      }
+
+      log_debug("mysql_stmt_close(" << batchStmt << ')');
+      ::mysql_stmt_close(batchStmt);
+
+      return count;
+    }
+
     MYSQL_STMT* Statement::getStmt()
     {
       MYSQL_STMT* ret;
@@ -611,8 +688,8 @@ namespace tntdb
         throw MysqlError(mysql);
       log_debug("mysql_stmt_init(" << mysql << ") => " << ret);
 
-      log_debug("mysql_stmt_prepare(" << ret << ", \"" << query << "\")");
-      if (mysql_stmt_prepare(ret, query.data(), query.size()) != 0)
+      log_debug("mysql_stmt_prepare(" << ret << ", \"" << parsed->getSql() << "\")");
+      if (mysql_stmt_prepare(ret, parsed->getSql().data(), parsed->getSql().size()) != 0)
       {
         // MysqlStmtError fetches the last error from MYSQL_STMT, so we need
         // to instantiate this before mysql_stmt_close
@@ -706,6 +783,11 @@ namespace tntdb
         log_debug("mysql_num_fields(" << metadata << ')');
         field_count = mysql_num_fields(metadata);
 
+        columns = new ColumnDescriptor();
+        columns->reserve(field_count);
+        for (unsigned n = 0; n < field_count; ++n)
+          columns->add(fields[n].name);
+
         log_debug("mysql_free_result(" << metadata << ") (metadata)");
         ::mysql_free_result(metadata);
       }
@@ -719,5 +801,11 @@ namespace tntdb
       return field_count;
     }
 
+    ColumnDescriptor* Statement::getColumns()
+    {
+      getFields();
+      return columns.getPointer();
+    }
+
   }
 }
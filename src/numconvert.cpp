@@ -0,0 +1,380 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/impl/numconvert.h>
+#include <tntdb/error.h>
+#include <stdio.h>
+#include <cstring>
+#include <sstream>
+#include <locale>
+
+namespace tntdb
+{
+  namespace
+  {
+    bool isSpace(char ch)
+    {
+      return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r'
+          || ch == '\f' || ch == '\v';
+    }
+
+    bool isDigit(char ch)
+    {
+      return ch >= '0' && ch <= '9';
+    }
+
+    // removes leading and trailing white space
+    void trim(const char*& b, const char*& e)
+    {
+      while (b != e && isSpace(*b))
+        ++b;
+      while (e != b && isSpace(*(e - 1)))
+        --e;
+    }
+
+    // parses the optional sign and the digits of a integer into its magnitude
+    bool parseMagnitude(const char* s, std::size_t len, bool& negative, uint64_t& ret)
+    {
+      const char* b = s;
+      const char* e = s + len;
+      trim(b, e);
+
+      negative = false;
+      if (b != e && (*b == '-' || *b == '+'))
+        negative = (*b++ == '-');
+
+      if (b == e)
+        return false;
+
+      const uint64_t max = std::numeric_limits<uint64_t>::max();
+      uint64_t v = 0;
+      for ( ; b != e; ++b)
+      {
+        if (!isDigit(*b))
+          return false;
+
+        unsigned d = *b - '0';
+        if (v > (max - d) / 10)
+          return false;  // overflow
+
+        v = v * 10 + d;
+      }
+
+      ret = v;
+      return true;
+    }
+
+    bool equalsIgnoreCase(const char* b, const char* e, const char* s)
+    {
+      for ( ; b != e && *s; ++b, ++s)
+        if ((*b | 0x20) != *s)
+          return false;
+      return b == e && *s == '\0';
+    }
+
+    // slow path for numbers, which can't be converted exactly with doubles
+    bool parseDoubleClassic(const char* b, const char* e, double& ret)
+    {
+      std::istringstream in(std::string(b, e));
+      in.imbue(std::locale::classic());
+      double v;
+      in >> v;
+      if (in.fail() || in.get() != std::istringstream::traits_type::eof())
+        return false;
+      ret = v;
+      return true;
+    }
+
+    // replaces a locale specific decimal point written by snprintf
+    void fixDecimalPoint(char* buf, std::size_t n)
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        if (!isDigit(buf[i]) && buf[i] != '-' && buf[i] != '+'
+            && buf[i] != 'e' && buf[i] != 'E')
+          buf[i] = '.';
+    }
+
+    std::size_t formatSpecial(double value, char* buf)
+    {
+      const char* s = value != value ? "nan"
+                    : value > 0 ? "inf"
+                    : "-inf";
+      std::size_t n = std::strlen(s);
+      std::memcpy(buf, s, n);
+      return n;
+    }
+
+    bool isSpecial(double value)
+    {
+      return value != value
+          || value > std::numeric_limits<double>::max()
+          || value < -std::numeric_limits<double>::max();
+    }
+  }
+
+  bool parseInt64(const char* s, std::size_t len, int64_t& ret)
+  {
+    bool negative;
+    uint64_t v;
+    if (!parseMagnitude(s, len, negative, v))
+      return false;
+
+    const uint64_t max = static_cast<uint64_t>(std::numeric_limits<int64_t>::max());
+    if (negative)
+    {
+      if (v > max + 1)
+        return false;
+      ret = v == max + 1 ? std::numeric_limits<int64_t>::min()
+                         : -static_cast<int64_t>(v);
+    }
+    else
+    {
+      if (v > max)
+        return false;
+      ret = static_cast<int64_t>(v);
+    }
+
+    return true;
+  }
+
+  bool parseUnsigned64(const char* s, std::size_t len, uint64_t& ret)
+  {
+    bool negative;
+    uint64_t v;
+    if (!parseMagnitude(s, len, negative, v) || (negative && v != 0))
+      return false;
+    ret = v;
+    return true;
+  }
+
+  bool parseDouble(const char* s, std::size_t len, double& ret)
+  {
+    static const double pow10[] = {
+      1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+    const char* b = s;
+    const char* e = s + len;
+    trim(b, e);
+
+    const char* p = b;
+    bool negative = false;
+    if (p != e && (*p == '-' || *p == '+'))
+      negative = (*p++ == '-');
+
+    if (equalsIgnoreCase(p, e, "nan"))
+    {
+      ret = std::numeric_limits<double>::quiet_NaN();
+      return true;
+    }
+
+    if (equalsIgnoreCase(p, e, "inf") || equalsIgnoreCase(p, e, "infinity"))
+    {
+      ret = negative ? -std::numeric_limits<double>::infinity()
+                     : std::numeric_limits<double>::infinity();
+      return true;
+    }
+
+    // collect up to 19 significant digits in a integer and a decimal exponent
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool anyDigit = false;
+    bool truncated = false;
+
+    for ( ; p != e && isDigit(*p); ++p)
+    {
+      anyDigit = true;
+      if (digits < 19)
+      {
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa != 0)
+          ++digits;
+      }
+      else
+      {
+        ++exponent;
+        truncated = truncated || *p != '0';
+      }
+    }
+
+    if (p != e && *p == '.')
+    {
+      for (++p; p != e && isDigit(*p); ++p)
+      {
+        anyDigit = true;
+        if (digits < 19)
+        {
+          mantissa = mantissa * 10 + (*p - '0');
+          if (mantissa != 0)
+            ++digits;
+          --exponent;
+        }
+        else
+          truncated = truncated || *p != '0';
+      }
+    }
+
+    if (!anyDigit)
+      return false;
+
+    if (p != e && (*p == 'e' || *p == 'E'))
+    {
+      ++p;
+      bool expNegative = false;
+      if (p != e && (*p == '-' || *p == '+'))
+        expNegative = (*p++ == '-');
+
+      if (p == e)
+        return false;
+
+      int exp = 0;
+      for ( ; p != e && isDigit(*p); ++p)
+        if (exp < 100000)
+          exp = exp * 10 + (*p - '0');
+
+      exponent += expNegative ? -exp : exp;
+    }
+
+    if (p != e)
+      return false;
+
+    // Both the mantissa and the power of 10 are exact in a double, so a
+    // single multiplication or division gives the correctly rounded result.
+    if (!truncated && mantissa <= (uint64_t(1) << 53)
+        && exponent >= -22 && exponent <= 22)
+    {
+      double v = static_cast<double>(mantissa);
+      if (exponent < 0)
+        v /= pow10[-exponent];
+      else
+        v *= pow10[exponent];
+      ret = negative ? -v : v;
+      return true;
+    }
+
+    return parseDoubleClassic(b, e, ret);
+  }
+
+  bool parseFloat(const char* s, std::size_t len, float& ret)
+  {
+    double v;
+    if (!parseDouble(s, len, v))
+      return false;
+
+    if (!isSpecial(v)
+      && (v > std::numeric_limits<float>::max() || v < -std::numeric_limits<float>::max()))
+      return false;
+
+    ret = static_cast<float>(v);
+    return true;
+  }
+
+  std::size_t formatUnsigned64(uint64_t value, char* buf)
+  {
+    char tmp[20];
+    char* p = tmp + sizeof(tmp);
+    do
+    {
+      *--p = static_cast<char>('0' + value % 10);
+      value /= 10;
+    } while (value != 0);
+
+    std::size_t n = tmp + sizeof(tmp) - p;
+    std::memcpy(buf, p, n);
+    return n;
+  }
+
+  std::size_t formatInt64(int64_t value, char* buf)
+  {
+    if (value >= 0)
+      return formatUnsigned64(static_cast<uint64_t>(value), buf);
+
+    buf[0] = '-';
+    return formatUnsigned64(uint64_t(0) - static_cast<uint64_t>(value), buf + 1) + 1;
+  }
+
+  std::size_t formatDouble(double value, char* buf)
+  {
+    if (isSpecial(value))
+      return formatSpecial(value, buf);
+
+    // integral values are written without snprintf
+    if (value != 0 && value > -1e15 && value < 1e15
+      && value == static_cast<double>(static_cast<int64_t>(value)))
+      return formatInt64(static_cast<int64_t>(value), buf);
+
+    int n = 0;
+    for (int precision = 15; precision <= 17; ++precision)
+    {
+      n = ::snprintf(buf, numberBufferSize, "%.*g", precision, value);
+      fixDecimalPoint(buf, n);
+
+      double v;
+      if (parseDouble(buf, n, v) && v == value)
+        break;
+    }
+
+    return n;
+  }
+
+  std::size_t formatFloat(float value, char* buf)
+  {
+    if (isSpecial(value))
+      return formatSpecial(value, buf);
+
+    if (value != 0 && value > -1e7f && value < 1e7f
+      && value == static_cast<float>(static_cast<int64_t>(value)))
+      return formatInt64(static_cast<int64_t>(value), buf);
+
+    int n = 0;
+    for (int precision = 6; precision <= 9; ++precision)
+    {
+      n = ::snprintf(buf, numberBufferSize, "%.*g", precision, static_cast<double>(value));
+      fixDecimalPoint(buf, n);
+
+      float v;
+      if (parseFloat(buf, n, v) && v == value)
+        break;
+    }
+
+    return n;
+  }
+
+  namespace numconvert
+  {
+    void throwConversionError(const char* s, std::size_t len, const char* tname)
+    {
+      std::string msg = "can't convert \"";
+      msg.append(s, len);
+      msg += "\" to ";
+      msg += tname;
+      throw TypeError(msg);
+    }
+  }
+}
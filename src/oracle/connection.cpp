@@ -350,6 +350,23 @@ namespace tntdb
       }
     }
 
+    bool Connection::isAlive()
+    {
+      // database connection is not valid any more after a fork
+      return envhp != 0 && pid == getpid();
+    }
+
+    bool Connection::reset()
+    {
+      if (transactionActive > 0)
+      {
+        transactionActive = 1;
+        rollbackTransaction();
+      }
+
+      return true;
+    }
+
     long Connection::lastInsertId(const std::string& name)
     {
       tntdb::Statement stmt;
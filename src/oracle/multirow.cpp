@@ -48,6 +48,8 @@ namespace tntdb
       _columns.resize(columncount);
       for (ub4 pos = 0; pos < columncount; ++pos)
         _columns[pos] = new MultiValue(stmt, pos, rowcount);
+
+      initDescriptor();
     }
 
     MultiRow::MultiRow(Statement* stmt, unsigned rowcount, unsigned columncount)
@@ -56,6 +58,15 @@ namespace tntdb
       _columns.resize(columncount);
       for (ub4 pos = 0; pos < columncount; ++pos)
         _columns[pos] = new MultiValue(stmt, pos, rowcount);
+
+      initDescriptor();
+    }
+
+    void MultiRow::initDescriptor()
+    {
+      _descriptor.reserve(_columns.size());
+      for (Columns::size_type i = 0; i < _columns.size(); ++i)
+        _descriptor.add(_columns[i]->getColumnName());
     }
 
     MultiValue::Ptr MultiRow::getValuesByNumber(unsigned field_num) const
@@ -69,6 +80,15 @@ namespace tntdb
     }
 
     MultiRow::Columns::size_type MultiRow::getColIndexByName(const std::string& field_name) const
+    {
+      Columns::size_type i = findColIndexByName(field_name);
+      if (i == ColumnDescriptor::npos)
+        throw FieldNotFound(field_name);
+
+      return i;
+    }
+
+    MultiRow::Columns::size_type MultiRow::findColIndexByName(const std::string& field_name) const
     {
       std::string field_name_upper;
       field_name_upper.reserve(field_name.size());
@@ -76,15 +96,7 @@ namespace tntdb
         it != field_name.end(); ++it)
           field_name_upper += std::toupper(*it);
 
-      Columns::size_type i;
-      for (i = 0; i < _columns.size(); ++i)
-        if (_columns[i]->getColumnName() == field_name_upper)
-          break;
-
-      if (i == _columns.size())
-        throw FieldNotFound(field_name);
-
-      return i;
+      return _descriptor.find(field_name_upper);
     }
 
     std::string MultiRow::getColumnName(unsigned field_num) const
@@ -105,6 +105,9 @@ namespace tntdb
           rows.push_back(tntdb::Row(new SingleRow(mr, n)));
         }
 
+        if (rowsFetched > 0)
+          blocks.push_back(BlocksType::value_type(mr, rowsFetched));
+
         if (rowsFetched < fetchsize)
           return;
 
@@ -130,5 +133,70 @@ namespace tntdb
       return columncount;
     }
 
+    template <typename T>
+    void Result::readColumn(size_type field_num, std::vector<T>& values,
+      std::vector<bool>& nulls, T (MultiValue::*getter)(unsigned) const) const
+    {
+      values.clear();
+      values.resize(rows.size());
+      nulls.resize(rows.size());
+
+      size_type row = 0;
+      for (BlocksType::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+      {
+        MultiValue::Ptr mv = it->first->getValuesByNumber(field_num);
+        for (unsigned n = 0; n < it->second; ++n, ++row)
+        {
+          nulls[row] = mv->isNull(n);
+          if (!nulls[row])
+            values[row] = (mv.getPointer()->*getter)(n);
+        }
+      }
+    }
+
+    void Result::getColumn(size_type field_num, std::vector<int64_t>& values,
+      std::vector<bool>& nulls) const
+    {
+      if (blocks.empty())
+        IResult::getColumn(field_num, values, nulls);
+      else
+        readColumn(field_num, values, nulls, &MultiValue::getInt64);
+    }
+
+    void Result::getColumn(size_type field_num, std::vector<double>& values,
+      std::vector<bool>& nulls) const
+    {
+      if (blocks.empty())
+        IResult::getColumn(field_num, values, nulls);
+      else
+        readColumn(field_num, values, nulls, &MultiValue::getDouble);
+    }
+
+    void Result::getColumn(size_type field_num, std::vector<std::string>& values,
+      std::vector<bool>& nulls) const
+    {
+      if (blocks.empty())
+      {
+        IResult::getColumn(field_num, values, nulls);
+        return;
+      }
+
+      values.clear();
+      values.resize(rows.size());
+      nulls.resize(rows.size());
+
+      size_type row = 0;
+      for (BlocksType::const_iterator it = blocks.begin(); it != blocks.end(); ++it)
+      {
+        MultiValue::Ptr mv = it->first->getValuesByNumber(field_num);
+        for (unsigned n = 0; n < it->second; ++n, ++row)
+        {
+          nulls[row] = mv->isNull(n);
+          if (!nulls[row])
+            mv->getString(n, values[row]);
+        }
+      }
+    }
+
   }
 }
@@ -71,6 +71,15 @@ namespace tntdb
     }
 
     tntdb::Value Row::getValueByName(const std::string& field_name) const
+    {
+      size_type n = getColumnIndex(field_name);
+      if (n == npos)
+        throw FieldNotFound(field_name);
+
+      return values[n];
+    }
+
+    Row::size_type Row::getColumnIndex(const std::string& field_name) const
     {
       std::string field_name_upper;
       field_name_upper.reserve(field_name.size());
@@ -78,15 +87,11 @@ namespace tntdb
         it != field_name.end(); ++it)
           field_name_upper += std::toupper(*it);
 
-      Values::const_iterator it;
-      for (it = values.begin(); it != values.end(); ++it)
-        if (static_cast<const Value*>(it->getImpl())->getColumnName() == field_name_upper)
-          break;
-
-      if (it == values.end())
-        throw FieldNotFound(field_name);
+      for (size_type n = 0; n < values.size(); ++n)
+        if (static_cast<const Value*>(values[n].getImpl())->getColumnName() == field_name_upper)
+          return n;
 
-      return *it;
+      return npos;
     }
 
     std::string Row::getColumnName(size_type field_num) const
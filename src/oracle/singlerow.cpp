@@ -83,5 +83,45 @@ namespace tntdb
       return _mr->getColumnName(field_num);
     }
 
+    SingleRow::size_type SingleRow::getColumnIndex(const std::string& field_name) const
+    {
+      return _mr->findColIndexByName(field_name);
+    }
+
+    bool SingleRow::isNull(size_type field_num) const
+    {
+      return _mr->getValuesByNumber(field_num)->isNull(_row);
+    }
+
+    bool SingleRow::getBool(size_type field_num) const
+    {
+      return _mr->getValuesByNumber(field_num)->getBool(_row);
+    }
+
+    int SingleRow::getInt(size_type field_num) const
+    {
+      return _mr->getValuesByNumber(field_num)->getInt(_row);
+    }
+
+    int64_t SingleRow::getInt64(size_type field_num) const
+    {
+      return _mr->getValuesByNumber(field_num)->getInt64(_row);
+    }
+
+    uint64_t SingleRow::getUnsigned64(size_type field_num) const
+    {
+      return _mr->getValuesByNumber(field_num)->getUnsigned64(_row);
+    }
+
+    double SingleRow::getDouble(size_type field_num) const
+    {
+      return _mr->getValuesByNumber(field_num)->getDouble(_row);
+    }
+
+    void SingleRow::getString(size_type field_num, std::string& ret) const
+    {
+      _mr->getValuesByNumber(field_num)->getString(_row, ret);
+    }
+
   }
 }
@@ -36,7 +36,11 @@
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/result.h>
 #include <tntdb/error.h>
+#include <tntdb/batch.h>
 #include <cxxtools/log.h>
+#include <algorithm>
+#include <cctype>
+#include <limits>
 
 log_define("tntdb.oracle.statement")
 
@@ -44,18 +48,11 @@ namespace tntdb
 {
   namespace oracle
   {
-    Statement::Bind* Statement::getBindPtr(const std::string& col)
-    {
-      BindMapType::iterator it = bindMap.find(col);
-      if (it == bindMap.end())
-        it = bindMap.insert(BindMapType::value_type(col, new Bind())).first;
-      return it->second.getPointer();
-    }
-
     Statement::Statement(Connection* conn_, const std::string& query_)
       : conn(conn_),
         query(query_),
-        stmtp(0)
+        stmtp(0),
+        paramNamesRead(false)
     {
       getHandle();
     }
@@ -75,22 +72,93 @@ namespace tntdb
 
     void Statement::clear()
     {
-      for (BindMapType::iterator it = bindMap.begin(); it != bindMap.end(); ++it)
+      for (BindsType::iterator it = binds.begin(); it != binds.end(); ++it)
       {
-        it->second->setNull();
+        Bind& b = **it;
+        b.setNull();
 
-        log_debug("OCIBindByName, clear(\"" << it->first << "\")");
-        sword ret = OCIBindByName(getHandle(), &it->second->ptr, conn->getErrorHandle(),
+        log_debug("OCIBindByName, clear(\"" << b.name << "\")");
+        sword ret = OCIBindByName(getHandle(), &b.ptr, conn->getErrorHandle(),
           0, 0, 0, 0,
-          SQLT_INT, &it->second->indicator, 0, 0, 0, 0, OCI_DEFAULT);
+          SQLT_INT, &b.indicator, 0, 0, 0, 0, OCI_DEFAULT);
 
         checkError(ret, "OCIBindByName");
       }
     }
 
-    void Statement::setNull(const std::string& col)
+    // The host variables are bound by name, when they are set the first time.
+    Statement::size_type Statement::paramIndex(const std::string& col)
     {
-      Bind &b = getBind(col);
+      BindMapType::const_iterator it = bindMap.find(col);
+      if (it != bindMap.end())
+        return it->second;
+
+      size_type idx = binds.size();
+      binds.push_back(new Bind(col));
+      bindMap.insert(BindMapType::value_type(col, idx));
+      return idx;
+    }
+
+    Statement::size_type Statement::findParam(const std::string& col)
+    {
+      if (bindMap.find(col) == bindMap.end())
+      {
+        if (!paramNamesRead)
+          readParamNames();
+
+        std::string name(col);
+        std::transform(name.begin(), name.end(), name.begin(), ::toupper);
+        if (paramNames.find(name) == paramNames.end())
+          return npos;
+      }
+
+      return paramIndex(col);
+    }
+
+    // OCI reports the names of the host variables in upper case and without
+    // the colon.
+    void Statement::readParamNames()
+    {
+      static const ub4 chunkSize = 32;
+      OraText* names[chunkSize];
+      ub1 nameLengths[chunkSize];
+      OraText* indNames[chunkSize];
+      ub1 indNameLengths[chunkSize];
+      ub1 duplicates[chunkSize];
+      OCIBind* handles[chunkSize];
+
+      for (ub4 start = 1; ; start += chunkSize)
+      {
+        sb4 found = 0;
+        log_debug("OCIStmtGetBindInfo(" << getHandle() << ", " << chunkSize << ", " << start << ')');
+        sword ret = OCIStmtGetBindInfo(getHandle(), conn->getErrorHandle(),
+          chunkSize, start, &found, names, nameLengths, indNames, indNameLengths,
+          duplicates, handles);
+        if (ret == OCI_NO_DATA)
+          break;
+        checkError(ret, "OCIStmtGetBindInfo");
+
+        // found is negative, when there are more host variables than fit into the arrays
+        ub4 total = found < 0 ? -found : found;
+        ub4 n = std::min(chunkSize, total - (start - 1));
+        for (ub4 i = 0; i < n; ++i)
+          paramNames.insert(std::string(reinterpret_cast<const char*>(names[i]), nameLengths[i]));
+
+        if (start - 1 + n >= total)
+          break;
+      }
+
+      paramNamesRead = true;
+    }
+
+    void Statement::setNull(size_type idx)
+    {
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.setNull();
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_CHR || b.boundLength != 0)
@@ -111,9 +179,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setBool(const std::string& col, bool data)
+    void Statement::setBool(size_type idx, bool data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.setData(reinterpret_cast<char*>(&data), sizeof(bool));
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_INT || b.boundLength != sizeof(bool))
@@ -136,9 +209,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setShort(const std::string& col, short data)
+    void Statement::setShort(size_type idx, short data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.setData(reinterpret_cast<char*>(&data), sizeof(int));
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_INT || b.boundLength != sizeof(short))
@@ -161,9 +239,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setInt(const std::string& col, int data)
+    void Statement::setInt(size_type idx, int data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.setData(reinterpret_cast<char*>(&data), sizeof(int));
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_INT || b.boundLength != sizeof(int))
@@ -186,9 +269,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setLong(const std::string& col, long data)
+    void Statement::setLong(size_type idx, long data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.number.setLong(data, conn->getErrorHandle());
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_VNU)
@@ -210,9 +298,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+    void Statement::setUnsignedShort(size_type idx, unsigned short data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.setData(reinterpret_cast<char*>(&data), sizeof(unsigned short));
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_UIN || b.boundLength != sizeof(unsigned short))
@@ -235,9 +328,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setUnsigned(const std::string& col, unsigned data)
+    void Statement::setUnsigned(size_type idx, unsigned data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.setData(reinterpret_cast<char*>(&data), sizeof(unsigned));
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_UIN || b.boundLength != sizeof(unsigned))
@@ -260,10 +358,15 @@ namespace tntdb
       }
     }
 
-    void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+    void Statement::setUnsignedLong(size_type idx, unsigned long data)
     {
 
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.number.setUnsignedLong(data, conn->getErrorHandle());
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_VNU)
@@ -285,19 +388,24 @@ namespace tntdb
       }
     }
 
-    void Statement::setInt32(const std::string& col, int32_t data)
+    void Statement::setInt32(size_type idx, int32_t data)
     {
-      return setInt(col, data);
+      return setInt(idx, data);
     }
 
-    void Statement::setUnsigned32(const std::string& col, uint32_t data)
+    void Statement::setUnsigned32(size_type idx, uint32_t data)
     {
-      return setUnsigned(col, data);
+      return setUnsigned(idx, data);
     }
 
-    void Statement::setInt64(const std::string& col, int64_t data)
+    void Statement::setInt64(size_type idx, int64_t data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.number.setInt64(data, conn->getErrorHandle());
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_VNU)
@@ -320,9 +428,14 @@ namespace tntdb
     }
 
 
-    void Statement::setUnsigned64(const std::string& col, uint64_t data)
+    void Statement::setUnsigned64(size_type idx, uint64_t data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.number.setUnsigned64(data, conn->getErrorHandle());
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_VNU)
@@ -344,9 +457,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setDecimal(const std::string& col, const Decimal& decimal)
+    void Statement::setDecimal(size_type idx, const Decimal& decimal)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.number.setDecimal(decimal, conn->getErrorHandle());
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_VNU)
@@ -368,9 +486,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setFloat(const std::string& col, float data)
+    void Statement::setFloat(size_type idx, float data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.setData(reinterpret_cast<char*>(&data), sizeof(float));
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_FLT || b.boundLength != sizeof(float))
@@ -393,9 +516,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setDouble(const std::string& col, double data)
+    void Statement::setDouble(size_type idx, double data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.setData(reinterpret_cast<char*>(&data), sizeof(double));
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_FLT || b.boundLength != sizeof(double))
@@ -418,9 +546,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setChar(const std::string& col, char data)
+    void Statement::setChar(size_type idx, char data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.setData(&data, 1);
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_AFC || b.boundLength != 1)
@@ -443,59 +576,106 @@ namespace tntdb
       }
     }
 
-    void Statement::setString(const std::string& col, const std::string& data)
+    void Statement::setString(size_type idx, const std::string& data)
+    {
+      setString(idx, data.data(), data.size());
+    }
+
+    void Statement::setString(size_type idx, const char* data, std::size_t length)
     {
-      Bind &b = getBind(col);
-      b.setData(data);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
+      b.setData(data, length);
+      b.sharedBlob = tntdb::Blob();
 
-      if (b.boundPtr != &b.data[0] || b.boundType != SQLT_AFC || b.boundLength != data.size())
+      if (b.boundPtr != &b.data[0] || b.boundType != SQLT_AFC || b.boundLength != length)
       {
         b.boundPtr = 0;
         b.boundType = 0;
         b.boundLength = 0;
 
-        log_debug("OCIBindByName, setString(\"" << col << "\", \"" << data << "\")");
+        log_debug("OCIBindByName, setString(\"" << col << "\", \"" << std::string(data, length) << "\")");
         sword ret = OCIBindByName(getHandle(), &b.ptr, conn->getErrorHandle(),
           reinterpret_cast<const text*>(col.data()), col.size(),
-          &b.data[0], data.size(),
+          &b.data[0], length,
           SQLT_AFC, 0, 0, 0, 0, 0, OCI_DEFAULT);
 
         checkError(ret, "OCIBindByName");
 
         b.boundPtr = &b.data[0];
         b.boundType = SQLT_AFC;
-        b.boundLength = data.size();
+        b.boundLength = length;
       }
     }
 
-    void Statement::setBlob(const std::string& col, const tntdb::Blob& data)
+    void Statement::setStringRef(size_type idx, const char* data, std::size_t length)
+    {
+      Bind* bp = getBindPtr(idx);
+      if (bp != 0)
+        bp->sharedBlob = tntdb::Blob();
+      bindRef(idx, data, length, SQLT_AFC);
+    }
+
+    void Statement::setBlob(size_type idx, const tntdb::Blob& data)
     {
-      Bind &b = getBind(col);
-      b.setData(data.data(), data.size());
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
 
-      if (b.boundPtr != &b.data[0] || b.boundType != SQLT_BIN || b.boundLength != data.size())
+      // keep a reference to the blob data, so that it is not copied
+      bp->sharedBlob = data;
+      bindRef(idx, bp->sharedBlob.data(), bp->sharedBlob.size(), SQLT_BIN);
+    }
+
+    void Statement::setBlobRef(size_type idx, const char* data, std::size_t length)
+    {
+      Bind* bp = getBindPtr(idx);
+      if (bp != 0)
+        bp->sharedBlob = tntdb::Blob();
+      bindRef(idx, data, length, SQLT_BIN);
+    }
+
+    void Statement::bindRef(size_type idx, const char* data, unsigned length, int type)
+    {
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
+
+      if (b.boundPtr != data || b.boundType != type || b.boundLength != length)
       {
         b.boundPtr = 0;
         b.boundType = 0;
         b.boundLength = 0;
 
-        log_debug("OCIBindByName, setBlob(\"" << col << "\", data{" << data.size() << "})");
+        log_debug("OCIBindByName(\"" << col << "\", " << static_cast<const void*>(data) << ", " << length << ", type " << type << ')');
         sword ret = OCIBindByName(getHandle(), &b.ptr, conn->getErrorHandle(),
           reinterpret_cast<const text*>(col.data()), col.size(),
-          &b.data[0], data.size(),
-          SQLT_BIN, 0, 0, 0, 0, 0, OCI_DEFAULT);
+          const_cast<char*>(data), length,
+          type, 0, 0, 0, 0, 0, OCI_DEFAULT);
 
         checkError(ret, "OCIBindByName");
 
-        b.boundPtr = &b.data[0];
-        b.boundType = SQLT_BIN;
-        b.boundLength = data.size();
+        b.boundPtr = data;
+        b.boundType = type;
+        b.boundLength = length;
       }
     }
 
-    void Statement::setDate(const std::string& col, const Date& data)
+    void Statement::setDate(size_type idx, const Date& data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.datetime = Datetime(conn, data);
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_TIMESTAMP)
@@ -517,9 +697,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setTime(const std::string& col, const Time& data)
+    void Statement::setTime(size_type idx, const Time& data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.datetime = Datetime(conn, data);
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_TIMESTAMP)
@@ -541,9 +726,14 @@ namespace tntdb
       }
     }
 
-    void Statement::setDatetime(const std::string& col, const tntdb::Datetime& data)
+    void Statement::setDatetime(size_type idx, const tntdb::Datetime& data)
     {
-      Bind &b = getBind(col);
+      Bind* bp = getBindPtr(idx);
+      if (bp == 0)
+        return;
+
+      Bind& b = *bp;
+      const std::string& col = b.name;
       b.datetime = Datetime(conn, data);
 
       if (b.boundPtr != &b.data[0] || b.boundType != SQLT_TIMESTAMP)
@@ -580,6 +770,246 @@ namespace tntdb
       return rowcnt;
     }
 
+    namespace
+    {
+      enum ArrayType {
+        ARRAY_NULL,
+        ARRAY_INT,
+        ARRAY_DOUBLE,
+        ARRAY_STRING,
+        ARRAY_NONE
+      };
+
+      // value buffers of a column bound as array
+      struct ArrayBuffer
+      {
+        ArrayType type;
+        unsigned maxLength;
+        std::vector<int64_t> ints;
+        std::vector<double> doubles;
+        std::vector<char> chars;
+        std::vector<ub2> lengths;
+        std::vector<sb2> indicators;
+
+        ArrayBuffer()
+          : type(ARRAY_NULL),
+            maxLength(1)
+          { }
+      };
+
+      ArrayType arrayType(const Batch& batch, Batch::size_type col, Batch::size_type row)
+      {
+        switch (batch.getType(col, row))
+        {
+          case Batch::NULLVALUE:  return ARRAY_NULL;
+          case Batch::BOOL:
+          case Batch::INT64:      return ARRAY_INT;
+          case Batch::UNSIGNED64: return batch.getUnsigned64(col, row) <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())
+                                           ? ARRAY_INT : ARRAY_NONE;
+          case Batch::DOUBLE:     return ARRAY_DOUBLE;
+          case Batch::STRING:     return batch.getString(col, row).size() <= std::numeric_limits<ub2>::max()
+                                           ? ARRAY_STRING : ARRAY_NONE;
+          default:                return ARRAY_NONE;
+        }
+      }
+    }
+
+    // The array buffers are released after a batch, so the host variables
+    // are bound to null again.
+    void Statement::unbindArrays(const std::vector<size_type>& idx)
+    {
+      for (std::vector<size_type>::const_iterator it = idx.begin(); it != idx.end(); ++it)
+        setNull(*it);
+    }
+
+    // Columns of integers, floating point numbers or strings are bound as
+    // arrays and the rows are sent with one OCIStmtExecute per chunk (array
+    // DML). Batches with other types are executed row by row. The index of a
+    // failing row is derived from the processed row count, which is exact for
+    // inserts.
+    Statement::size_type Statement::executeBatch(const Batch& batch)
+    {
+      static const Batch::size_type chunkSize = 1000;
+
+      Batch::size_type rows = batch.getRowCount();
+      Batch::size_type cols = batch.getColumnCount();
+      if (rows < 2)
+        return IStatement::executeBatch(batch);
+
+      std::vector<ArrayBuffer> buffers(cols);
+      for (Batch::size_type col = 0; col < cols; ++col)
+      {
+        ArrayBuffer& a = buffers[col];
+        for (Batch::size_type row = 0; row < rows; ++row)
+        {
+          ArrayType t = arrayType(batch, col, row);
+          if (t == ARRAY_NULL)
+            continue;
+
+          if (t == ARRAY_NONE || (a.type != ARRAY_NULL && a.type != t))
+          {
+            log_debug("column \"" << batch.getColumnName(col) << "\" can't be bound as array");
+            return IStatement::executeBatch(batch);
+          }
+
+          a.type = t;
+          if (t == ARRAY_STRING && batch.getString(col, row).size() > a.maxLength)
+            a.maxLength = batch.getString(col, row).size();
+        }
+      }
+
+      // host variables, which were bound before, must be taken from the batch
+      std::vector<size_type> idx;
+      batch.paramIndexes(*this, idx);
+      std::vector<bool> covered(binds.size());
+      for (Batch::size_type col = 0; col < cols; ++col)
+        covered[idx[col]] = true;
+      for (size_type n = 0; n < binds.size(); ++n)
+        if (!covered[n] && binds[n]->ptr != 0)
+          return IStatement::executeBatch(batch);
+
+      size_type count = 0;
+
+      try
+      {
+        for (Batch::size_type first = 0; first < rows; first += chunkSize)
+        {
+          Batch::size_type n = std::min(chunkSize, rows - first);
+
+          for (Batch::size_type col = 0; col < cols; ++col)
+          {
+            ArrayBuffer& a = buffers[col];
+            Bind& b = *binds[idx[col]];
+
+            a.indicators.assign(n, 0);
+            for (Batch::size_type r = 0; r < n; ++r)
+              if (batch.isNull(col, first + r))
+                a.indicators[r] = -1;
+
+            void* valuep;
+            sb4 valueSize;
+            ub2 type;
+            ub2* lengths = 0;
+
+            switch (a.type)
+            {
+              case ARRAY_INT:
+                a.ints.resize(n);
+                for (Batch::size_type r = 0; r < n; ++r)
+                {
+                  switch (batch.getType(col, first + r))
+                  {
+                    case Batch::BOOL:       a.ints[r] = batch.getBool(col, first + r); break;
+                    case Batch::INT64:      a.ints[r] = batch.getInt64(col, first + r); break;
+                    case Batch::UNSIGNED64: a.ints[r] = static_cast<int64_t>(batch.getUnsigned64(col, first + r)); break;
+                    default:                a.ints[r] = 0;
+                  }
+                }
+                valuep = &a.ints[0];
+                valueSize = sizeof(int64_t);
+                type = SQLT_INT;
+                break;
+
+              case ARRAY_DOUBLE:
+                a.doubles.resize(n);
+                for (Batch::size_type r = 0; r < n; ++r)
+                  a.doubles[r] = a.indicators[r] == 0 ? batch.getDouble(col, first + r) : 0;
+                valuep = &a.doubles[0];
+                valueSize = sizeof(double);
+                type = SQLT_FLT;
+                break;
+
+              default:
+                a.chars.resize(n * a.maxLength);
+                a.lengths.assign(n, 0);
+                for (Batch::size_type r = 0; r < n; ++r)
+                {
+                  if (a.indicators[r] == 0)
+                  {
+                    const std::string& v = batch.getString(col, first + r);
+                    v.copy(&a.chars[r * a.maxLength], v.size());
+                    a.lengths[r] = v.size();
+                  }
+                }
+                valuep = &a.chars[0];
+                valueSize = a.maxLength;
+                type = SQLT_CHR;
+                lengths = &a.lengths[0];
+                break;
+            }
+
+            log_debug("OCIBindByName, array of " << n << " for \"" << b.name << '"');
+            sword ret = OCIBindByName(getHandle(), &b.ptr, conn->getErrorHandle(),
+              reinterpret_cast<const text*>(b.name.data()), b.name.size(),
+              valuep, valueSize, type, &a.indicators[0], lengths, 0, 0, 0, OCI_DEFAULT);
+
+            // the next scalar setter has to bind again
+            b.boundPtr = 0;
+            b.boundType = 0;
+            b.boundLength = 0;
+
+            checkError(ret, "OCIBindByName");
+          }
+
+          log_debug("execute statement " << getHandle() << " with " << n << " rows");
+          sword ret = OCIStmtExecute(conn->getSvcCtxHandle(), getHandle(), conn->getErrorHandle(),
+            n, 0, 0, 0, conn->isTransactionActive() ? OCI_DEFAULT : OCI_COMMIT_ON_SUCCESS);
+
+          ub4 rowcnt = 0;
+
+          try
+          {
+            checkError(ret, "OCIStmtExecute");
+          }
+          catch (const std::exception& e)
+          {
+            std::string msg = e.what();
+            OCIAttrGet(getHandle(), OCI_HTYPE_STMT, &rowcnt, 0, OCI_ATTR_ROW_COUNT,
+              conn->getErrorHandle());
+
+            // the rows processed before the error are not committed yet
+            if (conn->isTransactionActive())
+              count += rowcnt;
+            else
+            {
+              try
+              {
+                conn->rollbackTransaction();
+              }
+              catch (const std::exception& re)
+              {
+                log_warn("rollback of batch failed: " << re.what());
+              }
+            }
+
+            throw BatchError(first + rowcnt, msg, count);
+          }
+
+          ret = OCIAttrGet(getHandle(), OCI_HTYPE_STMT, &rowcnt, 0, OCI_ATTR_ROW_COUNT,
+            conn->getErrorHandle());
+          checkError(ret, "OCIAttrGet");
+
+          count += rowcnt;
+        }
+      }
+      catch (const std::exception&)
+      {
+        try
+        {
+          unbindArrays(idx);
+        }
+        catch (const std::exception& e)
+        {
+          log_warn("unbinding arrays failed: " << e.what());
+        }
+        throw;
+      }
+
+      unbindArrays(idx);
+
+      return count;
+    }
+
     tntdb::Result Statement::select()
     {
       return tntdb::Result(new Result(this, 64));
@@ -618,6 +1048,11 @@ namespace tntdb
       return new Cursor(this, fetchsize);
     }
 
+    void Statement::prepare()
+    {
+      getHandle();
+    }
+
     OCIStmt* Statement::getHandle()
     {
       if (stmtp == 0)
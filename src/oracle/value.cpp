@@ -30,10 +30,8 @@
 #include <tntdb/oracle/statement.h>
 #include <tntdb/error.h>
 #include <tntdb/decimal.h>
-#include <sstream>
+#include <tntdb/impl/numconvert.h>
 #include <algorithm>
-#include <iterator>
-#include <iomanip>
 #include <cxxtools/log.h>
 
 log_define("tntdb.oracle.value")
@@ -45,64 +43,16 @@ namespace tntdb
     namespace
     {
       template <typename T>
-      T getValue(const std::string& s, const char* tname)
-      {
-        std::istringstream in(s);
-        T ret;
-        in >> ret;
-        if (!in)
-        {
-          std::ostringstream msg;
-          msg << "can't convert \"" << s << "\" to " << tname;
-          throw TypeError(msg.str());
-        }
-        return ret;
-      }
-
-      template <typename T, typename I>
-      T getValueFloat(I from, I to, const char* tname)
+      T getValueFloat(const char* s, std::size_t len, const char* tname)
       {
         // This is a stupid workaround for converting decimal comma into decimal point
         // It should be actually done in OCI
-        std::string o;
-        o.reserve(to - from);
-        std::replace_copy(from, to, std::back_inserter(o), ',', '.');
-        return getValue<T>(o, tname);
-      }
+        if (std::find(s, s + len, ',') == s + len)
+          return convertNumber<T>(s, len, tname);
 
-      template <typename T>
-      std::string toString(T v)
-      {
-        std::ostringstream ret;
-        ret << v;
-        return ret.str();
-      }
-
-      template <>
-      std::string toString(float v)
-      {
-        std::ostringstream ret;
-        ret.precision(24);
-        ret << v;
-        return ret.str();
-      }
-
-      template <>
-      std::string toString(double v)
-      {
-        std::ostringstream ret;
-        ret.precision(24);
-        ret << v;
-        return ret.str();
-      }
-
-      template <>
-      std::string toString(Decimal v)
-      {
-        std::ostringstream ret;
-        ret.precision(24);
-        ret << v;
-        return ret.str();
+        std::string o(s, len);
+        std::replace(o.begin(), o.end(), ',', '.');
+        return convertNumber<T>(o.data(), o.size(), tname);
       }
 
       template <typename IntType>
@@ -299,7 +249,7 @@ namespace tntdb
           return number.getDecimal(errhp).getInteger<short>();
 
         default:
-          return getValue<short>(std::string(&data[0], len), "int");
+          return convertNumber<short>(&data[0], len, "int");
       }
     }
 
@@ -328,7 +278,7 @@ namespace tntdb
           return number.getDecimal(errhp).getInteger<int>();
 
         default:
-          return getValue<int>(std::string(&data[0], len), "int");
+          return convertNumber<int>(&data[0], len, "int");
       }
     }
 
@@ -357,7 +307,7 @@ namespace tntdb
           return number.getDecimal(errhp).getInteger<long>();
 
         default:
-          return getValue<long>(std::string(&data[0], len), "long");
+          return convertNumber<long>(&data[0], len, "long");
       }
     }
 
@@ -391,7 +341,7 @@ namespace tntdb
           return number.getDecimal(errhp).getInteger<unsigned short>();
 
         default:
-          return getValue<unsigned>(std::string(&data[0], len), "unsigned");
+          return convertNumber<unsigned>(&data[0], len, "unsigned");
       }
     }
 
@@ -420,7 +370,7 @@ namespace tntdb
           return number.getDecimal(errhp).getInteger<unsigned>();
 
         default:
-          return getValue<unsigned>(std::string(&data[0], len), "unsigned");
+          return convertNumber<unsigned>(&data[0], len, "unsigned");
       }
     }
 
@@ -449,7 +399,7 @@ namespace tntdb
           return number.getDecimal(errhp).getInteger<unsigned long>();
 
         default:
-          return getValue<unsigned long>(std::string(&data[0], len), "unsigned long");
+          return convertNumber<unsigned long>(&data[0], len, "unsigned long");
       }
     }
 
@@ -483,7 +433,7 @@ namespace tntdb
           return number.getDecimal(errhp).getInteger<int64_t>();
 
         default:
-          return getValue<int64_t>(std::string(&data[0], len), "int64_t");
+          return convertNumber<int64_t>(&data[0], len, "int64_t");
       }
     }
 
@@ -512,7 +462,7 @@ namespace tntdb
           return number.getDecimal(errhp).getInteger<uint64_t>();
 
         default:
-          return getValue<uint64_t>(std::string(&data[0], len), "uint64_t");
+          return convertNumber<uint64_t>(&data[0], len, "uint64_t");
       }
     }
 
@@ -570,7 +520,7 @@ namespace tntdb
           return number.getDecimal(errhp).getDouble();
 
         default:
-          return getValueFloat<float>(data.begin(), data.begin() + len, "float");
+          return getValueFloat<float>(&data[0], len, "float");
       }
     }
 
@@ -599,7 +549,7 @@ namespace tntdb
           return number.getDecimal(errhp).getDouble();
 
         default:
-          return getValueFloat<double>(data.begin(), data.begin() + len, "double");
+          return getValueFloat<double>(&data[0], len, "double");
       }
     }
 
@@ -645,12 +595,18 @@ namespace tntdb
 
         case SQLT_INT:
         case SQLT_UIN:
-          ret = toString(longValue);
+        {
+          char buf[numberBufferSize];
+          ret.assign(buf, formatInteger(longValue, buf));
           break;
+        }
 
         case SQLT_FLT:
-          ret = toString(doubleValue);
+        {
+          char buf[numberBufferSize];
+          ret.assign(buf, formatDouble(doubleValue, buf));
           break;
+        }
 
         case SQLT_NUM:
         case SQLT_VNU:
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <tntdb/parsedstmt.h>
+#include <tntdb/stmtparser.h>
+#include <cxxtools/mutex.h>
+#include <cxxtools/log.h>
+
+log_define("tntdb.parsedstmt")
+
+namespace tntdb
+{
+  namespace
+  {
+    class SE : public StmtEvent
+    {
+        ParsedStmt::Style style;
+        ParsedStmt::hostvarMapType& hostvarMap;
+        ParsedStmt::paramsType& params;
+        unsigned idx;
+
+      public:
+        SE(ParsedStmt::Style style_, ParsedStmt::hostvarMapType& hostvarMap_,
+           ParsedStmt::paramsType& params_)
+          : style(style_),
+            hostvarMap(hostvarMap_),
+            params(params_),
+            idx(0)
+          { }
+        std::string onHostVar(const std::string& name);
+        unsigned getCount() const  { return idx; }
+    };
+
+    std::string SE::onHostVar(const std::string& name)
+    {
+      ParsedStmt::hostvarMapType::const_iterator it = hostvarMap.find(name);
+      if (it == hostvarMap.end())
+      {
+        it = hostvarMap.insert(ParsedStmt::hostvarMapType::value_type(name, params.size())).first;
+        params.push_back(ParsedStmt::positionsType());
+      }
+
+      params[it->second].push_back(idx++);
+
+      if (style == ParsedStmt::QUESTIONMARK)
+        return std::string(1, '?');
+
+      // format "$n" without going through a stream
+      char buffer[12];
+      char* p = buffer + sizeof(buffer);
+      unsigned n = it->second + 1;
+      do
+      {
+        *--p = static_cast<char>('0' + n % 10);
+        n /= 10;
+      } while (n > 0);
+      *--p = '$';
+
+      return std::string(p, buffer + sizeof(buffer));
+    }
+
+    typedef std::map<std::string, cxxtools::SmartPtr<ParsedStmt> > CacheType;
+
+    cxxtools::Mutex cacheMutex;
+    CacheType cache[2];
+    unsigned maxCacheSize = 1024;
+
+    // drops entries, which are referenced by the cache only; caller holds cacheMutex
+    void sweepCache()
+    {
+      for (unsigned s = 0; s < 2; ++s)
+      {
+        for (CacheType::iterator it = cache[s].begin(); it != cache[s].end(); )
+        {
+          if (it->second->refs() == 1)
+            cache[s].erase(it++);
+          else
+            ++it;
+        }
+      }
+    }
+  }
+
+  cxxtools::SmartPtr<ParsedStmt> ParsedStmt::insert(const std::string& query, Style style,
+    cxxtools::SmartPtr<ParsedStmt> parsed)
+  {
+    if (cache[0].size() + cache[1].size() >= maxCacheSize)
+    {
+      sweepCache();
+      if (cache[0].size() + cache[1].size() >= maxCacheSize)
+      {
+        log_debug("parsed statement cache full");
+        return parsed;
+      }
+    }
+
+    return cache[style].insert(CacheType::value_type(query, parsed)).first->second;
+  }
+
+  ParsedStmt::ParsedStmt(const std::string& query, Style style)
+  {
+    StmtParser parser;
+    SE se(style, _hostvarMap, _params);
+    parser.parse(query, se);
+
+    _sql = parser.getSql();
+    _placeholderCount = se.getCount();
+
+    log_debug("sql=\"" << _sql << "\" placeholders " << _placeholderCount
+      << " params " << _params.size());
+  }
+
+  cxxtools::SmartPtr<ParsedStmt> ParsedStmt::get(const std::string& query, Style style)
+  {
+    {
+      cxxtools::MutexLock lock(cacheMutex);
+      CacheType::const_iterator it = cache[style].find(query);
+      if (it != cache[style].end())
+        return it->second;
+    }
+
+    // parse outside the lock; if another thread was faster, its result wins
+    cxxtools::SmartPtr<ParsedStmt> parsed = new ParsedStmt(query, style);
+
+    cxxtools::MutexLock lock(cacheMutex);
+    return insert(query, style, parsed);
+  }
+
+  bool ParsedStmt::isCached(const std::string& query, Style style)
+  {
+    cxxtools::MutexLock lock(cacheMutex);
+    return cache[style].find(query) != cache[style].end();
+  }
+
+  void ParsedStmt::put(const std::string& query, Style style, cxxtools::SmartPtr<ParsedStmt> parsed)
+  {
+    cxxtools::MutexLock lock(cacheMutex);
+    insert(query, style, parsed);
+  }
+
+  void ParsedStmt::setCacheSize(unsigned n)
+  {
+    cxxtools::MutexLock lock(cacheMutex);
+    maxCacheSize = n;
+    if (cache[0].size() + cache[1].size() > maxCacheSize)
+      sweepCache();
+  }
+
+  unsigned ParsedStmt::getCacheSize()
+  {
+    cxxtools::MutexLock lock(cacheMutex);
+    return maxCacheSize;
+  }
+
+  void ParsedStmt::clearCache()
+  {
+    cxxtools::MutexLock lock(cacheMutex);
+    sweepCache();
+  }
+}
@@ -31,94 +31,293 @@
 #include <tntdb/bits/result.h>
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/value.h>
+#include <tntdb/bits/statement.h>
+#include <tntdb/error.h>
+#include <cxxtools/clock.h>
 #include <cxxtools/log.h>
 
 log_define("tntdb.poolconnection")
 
 namespace tntdb
 {
-  PoolConnection::PoolConnection(ConnectionPool::PoolObjectType connection_)
-    : connection(connection_),
+  PoolConnection::PoolConnection(ConnectionPool& pool_,
+      const ConnectionPool::Entry& entry_, bool validated_)
+    : pool(pool_),
+      entry(entry_),
       inTransaction(false),
-      drop(false)
+      drop(false),
+      validated(validated_)
   {
-    log_debug("PoolConnection " << this << " for connection " << connection->getImpl());
+    log_debug("PoolConnection " << this << " for connection " << connection());
+    entry.checkedOut = cxxtools::Clock::getSystemTicks();
   }
 
   PoolConnection::~PoolConnection()
   {
-    // don't put the connection back to the free pool, when there is a
-    // pending transaction
-    if (inTransaction || drop)
+    bool reuse = !drop;
+
+    // roll back a pending transaction, so that an exception, which unwinds
+    // a transaction, does not cost a new connection and its prepared
+    // statements
+    if (reuse && inTransaction)
     {
-      log_debug("don't reuse connection " << connection->getImpl());
-      connection.release();
+      try
+      {
+        log_debug("reset connection " << connection());
+        reuse = connection()->reset();
+      }
+      catch (const std::exception& e)
+      {
+        log_warn("reset of connection " << connection() << " failed: " << e.what());
+        reuse = false;
+      }
     }
+
+    if (reuse)
+      log_debug("reuse connection " << connection());
     else
-      log_debug("reuse connection " << connection->getImpl());
+      log_debug("don't reuse connection " << connection());
+
+    pool.release(entry, reuse);
+  }
+
+  // The pool checks recently used connections only locally. When the first
+  // operation on such a connection fails and the connection turns out to be
+  // dead, it is replaced with a new one and the operation is repeated.
+  // Statements are not covered: they are bound to the driver connection they
+  // were prepared on and cannot be moved to the new one.
+  bool PoolConnection::reconnect()
+  {
+    if (validated)
+      return false;
+
+    validated = true;
+
+    if (connection()->ping())
+      return false;
+
+    log_warn("drop dead connection " << connection() << " from pool; reconnect");
+    pool.droppedDead();
+
+    // the connection keeps its slot in the pool; when reconnecting fails, the
+    // slot is released in the destructor
+    // the connection is still checked out, so its hold time keeps counting
+    // from the original checkout
+    cxxtools::Timespan checkedOut = entry.checkedOut;
+    drop = true;
+    entry = pool.create();
+    drop = false;
+    entry.checkedOut = checkedOut;
+    return true;
   }
 
   void PoolConnection::beginTransaction()
   {
-    connection->beginTransaction();
+    try
+    {
+      connection()->beginTransaction();
+    }
+    catch (const Error&)
+    {
+      if (!reconnect())
+        throw;
+      connection()->beginTransaction();
+    }
+
+    validated = true;
     inTransaction = true;
   }
 
   void PoolConnection::commitTransaction()
   {
-    connection->commitTransaction();
+    connection()->commitTransaction();
     inTransaction = false;
   }
 
   void PoolConnection::rollbackTransaction()
   {
-    connection->rollbackTransaction();
+    connection()->rollbackTransaction();
     // keep transaction state
   }
 
   PoolConnection::size_type PoolConnection::execute(const std::string& query)
   {
-    return connection->execute(query);
+    try
+    {
+      size_type ret = connection()->execute(query);
+      validated = true;
+      return ret;
+    }
+    catch (const Error&)
+    {
+      if (!reconnect())
+        throw;
+    }
+
+    return connection()->execute(query);
   }
 
   Result PoolConnection::select(const std::string& query)
   {
-    return connection->select(query);
+    try
+    {
+      Result ret = connection()->select(query);
+      validated = true;
+      return ret;
+    }
+    catch (const Error&)
+    {
+      if (!reconnect())
+        throw;
+    }
+
+    return connection()->select(query);
   }
 
   Row PoolConnection::selectRow(const std::string& query)
   {
-    return connection->selectRow(query);
+    try
+    {
+      Row ret = connection()->selectRow(query);
+      validated = true;
+      return ret;
+    }
+    catch (const NotFound&)
+    {
+      validated = true;
+      throw;
+    }
+    catch (const Error&)
+    {
+      if (!reconnect())
+        throw;
+    }
+
+    return connection()->selectRow(query);
   }
 
   Value PoolConnection::selectValue(const std::string& query)
   {
-    return connection->selectValue(query);
+    try
+    {
+      Value ret = connection()->selectValue(query);
+      validated = true;
+      return ret;
+    }
+    catch (const NotFound&)
+    {
+      validated = true;
+      throw;
+    }
+    catch (const Error&)
+    {
+      if (!reconnect())
+        throw;
+    }
+
+    return connection()->selectValue(query);
   }
 
   Statement PoolConnection::prepare(const std::string& query)
   {
-    return connection->prepare(query);
+    try
+    {
+      return connection()->prepare(query);
+    }
+    catch (const Error&)
+    {
+      if (!reconnect())
+        throw;
+    }
+
+    return connection()->prepare(query);
+  }
+
+  Statement PoolConnection::prepareShared(const std::string& query)
+  {
+    try
+    {
+      return connection()->prepareShared(query);
+    }
+    catch (const Error&)
+    {
+      if (!reconnect())
+        throw;
+    }
+
+    return connection()->prepareShared(query);
   }
 
   Statement PoolConnection::prepareCached(const std::string& query, const std::string& key)
   {
-    return connection->prepareCached(query, key);
+    Statement stmt;
+
+    try
+    {
+      stmt = connection()->prepareCached(query, key);
+    }
+    catch (const Error&)
+    {
+      if (!reconnect())
+        throw;
+      stmt = connection()->prepareCached(query, key);
+    }
+
+    pool.recordStatement(key, query);
+    return stmt;
   }
 
   void PoolConnection::clearStatementCache()
   {
-    return connection->clearStatementCache();
+    return connection()->clearStatementCache();
   }
 
   bool PoolConnection::clearStatementCache(const std::string& key)
   {
-    return connection->clearStatementCache(key);
+    return connection()->clearStatementCache(key);
+  }
+
+  void PoolConnection::setStatementCaching(bool sw)
+  {
+    connection()->setStatementCaching(sw);
+  }
+
+  bool PoolConnection::getStatementCaching()
+  {
+    return connection()->getStatementCaching();
+  }
+
+  void PoolConnection::setStatementCacheCapacity(unsigned capacity)
+  {
+    connection()->setStatementCacheCapacity(capacity);
+  }
+
+  StmtCacheStatistics PoolConnection::getStatementCacheStatistics()
+  {
+    return connection()->getStatementCacheStatistics();
   }
 
   bool PoolConnection::ping()
   {
-    bool ok = connection->ping();
+    bool ok = connection()->ping();
+    if (!ok)
+      drop = true;
+    else
+      validated = true;
+    return ok;
+  }
+
+  bool PoolConnection::reset()
+  {
+    bool ok = connection()->reset();
+    if (ok)
+      inTransaction = false;
+    return ok;
+  }
+
+  bool PoolConnection::isAlive()
+  {
+    bool ok = connection()->isAlive();
     if (!ok)
       drop = true;
     return ok;
@@ -126,12 +325,12 @@ namespace tntdb
 
   long PoolConnection::lastInsertId(const std::string& name)
   {
-    return connection->lastInsertId(name);
+    return connection()->lastInsertId(name);
   }
 
   void PoolConnection::lockTable(const std::string& tablename, bool exclusive)
   {
-    connection->getImpl()->lockTable(tablename, exclusive);
+    connection()->lockTable(tablename, exclusive);
   }
 
 }
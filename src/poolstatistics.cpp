@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <tntdb/poolstatistics.h>
+#include <cxxtools/serializationinfo.h>
+
+namespace tntdb
+{
+  namespace
+  {
+    const unsigned bounds[PoolHistogram::bucketCount - 1] = {
+      1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000
+    };
+  }
+
+  PoolHistogram::PoolHistogram()
+    : _count(0)
+  {
+    for (unsigned n = 0; n < bucketCount; ++n)
+      _counts[n] = 0;
+  }
+
+  void PoolHistogram::add(const cxxtools::Timespan& t)
+  {
+    double msecs = t.totalMSecs();
+    unsigned n = 0;
+    while (n < bucketCount - 1 && msecs > bounds[n])
+      ++n;
+
+    ++_counts[n];
+    ++_count;
+    _sum += t;
+  }
+
+  unsigned PoolHistogram::bound(unsigned bucket)
+  {
+    return bucket < bucketCount - 1 ? bounds[bucket] : 0;
+  }
+
+  void operator<<= (cxxtools::SerializationInfo& si, const PoolHistogram& histogram)
+  {
+    si.addMember("count") <<= histogram.count();
+    si.addMember("sum") <<= histogram.sum().totalMSecs();
+
+    cxxtools::SerializationInfo& buckets = si.addMember("buckets");
+    buckets.setCategory(cxxtools::SerializationInfo::Array);
+    for (unsigned n = 0; n < PoolHistogram::bucketCount; ++n)
+    {
+      cxxtools::SerializationInfo& bucket = buckets.addMember(std::string());
+      if (n < PoolHistogram::bucketCount - 1)
+        bucket.addMember("le") <<= PoolHistogram::bound(n);
+      else
+        bucket.addMember("le") <<= "+Inf";
+      bucket.addMember("count") <<= histogram.count(n);
+    }
+  }
+
+  void operator<<= (cxxtools::SerializationInfo& si, const PoolStatistics& statistics)
+  {
+    si.setTypeName("PoolStatistics");
+    si.addMember("url") <<= statistics.url;
+    si.addMember("inUse") <<= statistics.inUse;
+    si.addMember("idle") <<= statistics.idle;
+    si.addMember("waiting") <<= statistics.waiting;
+    si.addMember("created") <<= statistics.created;
+    si.addMember("droppedDead") <<= statistics.droppedDead;
+    si.addMember("waits") <<= statistics.waits;
+    si.addMember("timeouts") <<= statistics.timeouts;
+    si.addMember("rejected") <<= statistics.rejected;
+    si.addMember("checkoutWait") <<= statistics.checkoutWait;
+    si.addMember("holdTime") <<= statistics.holdTime;
+  }
+}
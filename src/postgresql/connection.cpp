@@ -45,7 +45,8 @@ namespace tntdb
   {
     Connection::Connection(const char* conninfo)
       : transactionActive(0),
-        stmtCounter(0)
+        stmtCounter(0),
+        broken(false)
     {
       log_debug("PQconnectdb(\"" << conninfo << "\")");
 
@@ -163,6 +164,9 @@ namespace tntdb
     {
       log_debug("ping()");
 
+      if (broken)
+        return false;
+
       if (PQsendQuery(conn, "select 1") == 0)
       {
         log_debug("failed to send statement \"select 1\" to database in Connection::ping()");
@@ -204,6 +208,38 @@ namespace tntdb
       }
     }
 
+    bool Connection::isAlive()
+    {
+      if (broken || PQstatus(conn) != CONNECTION_OK)
+        return false;
+
+      // an idle connection has nothing to read unless the server closed it
+      struct pollfd fd;
+      fd.fd = PQsocket(conn);
+      fd.events = POLLIN;
+      if (::poll(&fd, 1, 0) == 0)
+        return true;
+
+      log_debug("input pending on idle connection; consumeInput");
+      return PQconsumeInput(conn) != 0
+          && PQstatus(conn) == CONNECTION_OK;
+    }
+
+    bool Connection::reset()
+    {
+      if (broken)
+        return false;
+
+      // a transaction may have been started with a plain BEGIN too
+      if (transactionActive > 0 || PQtransactionStatus(conn) != PQTRANS_IDLE)
+      {
+        transactionActive = 1;
+        rollbackTransaction();
+      }
+
+      return PQtransactionStatus(conn) == PQTRANS_IDLE;
+    }
+
     long Connection::lastInsertId(const std::string& name)
     {
       long ret = 0;
@@ -75,6 +75,7 @@ namespace tntdb
           + stmt->getQuery();
 
         // declare cursor
+        stmt->resolveTextRefs(false);
         log_debug("PQexecParams(" << getPGConn() << ", \"" << sql
           << "\", " << stmt->getNParams() << ", 0, paramValues, paramLengths, 0, 0)");
         PGresult* result = PQexecParams(getPGConn(), sql.c_str(),
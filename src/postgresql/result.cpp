@@ -29,6 +29,8 @@
 #include <tntdb/postgresql/impl/result.h>
 #include <tntdb/postgresql/impl/resultrow.h>
 #include <tntdb/row.h>
+#include <tntdb/error.h>
+#include <cxxtools/convert.h>
 #include <cxxtools/log.h>
 
 log_define("tntdb.postgresql.result")
@@ -53,6 +55,34 @@ namespace tntdb
       }
     }
 
+    void Result::reset(PGresult* r)
+    {
+      if (result)
+      {
+        log_debug("PQclear(" << result << ')');
+        ::PQclear(result);
+      }
+      result = r;
+    }
+
+    const ColumnDescriptor& Result::getColumns() const
+    {
+      if (!columns)
+      {
+        cxxtools::SmartPtr<ColumnDescriptor> c = new ColumnDescriptor();
+        size_type fc = getFieldCount();
+        c->reserve(fc);
+        for (size_type n = 0; n < fc; ++n)
+        {
+          log_debug("PQfname(" << result << ", " << n << ')');
+          c->add(::PQfname(result, n));
+        }
+        columns = c;
+      }
+
+      return *columns;
+    }
+
     Row Result::getRow(size_type tup_num) const
     {
       return Row(new ResultRow(const_cast<Result*>(this), tup_num));
@@ -69,5 +99,64 @@ namespace tntdb
       log_debug("PQnfields(" << result << ')');
       return ::PQnfields(result);
     }
+
+    namespace
+    {
+      // converts the text representation of the values of one column
+      template <typename T>
+      void convertColumn(PGresult* result, int field_num, std::vector<T>& values,
+        std::vector<bool>& nulls)
+      {
+        if (field_num >= PQnfields(result))
+          throw FieldNotFound(cxxtools::convert<std::string>(field_num));
+
+        int n = PQntuples(result);
+        values.clear();
+        values.resize(n);
+        nulls.resize(n);
+
+        std::string s;
+        for (int row = 0; row < n; ++row)
+        {
+          nulls[row] = PQgetisnull(result, row, field_num);
+          if (!nulls[row])
+          {
+            s.assign(PQgetvalue(result, row, field_num), PQgetlength(result, row, field_num));
+            values[row] = cxxtools::convert<T>(s);
+          }
+        }
+      }
+    }
+
+    void Result::getColumn(size_type field_num, std::vector<int64_t>& values,
+      std::vector<bool>& nulls) const
+    {
+      convertColumn(result, field_num, values, nulls);
+    }
+
+    void Result::getColumn(size_type field_num, std::vector<double>& values,
+      std::vector<bool>& nulls) const
+    {
+      convertColumn(result, field_num, values, nulls);
+    }
+
+    void Result::getColumn(size_type field_num, std::vector<std::string>& values,
+      std::vector<bool>& nulls) const
+    {
+      if (field_num >= static_cast<size_type>(PQnfields(result)))
+        throw FieldNotFound(cxxtools::convert<std::string>(field_num));
+
+      int n = PQntuples(result);
+      values.clear();
+      values.resize(n);
+      nulls.resize(n);
+
+      for (int row = 0; row < n; ++row)
+      {
+        nulls[row] = PQgetisnull(result, row, field_num);
+        if (!nulls[row])
+          values[row].assign(PQgetvalue(result, row, field_num), PQgetlength(result, row, field_num));
+      }
+    }
   }
 }
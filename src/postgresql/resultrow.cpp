@@ -42,6 +42,10 @@ namespace tntdb
         result(result_),
         rownumber(rownumber_)
     {
+      size_type fc = result->getFieldCount();
+      values.reserve(fc);
+      for (size_type n = 0; n < fc; ++n)
+        values.add(ResultValue(this, n));
     }
 
     unsigned ResultRow::size() const
@@ -51,31 +55,62 @@ namespace tntdb
 
     Value ResultRow::getValueByNumber(size_type field_num) const
     {
-      return Value(new ResultValue(const_cast<ResultRow*>(this), field_num));
+      return values.get(field_num, const_cast<ResultRow*>(this));
     }
 
     Value ResultRow::getValueByName(const std::string& field_name) const
     {
-      unsigned fc = result->getFieldCount();
-      unsigned n;
-      for (n = 0; n < fc; ++n)
-        if (field_name == PQfname(getPGresult(), n))
-          break;
-
-      if (n == fc)
-        throw FieldNotFound(field_name);
-
-      return getValueByNumber(n);
+      return getValueByNumber(result->getColumns().getIndex(field_name));
     }
 
     std::string ResultRow::getColumnName(size_type field_num) const
     {
-        return PQfname(getPGresult(), field_num);
+      return result->getColumns().getName(field_num);
+    }
+
+    ResultRow::size_type ResultRow::getColumnIndex(const std::string& field_name) const
+    {
+      return result->getColumns().find(field_name);
     }
 
     PGresult* ResultRow::getPGresult() const
     {
       return result->getPGresult();
     }
+
+    bool ResultRow::isNull(size_type field_num) const
+    {
+      return values.at(field_num).isNull();
+    }
+
+    bool ResultRow::getBool(size_type field_num) const
+    {
+      return values.at(field_num).getBool();
+    }
+
+    int ResultRow::getInt(size_type field_num) const
+    {
+      return values.at(field_num).getInt();
+    }
+
+    int64_t ResultRow::getInt64(size_type field_num) const
+    {
+      return values.at(field_num).getInt64();
+    }
+
+    uint64_t ResultRow::getUnsigned64(size_type field_num) const
+    {
+      return values.at(field_num).getUnsigned64();
+    }
+
+    double ResultRow::getDouble(size_type field_num) const
+    {
+      return values.at(field_num).getDouble();
+    }
+
+    void ResultRow::getString(size_type field_num, std::string& ret) const
+    {
+      values.at(field_num).getString(ret);
+    }
   }
 }
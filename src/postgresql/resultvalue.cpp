@@ -27,18 +27,46 @@
  */
 
 #include <tntdb/postgresql/impl/resultvalue.h>
+#include <tntdb/postgresql/impl/resultrow.h>
+#include <tntdb/impl/numconvert.h>
+#include <tntdb/impl/isodatetime.h>
 #include <tntdb/error.h>
 #include <sstream>
 #include <cxxtools/log.h>
-#include <cxxtools/convert.h>
 #include <limits>
 
 log_define("tntdb.postgresql.resultvalue")
 
+namespace
+{
+  // ISO values may be followed by the time zone of timetz and timestamptz, which is ignored
+  bool isComplete(const char* s, std::size_t n, int len)
+  {
+    return n > 0
+      && (n == static_cast<std::size_t>(len) || s[n] == '+' || s[n] == '-');
+  }
+}
+
 namespace tntdb
 {
   namespace postgresql
   {
+    PGresult* ResultValue::getPGresult() const
+    {
+      return row->getPGresult();
+    }
+
+    template <typename T>
+    T ResultValue::getNumber(const char* tname) const
+    {
+      PGresult* res = getPGresult();
+      if (PQgetisnull(res, row->getRowNumber(), tup_num))
+        throw NullValue();
+      const char* value = PQgetvalue(res, row->getRowNumber(), tup_num);
+      int len = PQgetlength(res, row->getRowNumber(), tup_num);
+      return convertNumber<T>(value, len, tname);
+    }
+
     bool ResultValue::isNull() const
     {
       return PQgetisnull(getPGresult(), row->getRowNumber(), tup_num) != 0;
@@ -54,67 +82,72 @@ namespace tntdb
 
     short ResultValue::getShort() const
     {
-      return cxxtools::convert<short>(getString());
+      return getNumber<short>("short");
     }
 
     int ResultValue::getInt() const
     {
-      return cxxtools::convert<int>(getString());
+      return getNumber<int>("int");
     }
 
     long ResultValue::getLong() const
     {
-      return cxxtools::convert<long>(getString());
+      return getNumber<long>("long");
     }
 
     unsigned short ResultValue::getUnsignedShort() const
     {
-      return cxxtools::convert<unsigned short>(getString());
+      return getNumber<unsigned short>("unsigned short");
     }
 
     unsigned ResultValue::getUnsigned() const
     {
-      return cxxtools::convert<unsigned>(getString());
+      return getNumber<unsigned>("unsigned");
     }
 
     unsigned long ResultValue::getUnsignedLong() const
     {
-      return cxxtools::convert<unsigned long>(getString());
+      return getNumber<unsigned long>("unsigned long");
     }
 
     int32_t ResultValue::getInt32() const
     {
-      return cxxtools::convert<int32_t>(getString());
+      return getNumber<int32_t>("int32_t");
     }
 
     uint32_t ResultValue::getUnsigned32() const
     {
-      return cxxtools::convert<uint32_t>(getString());
+      return getNumber<uint32_t>("uint32_t");
     }
 
     int64_t ResultValue::getInt64() const
     {
-      return cxxtools::convert<int64_t>(getString());
+      return getNumber<int64_t>("int64_t");
     }
 
     uint64_t ResultValue::getUnsigned64() const
     {
-      return cxxtools::convert<uint64_t>(getString());
+      return getNumber<uint64_t>("uint64_t");
     }
 
     Decimal ResultValue::getDecimal() const
     {
-      return Decimal(getString());
+      PGresult* res = getPGresult();
+      if (PQgetisnull(res, row->getRowNumber(), tup_num))
+        throw NullValue();
+      const char* value = PQgetvalue(res, row->getRowNumber(), tup_num);
+      int len = PQgetlength(res, row->getRowNumber(), tup_num);
+      return Decimal(value, len);
     }
 
     float ResultValue::getFloat() const
     {
-      return cxxtools::convert<float>(getString());
+      return getNumber<float>("float");
     }
 
     double ResultValue::getDouble() const
     {
-      return cxxtools::convert<double>(getString());
+      return getNumber<double>("double");
     }
 
     char ResultValue::getChar() const
@@ -145,7 +178,15 @@ namespace tntdb
 
     Date ResultValue::getDate() const
     {
-      std::string value = PQgetvalue(getPGresult(), row->getRowNumber(), tup_num);
+      PGresult* res = getPGresult();
+      const char* data = PQgetvalue(res, row->getRowNumber(), tup_num);
+      int len = PQgetlength(res, row->getRowNumber(), tup_num);
+
+      Date ret;
+      if (parseIsoDate(data, len, ret) == static_cast<std::size_t>(len))
+        return ret;
+
+      std::string value(data, len);
       if (value.find('-') != std::string::npos)
       {
         // ISO 8601/SQL standard
@@ -184,7 +225,15 @@ namespace tntdb
 
     Time ResultValue::getTime() const
     {
-      std::string value = PQgetvalue(getPGresult(), row->getRowNumber(), tup_num);
+      PGresult* res = getPGresult();
+      const char* data = PQgetvalue(res, row->getRowNumber(), tup_num);
+      int len = PQgetlength(res, row->getRowNumber(), tup_num);
+
+      Time ret;
+      if (isComplete(data, parseIsoTime(data, len, ret), len))
+        return ret;
+
+      std::string value(data, len);
       char ch;
       unsigned short hour, min, sec, msec;
       float fsec;
@@ -205,7 +254,15 @@ namespace tntdb
 
     Datetime ResultValue::getDatetime() const
     {
-      std::string value = PQgetvalue(getPGresult(), row->getRowNumber(), tup_num);
+      PGresult* res = getPGresult();
+      const char* data = PQgetvalue(res, row->getRowNumber(), tup_num);
+      int len = PQgetlength(res, row->getRowNumber(), tup_num);
+
+      Datetime ret;
+      if (isComplete(data, parseIsoDatetime(data, len, ret), len))
+        return ret;
+
+      std::string value(data, len);
       log_debug("datetime value=" << value);
       if (value.find('-') != std::string::npos)
       {
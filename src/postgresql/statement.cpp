@@ -30,15 +30,20 @@
 #include <tntdb/postgresql/impl/connection.h>
 #include <tntdb/postgresql/impl/result.h>
 #include <tntdb/postgresql/impl/cursor.h>
+#include <tntdb/postgresql/impl/resultrow.h>
 #include <tntdb/postgresql/error.h>
 #include <tntdb/bits/result.h>
 #include <tntdb/bits/row.h>
 #include <tntdb/bits/value.h>
-#include <tntdb/stmtparser.h>
+#include <tntdb/parsedstmt.h>
+#include <tntdb/impl/numconvert.h>
+#include <tntdb/batch.h>
+#include <tntdb/rowvisitor.h>
+#include <algorithm>
+#include <cstdlib>
 #include <sstream>
 #include <limits>
 #include <cxxtools/log.h>
-#include <cxxtools/convert.h>
 #include "config.h"
 
 log_define("tntdb.postgresql.statement")
@@ -53,60 +58,15 @@ namespace tntdb
 {
   namespace postgresql
   {
-    typedef std::map<std::string, unsigned> hostvarMapType;
-
-    namespace
-    {
-      class SE : public StmtEvent
-      {
-          hostvarMapType& hostvarMap;
-          unsigned idx;
-
-        public:
-          SE(hostvarMapType& hm)
-            : hostvarMap(hm),
-              idx(0)
-            { }
-          std::string onHostVar(const std::string& name);
-          unsigned getMaxIdx() const  { return idx; }
-      };
-
-      std::string SE::onHostVar(const std::string& name)
-      {
-        unsigned n;
-
-        hostvarMapType::const_iterator it = hostvarMap.find(name);
-        if (it == hostvarMap.end())
-        {
-          n = idx++;
-          hostvarMap[name] = n;
-        }
-        else
-          n = it->second;
-
-        log_debug("hostvar :" << name << " => $" << (n + 1));
-
-        std::ostringstream r;
-        r << '$' << (n + 1);
-        return r.str();
-      }
-    }
-
     Statement::Statement(Connection* conn_, const std::string& query_)
-      : conn(conn_)
+      : conn(conn_),
+        parsed(ParsedStmt::get(query_, ParsedStmt::NUMBERED))
     {
-      // parse hostvars
-      StmtParser parser;
-      SE se(hostvarMap);
-      parser.parse(query_, se);
-
-      values.resize(se.getMaxIdx());
-
-      query = parser.getSql();
-
-      paramValues.resize(se.getMaxIdx());
-      paramLengths.resize(se.getMaxIdx());
-      paramFormats.resize(se.getMaxIdx());
+      unsigned n = parsed->getParamCount();
+      values.resize(n);
+      paramValues.resize(n);
+      paramLengths.resize(n);
+      paramFormats.resize(n);
     }
 
     Statement::~Statement()
@@ -124,14 +84,14 @@ namespace tntdb
       // prepare statement
 #ifdef HAVE_PQPREPARE
       log_debug("PQprepare(" << getPGConn() << ", \"" << s.str()
-        << "\", \"" << query << "\", 0, 0)");
+        << "\", \"" << getQuery() << "\", 0, 0)");
       PGresult* result = PQprepare(getPGConn(),
-        s.str().c_str(), query.c_str(), 0, 0);
+        s.str().c_str(), getQuery().c_str(), 0, 0);
 
       if (isError(result))
       {
         log_error(PQresultErrorMessage(result));
-        throw PgSqlError(query, "PQprepare", result, true);
+        throw PgSqlError(getQuery(), "PQprepare", result, true);
       }
 #else
       std::ostringstream sql;
@@ -140,7 +100,7 @@ namespace tntdb
         sql << (it == values.begin() ? " (" : ", " ) << it->getType();
       if (!values.empty())
         sql << ')';
-      sql << " AS " << query;
+      sql << " AS " << getQuery();
 
       log_debug("PQexec(" << getPGConn() << ", \"" << sql.str() << "\")");
       PGresult* result = PQexec(getPGConn(), sql.str().c_str());
@@ -163,6 +123,8 @@ namespace tntdb
       if (stmtName.empty())
         doPrepare();
 
+      resolveTextRefs(true);
+
       log_debug("PQexecPrepared(" << getPGConn() << ", \"" << stmtName
         << "\", " << values.size() << ", paramValues, paramLengths, paramFormats, 0)");
       PGresult* result = PQexecPrepared(getPGConn(), stmtName.c_str(),
@@ -171,106 +133,59 @@ namespace tntdb
       if (isError(result))
       {
         log_error(PQresultErrorMessage(result));
-        throw PgSqlError(query, "PQexecPrepared", result, true);
+        throw PgSqlError(getQuery(), "PQexecPrepared", result, true);
       }
 
       return result;
     }
 
     template <typename T>
-    void Statement::setValue(const std::string& col, T data)
+    void Statement::setValue(size_type idx, T data)
     {
-      hostvarMapType::const_iterator it = hostvarMap.find(col);
-      if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-      else
-      {
-        std::string v = cxxtools::convert<std::string>(data);
-        values[it->second].setValue(v);
-        paramFormats[it->second] = 0;
-      }
-    }
-
-    template <>
-    void Statement::setValue(const std::string& col, float data)
-    {
-      hostvarMapType::const_iterator it = hostvarMap.find(col);
-      if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-      else
+      if (idx < values.size())
       {
-        std::ostringstream v;
-        v.precision(24);
-        v << data;
-        values[it->second].setValue(v.str());
-        paramFormats[it->second] = 0;
+        char v[numberBufferSize];
+        values[idx].setValue(v, formatNumber(data, v));
+        paramFormats[idx] = 0;
       }
     }
 
     template <>
-    void Statement::setValue(const std::string& col, double data)
+    void Statement::setValue(size_type idx, Decimal data)
     {
-      hostvarMapType::const_iterator it = hostvarMap.find(col);
-      if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-      else
-      {
-        std::ostringstream v;
-        v.precision(24);
-        v << data;
-        values[it->second].setValue(v.str());
-        paramFormats[it->second] = 0;
-      }
-    }
-
-    template <>
-    void Statement::setValue(const std::string& col, Decimal data)
-    {
-      hostvarMapType::const_iterator it = hostvarMap.find(col);
-      if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-      else
+      if (idx < values.size())
       {
-        std::ostringstream v;
-        v.precision(24);
-        v << data;
-        values[it->second].setValue(v.str());
-        paramFormats[it->second] = 0;
+        values[idx].setDecimal(data);
+        paramFormats[idx] = 0;
       }
     }
 
     template <typename T>
-    void Statement::setStringValue(const std::string& col, T data, bool binary)
+    void Statement::setStringValue(size_type idx, T data, bool binary)
     {
-      hostvarMapType::const_iterator it = hostvarMap.find(col);
-      if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-      else
+      if (idx < values.size())
       {
-        values[it->second].setValue(data);
-        paramFormats[it->second] = binary;
+        values[idx].setValue(data);
+        paramFormats[idx] = binary;
       }
     }
 
     template <typename T>
-    void Statement::setIsoValue(const std::string& col, T data)
+    void Statement::setIsoValue(size_type idx, T data)
     {
-      hostvarMapType::const_iterator it = hostvarMap.find(col);
-      if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-      else
+      if (idx < values.size())
       {
-        values[it->second].setValue(data.getIso());
-        paramFormats[it->second] = 0;
+        char iso[T::isoLength];
+        values[idx].setValue(iso, data.getIso(iso));
+        paramFormats[idx] = 0;
       }
     }
 
 #ifndef HAVE_PQPREPARE
-    void Statement::setType(const std::string& col, const std::string& type)
+    void Statement::setType(size_type idx, const std::string& type)
     {
-      hostvarMapType::const_iterator it = hostvarMap.find(col);
-      if (it != hostvarMap.end())
-        values[it->second].setType(type);
+      if (idx < values.size())
+        values[idx].setType(type);
     }
 #endif
 
@@ -281,181 +196,226 @@ namespace tntdb
         it->setNull();
     }
 
-    void Statement::setNull(const std::string& col)
+    Statement::size_type Statement::paramIndex(const std::string& col)
     {
-      log_debug("setNull(\"" << col << "\")");
-
-      hostvarMapType::const_iterator it = hostvarMap.find(col);
-      if (it == hostvarMap.end())
+      size_type idx = findParam(col);
+      if (idx == npos)
         log_warn("hostvariable :" << col << " not found");
-      else
+      return idx;
+    }
+
+    Statement::size_type Statement::findParam(const std::string& col)
+    {
+      ParsedStmt::hostvarMapType::const_iterator it = parsed->getHostvarMap().find(col);
+      return it == parsed->getHostvarMap().end() ? npos : it->second;
+    }
+
+    void Statement::setNull(size_type idx)
+    {
+      log_debug("setNull(" << idx << ')');
+
+      if (idx < values.size())
       {
-        values[it->second].setNull();
-        paramFormats[it->second] = 0;
+        values[idx].setNull();
+        paramFormats[idx] = 0;
       }
     }
 
-    void Statement::setBool(const std::string& col, bool data)
+    void Statement::setBool(size_type idx, bool data)
     {
-      log_debug("setBool(\"" << col << "\", " << data << ')');
+      log_debug("setBool(" << idx << ", " << data << ')');
 
-      hostvarMapType::const_iterator it = hostvarMap.find(col);
-      if (it == hostvarMap.end())
-        log_warn("hostvariable :" << col << " not found");
-      else
+      if (idx < values.size())
       {
-        values[it->second].setValue(data ? "1" : "0");
-        paramFormats[it->second] = 0;
+        values[idx].setValue(data ? "1" : "0");
+        paramFormats[idx] = 0;
       }
 
-      SET_TYPE(col, "bool");
+      SET_TYPE(idx, "bool");
     }
 
-    void Statement::setShort(const std::string& col, short data)
+    void Statement::setShort(size_type idx, short data)
     {
-      log_debug("setShort(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "short");
+      log_debug("setShort(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "short");
     }
 
-    void Statement::setInt(const std::string& col, int data)
+    void Statement::setInt(size_type idx, int data)
     {
-      log_debug("setInt(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "int");
+      log_debug("setInt(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "int");
     }
 
-    void Statement::setLong(const std::string& col, long data)
+    void Statement::setLong(size_type idx, long data)
     {
-      log_debug("setLong(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "long");
+      log_debug("setLong(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "long");
     }
 
-    void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+    void Statement::setUnsignedShort(size_type idx, unsigned short data)
     {
-      log_debug("setUnsignedShort(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "unsigned short");
+      log_debug("setUnsignedShort(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "unsigned short");
     }
 
-    void Statement::setUnsigned(const std::string& col, unsigned data)
+    void Statement::setUnsigned(size_type idx, unsigned data)
     {
-      log_debug("setUnsigned(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "unsigned");
+      log_debug("setUnsigned(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "unsigned");
     }
 
-    void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+    void Statement::setUnsignedLong(size_type idx, unsigned long data)
     {
-      log_debug("setUnsignedLong(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "unsigned long");
+      log_debug("setUnsignedLong(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "unsigned long");
     }
 
-    void Statement::setInt32(const std::string& col, int32_t data)
+    void Statement::setInt32(size_type idx, int32_t data)
     {
-      log_debug("setInt32(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "int");
+      log_debug("setInt32(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "int");
     }
 
-    void Statement::setUnsigned32(const std::string& col, uint32_t data)
+    void Statement::setUnsigned32(size_type idx, uint32_t data)
     {
-      log_debug("setUnsigned32(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "int");
+      log_debug("setUnsigned32(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "int");
     }
 
-    void Statement::setInt64(const std::string& col, int64_t data)
+    void Statement::setInt64(size_type idx, int64_t data)
     {
-      log_debug("setInt64(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "bigint");
+      log_debug("setInt64(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "bigint");
     }
 
-    void Statement::setUnsigned64(const std::string& col, uint64_t data)
+    void Statement::setUnsigned64(size_type idx, uint64_t data)
     {
-      log_debug("setUnsigned64(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "bigint");
+      log_debug("setUnsigned64(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "bigint");
     }
 
-    void Statement::setDecimal(const std::string& col, const Decimal& data)
+    void Statement::setDecimal(size_type idx, const Decimal& data)
     {
-      log_debug("setDecimal(\"" << col << "\", " << data << ')');
-      setValue(col, data);
-      SET_TYPE(col, "numeric");
+      log_debug("setDecimal(" << idx << ", " << data << ')');
+      setValue(idx, data);
+      SET_TYPE(idx, "numeric");
     }
 
-    void Statement::setFloat(const std::string& col, float data)
+    void Statement::setFloat(size_type idx, float data)
     {
-      log_debug("setFloat(\"" << col << "\", " << data << ')');
+      log_debug("setFloat(" << idx << ", " << data << ')');
       if (data != data)
-        setValue(col, "NaN");
+        setStringValue(idx, "NaN");
       else if (data == std::numeric_limits<float>::infinity())
-        setValue(col, "Infinity");
+        setStringValue(idx, "Infinity");
       else if (data == -std::numeric_limits<float>::infinity())
-        setValue(col, "-Infinity");
+        setStringValue(idx, "-Infinity");
       else
-        setValue(col, data);
-      SET_TYPE(col, "numeric");
+        setValue(idx, data);
+      SET_TYPE(idx, "numeric");
     }
 
-    void Statement::setDouble(const std::string& col, double data)
+    void Statement::setDouble(size_type idx, double data)
     {
-      log_debug("setDouble(\"" << col << "\", " << data << ')');
+      log_debug("setDouble(" << idx << ", " << data << ')');
       if (data != data)
-        setValue(col, "NaN");
+        setStringValue(idx, "NaN");
       else if (data == std::numeric_limits<double>::infinity())
-        setValue(col, "Infinity");
+        setStringValue(idx, "Infinity");
       else if (data == -std::numeric_limits<double>::infinity())
-        setValue(col, "-Infinity");
+        setStringValue(idx, "-Infinity");
       else
-        setValue(col, data);
-      SET_TYPE(col, "numeric");
+        setValue(idx, data);
+      SET_TYPE(idx, "numeric");
     }
 
-    void Statement::setChar(const std::string& col, char data)
+    void Statement::setChar(size_type idx, char data)
     {
-      log_debug("setChar(\"" << col << "\", '" << data << "')");
-      setStringValue(col, std::string(1, data));
-      SET_TYPE(col, "text");
+      log_debug("setChar(" << idx << ", '" << data << "')");
+      setStringValue(idx, std::string(1, data));
+      SET_TYPE(idx, "text");
     }
 
-    void Statement::setString(const std::string& col, const std::string& data)
+    void Statement::setString(size_type idx, const std::string& data)
     {
-      log_debug("setString(\"" << col << "\", \"" << data << "\")");
-      setStringValue(col, data);
-      SET_TYPE(col, "text");
+      log_debug("setString(" << idx << ", \"" << data << "\")");
+      setStringValue(idx, data);
+      SET_TYPE(idx, "text");
     }
 
-    void Statement::setBlob(const std::string& col, const Blob& data)
+    void Statement::setBlob(size_type idx, const Blob& data)
     {
-      log_debug("setBlob(\"" << col << "\", Blob)");
-      setStringValue(col, std::string(data.data(), data.size()), true);
-      SET_TYPE(col, "blob");
+      log_debug("setBlob(" << idx << ", Blob)");
+      if (idx < values.size())
+      {
+        values[idx].setBlob(data);
+        paramFormats[idx] = 1;
+      }
+      SET_TYPE(idx, "blob");
     }
 
-    void Statement::setDate(const std::string& col, const Date& data)
+    void Statement::setString(size_type idx, const char* data, std::size_t length)
     {
-      log_debug("setDate(\"" << col << "\", " << data.getIso() << ')');
-      setIsoValue(col, data);
-      SET_TYPE(col, "date");
+      log_debug("setString(" << idx << ", \"" << std::string(data, length) << "\")");
+      if (idx < values.size())
+      {
+        values[idx].setValue(std::string(data, length));
+        paramFormats[idx] = 0;
+      }
+      SET_TYPE(idx, "text");
+    }
+
+    void Statement::setStringRef(size_type idx, const char* data, std::size_t length)
+    {
+      log_debug("setStringRef(" << idx << ", " << static_cast<const void*>(data) << ", " << length << ')');
+      if (idx < values.size())
+      {
+        values[idx].setRef(data, length, true);
+        paramFormats[idx] = 0;
+      }
+      SET_TYPE(idx, "text");
+    }
+
+    void Statement::setBlobRef(size_type idx, const char* data, std::size_t length)
+    {
+      log_debug("setBlobRef(" << idx << ", " << static_cast<const void*>(data) << ", " << length << ')');
+      if (idx < values.size())
+      {
+        values[idx].setRef(data, length, false);
+        paramFormats[idx] = 1;
+      }
+      SET_TYPE(idx, "blob");
+    }
+
+    void Statement::setDate(size_type idx, const Date& data)
+    {
+      log_debug("setDate(" << idx << ", " << data.getIso() << ')');
+      setIsoValue(idx, data);
+      SET_TYPE(idx, "date");
     }
 
-    void Statement::setTime(const std::string& col, const Time& data)
+    void Statement::setTime(size_type idx, const Time& data)
     {
-      log_debug("setTime(\"" << col << "\", " << data.getIso() << ')');
-      setIsoValue(col, data);
-      SET_TYPE(col, "time");
+      log_debug("setTime(" << idx << ", " << data.getIso() << ')');
+      setIsoValue(idx, data);
+      SET_TYPE(idx, "time");
     }
 
-    void Statement::setDatetime(const std::string& col, const Datetime& data)
+    void Statement::setDatetime(size_type idx, const Datetime& data)
     {
-      log_debug("setDatetime(\"" << col << "\", " << data.getIso() << ')');
-      setIsoValue(col, data);
-      SET_TYPE(col, "datetime");
+      log_debug("setDatetime(" << idx << ", " << data.getIso() << ')');
+      setIsoValue(idx, data);
+      SET_TYPE(idx, "datetime");
     }
 
     Statement::size_type Statement::execute()
@@ -506,6 +466,291 @@ namespace tntdb
       return new Cursor(this, fetchsize);
     }
 
+    void Statement::prepare()
+    {
+      if (stmtName.empty())
+        doPrepare();
+    }
+
+#ifdef HAVE_PQSETSINGLEROWMODE
+    // In single row mode libpq returns each row in a result of its own as
+    // soon as it is received, so neither the whole result set nor a server
+    // side cursor is needed. The visitor sees the same row object each time,
+    // which is switched to the next result.
+    Statement::size_type Statement::forEach(RowVisitor& visitor, unsigned /* fetchsize */)
+    {
+      if (stmtName.empty())
+        doPrepare();
+
+      resolveTextRefs(true);
+
+      PGconn* pgconn = getPGConn();
+
+      log_debug("PQsendQueryPrepared(" << pgconn << ", \"" << stmtName
+        << "\", " << values.size() << ", paramValues, paramLengths, paramFormats, 0)");
+      if (PQsendQueryPrepared(pgconn, stmtName.c_str(), getNParams(),
+          getParamValues(), getParamLengths(), getParamFormats(), 0) != 1)
+        throw PgConnError("PQsendQueryPrepared", pgconn);
+
+      log_debug("PQsetSingleRowMode(" << pgconn << ')');
+      if (PQsetSingleRowMode(pgconn) != 1)
+        log_warn("PQsetSingleRowMode failed; the rows are fetched at once");
+
+      size_type count = 0;
+      Result* result = 0;
+      tntdb::Row row;
+
+      try
+      {
+        PGresult* pgres;
+        while ((pgres = PQgetResult(pgconn)) != 0)
+        {
+          ExecStatusType status = PQresultStatus(pgres);
+          if (status == PGRES_SINGLE_TUPLE)
+          {
+            if (result == 0)
+            {
+              result = new Result(tntdb::Connection(conn), pgres);
+              row = tntdb::Row(new ResultRow(result, 0));
+            }
+            else
+              result->reset(pgres);
+
+            visitor.visit(row);
+            ++count;
+          }
+          else if (status == PGRES_TUPLES_OK || status == PGRES_COMMAND_OK)
+          {
+            // without single row mode the result holds all rows
+            if (PQntuples(pgres) > 0)
+            {
+              tntdb::Result all(new Result(tntdb::Connection(conn), pgres));
+              for (tntdb::Result::size_type n = 0; n < all.size(); ++n)
+              {
+                visitor.visit(all.getRow(n));
+                ++count;
+              }
+            }
+            else
+            {
+              log_debug("PQclear(" << pgres << ')');
+              PQclear(pgres);
+            }
+          }
+          else
+          {
+            log_error(PQresultErrorMessage(pgres));
+            throw PgSqlError(getQuery(), "PQgetResult", pgres, true);
+          }
+        }
+      }
+      catch (const std::exception&)
+      {
+        // the connection is not usable until all results are read
+        PGresult* pgres;
+        while ((pgres = PQgetResult(pgconn)) != 0)
+          PQclear(pgres);
+        throw;
+      }
+
+      return count;
+    }
+#endif
+
+#ifdef LIBPQ_HAS_PIPELINING
+    namespace
+    {
+      // Reads the pending results of a pipeline up to the result of the last
+      // sync point. Returns false, when the connection fails meanwhile.
+      bool drainPipeline(PGconn* pgconn)
+      {
+        bool lastNull = false;
+        while (true)
+        {
+          PGresult* result = PQgetResult(pgconn);
+          if (result == 0)
+          {
+            // the results of each query are terminated by a null pointer;
+            // two of them in a row mean, that nothing is pending
+            if (lastNull || PQstatus(pgconn) != CONNECTION_OK)
+              return false;
+            lastNull = true;
+            continue;
+          }
+
+          lastNull = false;
+          ExecStatusType status = PQresultStatus(result);
+          PQclear(result);
+          if (status == PGRES_PIPELINE_SYNC)
+            return true;
+        }
+      }
+    }
+
+    // The rows are sent in pipeline mode, so that we do not wait for the
+    // server after each row. A sync point follows each chunk of rows, which
+    // ends an implicit transaction. When a row fails, the server skips the
+    // remaining rows of the chunk and rolls back the chunk; the chunks before
+    // are committed unless a transaction is active, which is aborted then.
+    Statement::size_type Statement::executeBatch(const Batch& batch)
+    {
+      static const Batch::size_type chunkSize = 256;
+
+      Batch::size_type rows = batch.getRowCount();
+      if (rows == 0)
+        return 0;
+
+      if (stmtName.empty())
+        doPrepare();
+
+      std::vector<size_type> idx;
+      batch.paramIndexes(*this, idx);
+
+      // Borrowed host variables, which are not part of the batch, may need
+      // PQdescribePrepared, which is not allowed in pipeline mode. The rows
+      // of the batch are bound by value.
+      resolveTextRefs(true);
+
+      PGconn* pgconn = getPGConn();
+      bool inTransaction = PQtransactionStatus(pgconn) == PQTRANS_INTRANS;
+
+      log_debug("PQenterPipelineMode(" << pgconn << ')');
+      if (PQenterPipelineMode(pgconn) != 1)
+        throw PgConnError("PQenterPipelineMode", pgconn);
+
+      size_type count = 0;
+      bool failed = false;
+      Batch::size_type failedRow = 0;
+      std::string failedMsg;
+      bool sent = false;  // queries or a sync point were sent, whose results are not read yet
+
+      try
+      {
+        for (Batch::size_type first = 0; first < rows && !failed; first += chunkSize)
+        {
+          Batch::size_type last = std::min(first + chunkSize, rows);
+
+          for (Batch::size_type row = first; row < last; ++row)
+          {
+            batch.bindRow(*this, idx, row);
+            if (PQsendQueryPrepared(pgconn, stmtName.c_str(), getNParams(),
+                getParamValues(), getParamLengths(), getParamFormats(), 0) != 1)
+              throw PgConnError("PQsendQueryPrepared", pgconn);
+            sent = true;
+          }
+
+          log_debug("PQpipelineSync(" << pgconn << ") after " << (last - first) << " rows");
+          if (PQpipelineSync(pgconn) != 1)
+            throw PgConnError("PQpipelineSync", pgconn);
+
+          size_type chunkCount = 0;
+          for (Batch::size_type row = first; row < last; ++row)
+          {
+            PGresult* result = PQgetResult(pgconn);
+            ExecStatusType status = PQresultStatus(result);
+            if (status == PGRES_COMMAND_OK || status == PGRES_TUPLES_OK)
+              chunkCount += std::atoi(PQcmdTuples(result));
+            else if (status != PGRES_PIPELINE_ABORTED && !failed)
+            {
+              failed = true;
+              failedRow = row;
+              failedMsg = result ? PQresultErrorMessage(result) : PQerrorMessage(pgconn);
+            }
+
+            if (result)
+            {
+              PQclear(result);
+              // the results of each query are terminated by a null pointer
+              while ((result = PQgetResult(pgconn)) != 0)
+                PQclear(result);
+            }
+          }
+
+          // result of the sync point
+          PQclear(PQgetResult(pgconn));
+          sent = false;
+
+          // the failed chunk is rolled back
+          if (!failed)
+            count += chunkCount;
+        }
+      }
+      catch (const std::exception&)
+      {
+        // pipeline mode can only be left, when all results are read
+        bool clean = !sent
+          || (PQpipelineSync(pgconn) == 1 && drainPipeline(pgconn));
+
+        log_debug("PQexitPipelineMode(" << pgconn << ')');
+        if (!clean || PQexitPipelineMode(pgconn) != 1)
+        {
+          // Resetting the session here would drop the other prepared
+          // statements and the transaction of the connection behind its
+          // back. The connection is marked broken, so that it fails the
+          // next ping and the pool discards it.
+          log_warn("connection unusable after failed batch: " << PQerrorMessage(pgconn));
+          conn->setBroken();
+        }
+
+        throw;
+      }
+
+      log_debug("PQexitPipelineMode(" << pgconn << ')');
+      PQexitPipelineMode(pgconn);
+
+      if (failed)
+        throw BatchError(failedRow, failedMsg, inTransaction ? 0 : count);
+
+      return count;
+    }
+#endif
+
+    void Statement::resolveTextRefs(bool prepared)
+    {
+      // Text parameters in text format need a terminating zero, which
+      // borrowed data does not have. The binary format of the text types is
+      // the raw string, so a borrowed string can be passed as is, when the
+      // server expects one of these types. Otherwise it is copied.
+      for (unsigned n = 0; n < values.size(); ++n)
+      {
+        if (!values[n].isTextRef())
+          continue;
+
+#ifdef HAVE_PQPREPARE
+        if (prepared && paramTypes.empty() && !stmtName.empty())
+        {
+          log_debug("PQdescribePrepared(" << getPGConn() << ", \"" << stmtName << "\")");
+          PGresult* result = PQdescribePrepared(getPGConn(), stmtName.c_str());
+          if (isError(result))
+          {
+            log_error(PQresultErrorMessage(result));
+            throw PgSqlError(getQuery(), "PQdescribePrepared", result, true);
+          }
+
+          paramTypes.resize(values.size());
+          for (unsigned p = 0; p < paramTypes.size() && p < static_cast<unsigned>(PQnparams(result)); ++p)
+            paramTypes[p] = PQparamtype(result, p);
+
+          log_debug("PQclear(" << result << ')');
+          PQclear(result);
+        }
+
+        Oid type = n < paramTypes.size() ? paramTypes[n] : 0;
+        bool isText = prepared && (type == 25 || type == 1042 || type == 1043); // text, bpchar, varchar
+#else
+        bool isText = prepared;  // the statement was prepared with type text
+#endif
+
+        if (isText)
+          paramFormats[n] = 1;
+        else
+        {
+          values[n].copyRef();
+          paramFormats[n] = 0;
+        }
+      }
+    }
+
     const char* const* Statement::getParamValues()
     {
       for (unsigned n = 0; n < values.size(); ++n)
@@ -155,6 +155,23 @@ namespace tntdb
       return true;
     }
 
+    bool Connection::isAlive()
+    {
+      for (Connections::iterator it = connections.begin(); it != connections.end(); ++it)
+        if (!it->getImpl()->isAlive())
+          return false;
+      return true;
+    }
+
+    bool Connection::reset()
+    {
+      bool ret = true;
+      for (Connections::iterator it = connections.begin(); it != connections.end(); ++it)
+        if (!it->getImpl()->reset())
+          ret = false;
+      return ret;
+    }
+
     long Connection::lastInsertId(const std::string& name)
     {
       return connections.begin()->lastInsertId(name);
@@ -73,130 +73,198 @@ namespace tntdb
         it->clear();
     }
 
-    void Statement::setNull(const std::string& col)
+    Statement::size_type Statement::paramIndex(const std::string& col)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setNull(col);
+      HostvarMapType::const_iterator it = hostvarMap.find(col);
+      if (it != hostvarMap.end())
+        return it->second;
+
+      std::vector<size_type> p;
+      for (Statements::iterator s = statements.begin(); s != statements.end(); ++s)
+        p.push_back(s->getImpl()->paramIndex(col));
+
+      size_type idx = params.size();
+      params.push_back(p);
+      hostvarMap.insert(HostvarMapType::value_type(col, idx));
+      return idx;
     }
 
-    void Statement::setBool(const std::string& col, bool data)
+    // all statements run the same query, so the first one tells, whether
+    // the host variable exists
+    Statement::size_type Statement::findParam(const std::string& col)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setBool(col, data);
+      if (hostvarMap.find(col) == hostvarMap.end()
+        && statements.begin()->findParam(col) == npos)
+        return npos;
+      return paramIndex(col);
     }
 
-    void Statement::setShort(const std::string& col, short data)
+    void Statement::setNull(size_type idx)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setShort(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setNull(params[idx][n]);
     }
 
-    void Statement::setInt(const std::string& col, int data)
+    void Statement::setBool(size_type idx, bool data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setInt(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setBool(params[idx][n], data);
     }
 
-    void Statement::setLong(const std::string& col, long data)
+    void Statement::setShort(size_type idx, short data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setLong(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setShort(params[idx][n], data);
     }
 
-    void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+    void Statement::setInt(size_type idx, int data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setUnsignedShort(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setInt(params[idx][n], data);
     }
 
-    void Statement::setUnsigned(const std::string& col, unsigned data)
+    void Statement::setLong(size_type idx, long data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setUnsigned(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setLong(params[idx][n], data);
     }
 
-    void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+    void Statement::setUnsignedShort(size_type idx, unsigned short data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setUnsignedLong(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setUnsignedShort(params[idx][n], data);
     }
 
-    void Statement::setInt32(const std::string& col, int32_t data)
+    void Statement::setUnsigned(size_type idx, unsigned data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setInt32(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setUnsigned(params[idx][n], data);
     }
 
-    void Statement::setUnsigned32(const std::string& col, uint32_t data)
+    void Statement::setUnsignedLong(size_type idx, unsigned long data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setUnsigned32(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setUnsignedLong(params[idx][n], data);
     }
 
-    void Statement::setInt64(const std::string& col, int64_t data)
+    void Statement::setInt32(size_type idx, int32_t data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setInt64(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setInt32(params[idx][n], data);
     }
 
-    void Statement::setUnsigned64(const std::string& col, uint64_t data)
+    void Statement::setUnsigned32(size_type idx, uint32_t data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setUnsigned64(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setUnsigned32(params[idx][n], data);
     }
 
-    void Statement::setDecimal(const std::string& col, const Decimal& data)
+    void Statement::setInt64(size_type idx, int64_t data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setDecimal(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setInt64(params[idx][n], data);
     }
 
-    void Statement::setFloat(const std::string& col, float data)
+    void Statement::setUnsigned64(size_type idx, uint64_t data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setFloat(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setUnsigned64(params[idx][n], data);
     }
 
-    void Statement::setDouble(const std::string& col, double data)
+    void Statement::setDecimal(size_type idx, const Decimal& data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setDouble(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setDecimal(params[idx][n], data);
     }
 
-    void Statement::setChar(const std::string& col, char data)
+    void Statement::setFloat(size_type idx, float data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setChar(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setFloat(params[idx][n], data);
     }
 
-    void Statement::setString(const std::string& col, const std::string& data)
+    void Statement::setDouble(size_type idx, double data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setString(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setDouble(params[idx][n], data);
     }
 
-    void Statement::setBlob(const std::string& col, const Blob& data)
+    void Statement::setChar(size_type idx, char data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setBlob(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setChar(params[idx][n], data);
     }
 
-    void Statement::setDate(const std::string& col, const Date& data)
+    void Statement::setString(size_type idx, const std::string& data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setDate(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setString(params[idx][n], data);
     }
 
-    void Statement::setTime(const std::string& col, const Time& data)
+    void Statement::setBlob(size_type idx, const Blob& data)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setTime(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setBlob(params[idx][n], data);
     }
 
-    void Statement::setDatetime(const std::string& col, const Datetime& data)
+    void Statement::setString(size_type idx, const char* data, std::size_t length)
     {
-      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
-        it->setDatetime(col, data);
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setString(params[idx][n], data, length);
+    }
+
+    void Statement::setStringRef(size_type idx, const char* data, std::size_t length)
+    {
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setStringRef(params[idx][n], data, length);
+    }
+
+    void Statement::setBlobRef(size_type idx, const char* data, std::size_t length)
+    {
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setBlobRef(params[idx][n], data, length);
+    }
+
+    void Statement::setDate(size_type idx, const Date& data)
+    {
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setDate(params[idx][n], data);
+    }
+
+    void Statement::setTime(size_type idx, const Time& data)
+    {
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setTime(params[idx][n], data);
+    }
+
+    void Statement::setDatetime(size_type idx, const Datetime& data)
+    {
+      if (idx < params.size())
+        for (Statements::size_type n = 0; n < statements.size(); ++n)
+          statements[n].getImpl()->setDatetime(params[idx][n], data);
     }
 
     Statement::size_type Statement::execute()
@@ -224,6 +292,31 @@ namespace tntdb
       return ret;
     }
 
+    Statement::size_type Statement::executeBatch(const Batch& batch)
+    {
+      tntdb::Connection c(conn);
+      Transaction transaction(c);
+
+      Statement::size_type ret = statements[0].executeBatch(batch);
+
+      for (Statements::size_type n = 1; n < statements.size(); ++n)
+      {
+        try
+        {
+          statements[n].executeBatch(batch);
+        }
+        catch (const tntdb::Error& e)
+        {
+          std::ostringstream msg;
+          msg << "replication failed on " << (n + 1) << ". connection: " << e.what();
+          throw tntdb::Error(msg.str());
+        }
+      }
+
+      transaction.commit();
+      return ret;
+    }
+
     tntdb::Result Statement::select()
     {
       return statements.begin()->select();
@@ -244,5 +337,16 @@ namespace tntdb
       return statements.begin()->getImpl()->createCursor(fetchsize);
     }
 
+    Statement::size_type Statement::forEach(RowVisitor& visitor, unsigned fetchsize)
+    {
+      return statements.begin()->forEach(visitor, fetchsize);
+    }
+
+    void Statement::prepare()
+    {
+      for (Statements::iterator it = statements.begin(); it != statements.end(); ++it)
+        it->getImpl()->prepare();
+    }
+
   }
 }
@@ -30,6 +30,8 @@
 #include <tntdb/value.h>
 #include <tntdb/error.h>
 #include <cxxtools/log.h>
+#include <limits>
+#include <sstream>
 
 log_define("tntdb.result")
 
@@ -50,6 +52,102 @@ namespace tntdb
     return getRow(row_num);
   }
 
+  namespace
+  {
+    template <typename T>
+    bool fitsInteger(int64_t v)
+    {
+      return v >= static_cast<int64_t>(std::numeric_limits<T>::min())
+          && v <= static_cast<int64_t>(std::numeric_limits<T>::max());
+    }
+
+    // infinity and NaN are representable as float
+    bool fitsFloat(double v)
+    {
+      double a = v < 0 ? -v : v;
+      return !(a > std::numeric_limits<float>::max())
+          || a == std::numeric_limits<double>::infinity();
+    }
+
+    // Converts a column to a narrower type; values out of range throw a
+    // TypeError like the scalar getters of Value.
+    template <typename T, typename S>
+    void narrowColumn(const IResult& r, IResult::size_type field_num,
+      std::vector<T>& values, std::vector<bool>& nulls,
+      bool (*fits)(S), const char* tname)
+    {
+      std::vector<S> v;
+      r.getColumn(field_num, v, nulls);
+
+      values.clear();
+      values.reserve(v.size());
+      for (typename std::vector<S>::size_type n = 0; n < v.size(); ++n)
+      {
+        if (!nulls[n] && !fits(v[n]))
+        {
+          std::ostringstream msg;
+          msg << "can't convert \"" << v[n] << "\" to " << tname;
+          throw TypeError(msg.str());
+        }
+
+        values.push_back(static_cast<T>(v[n]));
+      }
+    }
+
+    template <typename T>
+    void readColumn(const IResult& r, IResult::size_type field_num,
+      std::vector<T>& values, std::vector<bool>& nulls, T (Value::*getter)() const)
+    {
+      IResult::size_type n = r.size();
+      values.clear();
+      values.resize(n);
+      nulls.resize(n);
+      for (IResult::size_type row = 0; row < n; ++row)
+      {
+        Value v = r.getRow(row).getValue(field_num);
+        nulls[row] = v.isNull();
+        if (!nulls[row])
+          values[row] = (v.*getter)();
+      }
+    }
+  }
+
+  void IResult::getColumn(size_type field_num, std::vector<int64_t>& values,
+    std::vector<bool>& nulls) const
+  {
+    readColumn(*this, field_num, values, nulls, &Value::getInt64);
+  }
+
+  void IResult::getColumn(size_type field_num, std::vector<double>& values,
+    std::vector<bool>& nulls) const
+  {
+    readColumn(*this, field_num, values, nulls, &Value::getDouble);
+  }
+
+  void IResult::getColumn(size_type field_num, std::vector<std::string>& values,
+    std::vector<bool>& nulls) const
+  {
+    readColumn(*this, field_num, values, nulls, &Value::getString);
+  }
+
+  void Result::fillColumn(const IResult& r, size_type field_num,
+    std::vector<int>& values, std::vector<bool>& nulls)
+  {
+    narrowColumn<int, int64_t>(r, field_num, values, nulls, &fitsInteger<int>, "int");
+  }
+
+  void Result::fillColumn(const IResult& r, size_type field_num,
+    std::vector<unsigned>& values, std::vector<bool>& nulls)
+  {
+    narrowColumn<unsigned, int64_t>(r, field_num, values, nulls, &fitsInteger<unsigned>, "unsigned");
+  }
+
+  void Result::fillColumn(const IResult& r, size_type field_num,
+    std::vector<float>& values, std::vector<bool>& nulls)
+  {
+    narrowColumn<float, double>(r, field_num, values, nulls, &fitsFloat, "float");
+  }
+
   Result::const_iterator Result::begin() const
   {
     log_debug("Result::begin()");
@@ -27,22 +27,119 @@
  */
 
 #include <tntdb/impl/result.h>
+#include <tntdb/impl/value.h>
 #include <tntdb/row.h>
+#include <tntdb/value.h>
+#include <tntdb/error.h>
+#include <stdexcept>
 
 namespace tntdb
 {
+  ResultImpl::ResultImpl(ColumnDescriptor* columns)
+    : _columns(columns),
+      _fieldCount(columns->size()),
+      _rowCount(0)
+  {
+    _offsets.push_back(0);
+  }
+
+  void ResultImpl::reserve(size_type rows, std::size_t bytes)
+  {
+    _data.reserve(bytes);
+    _offsets.reserve(rows * _fieldCount + 1);
+    _nulls.reserve(rows * _fieldCount);
+  }
+
   Row ResultImpl::getRow(size_type tup_num) const
   {
-    return data[tup_num];
+    if (tup_num >= _rowCount)
+      throw std::out_of_range("row index out of range");
+    return Row(new ResultRowImpl(const_cast<ResultImpl*>(this), tup_num));
   }
 
   ResultImpl::size_type ResultImpl::size() const
   {
-    return data.size();
+    return _rowCount;
   }
 
   ResultImpl::size_type ResultImpl::getFieldCount() const
   {
-    return data.empty() ? 0 : data.begin()->size();
+    return _fieldCount;
+  }
+
+  ResultRowImpl::ResultRowImpl(ResultImpl* result, size_type row)
+    : _result(result),
+      _row(row)
+  {
+    size_type fc = _result->getFieldCount();
+    _values.reserve(fc);
+    for (size_type n = 0; n < fc; ++n)
+    {
+      // the values reference the buffer of the result, which is kept by this row
+      if (_result->isNull(_row, n))
+        _values.add(ValueImpl());
+      else
+        _values.add(ValueImpl(_result->data(_row, n), _result->length(_row, n), 0));
+    }
+  }
+
+  ResultRowImpl::size_type ResultRowImpl::size() const
+  {
+    return _result->getFieldCount();
+  }
+
+  Value ResultRowImpl::getValueByNumber(size_type field_num) const
+  {
+    return _values.get(field_num, const_cast<ResultRowImpl*>(this));
+  }
+
+  Value ResultRowImpl::getValueByName(const std::string& field_name) const
+  {
+    return getValueByNumber(_result->getColumns().getIndex(field_name));
+  }
+
+  std::string ResultRowImpl::getColumnName(size_type field_num) const
+  {
+    return _result->getColumns().getName(field_num);
+  }
+
+  ResultRowImpl::size_type ResultRowImpl::getColumnIndex(const std::string& field_name) const
+  {
+    return _result->getColumns().find(field_name);
+  }
+
+  bool ResultRowImpl::isNull(size_type field_num) const
+  {
+    return _values.at(field_num).isNull();
+  }
+
+  bool ResultRowImpl::getBool(size_type field_num) const
+  {
+    return _values.at(field_num).getBool();
+  }
+
+  int ResultRowImpl::getInt(size_type field_num) const
+  {
+    return _values.at(field_num).getInt();
+  }
+
+  int64_t ResultRowImpl::getInt64(size_type field_num) const
+  {
+    return _values.at(field_num).getInt64();
+  }
+
+  uint64_t ResultRowImpl::getUnsigned64(size_type field_num) const
+  {
+    return _values.at(field_num).getUnsigned64();
+  }
+
+  double ResultRowImpl::getDouble(size_type field_num) const
+  {
+    return _values.at(field_num).getDouble();
+  }
+
+  void ResultRowImpl::getString(size_type field_num, std::string& ret) const
+  {
+    _values.at(field_num).getString(ret);
   }
 }
@@ -31,6 +31,52 @@
 
 namespace tntdb
 {
+  const IRow::size_type IRow::npos;
+
+  IRow::size_type IRow::getColumnIndex(const std::string& field_name) const
+  {
+    size_type n;
+    for (n = 0; n < size(); ++n)
+      if (getColumnName(n) == field_name)
+        return n;
+    return npos;
+  }
+
+  bool IRow::isNull(size_type field_num) const
+  {
+    return getValueByNumber(field_num).isNull();
+  }
+
+  bool IRow::getBool(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getBool();
+  }
+
+  int IRow::getInt(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getInt();
+  }
+
+  int64_t IRow::getInt64(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getInt64();
+  }
+
+  uint64_t IRow::getUnsigned64(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getUnsigned64();
+  }
+
+  double IRow::getDouble(size_type field_num) const
+  {
+    return getValueByNumber(field_num).getDouble();
+  }
+
+  void IRow::getString(size_type field_num, std::string& ret) const
+  {
+    getValueByNumber(field_num).getString(ret);
+  }
+
   Row::const_iterator Row::begin() const
   {
     return const_iterator(*this, 0);
@@ -40,26 +40,57 @@ namespace tntdb
 
   Value RowImpl::getValueByNumber(size_type field_num) const
   {
-    return data[field_num].value;
+    return data.at(field_num);
   }
 
   Value RowImpl::getValueByName(const std::string& field_name) const
   {
-    data_type::const_iterator it;
+    return data[columns->getIndex(field_name)];
+  }
+
+  std::string RowImpl::getColumnName(size_type field_num) const
+  {
+    return columns->getName(field_num);
+  }
 
-    for (it = data.begin(); it != data.end(); ++it)
-      if (it->name == field_name)
-        break;
+  RowImpl::size_type RowImpl::getColumnIndex(const std::string& field_name) const
+  {
+    return columns->find(field_name);
+  }
 
-    if (it == data.end())
-      throw FieldNotFound(field_name);
+  bool RowImpl::isNull(size_type field_num) const
+  {
+    return data.at(field_num).isNull();
+  }
 
-    return it->value;
+  bool RowImpl::getBool(size_type field_num) const
+  {
+    return data.at(field_num).getBool();
   }
 
-  std::string RowImpl::getColumnName(size_type field_num) const
+  int RowImpl::getInt(size_type field_num) const
+  {
+    return data.at(field_num).getInt();
+  }
+
+  int64_t RowImpl::getInt64(size_type field_num) const
+  {
+    return data.at(field_num).getInt64();
+  }
+
+  uint64_t RowImpl::getUnsigned64(size_type field_num) const
+  {
+    return data.at(field_num).getUnsigned64();
+  }
+
+  double RowImpl::getDouble(size_type field_num) const
+  {
+    return data.at(field_num).getDouble();
+  }
+
+  void RowImpl::getString(size_type field_num, std::string& ret) const
   {
-    return data[field_num].name;
+    data.at(field_num).getString(ret);
   }
 
 }
@@ -147,6 +147,17 @@ namespace tntdb
       return db != 0;
     }
 
+    bool Connection::reset()
+    {
+      if (transactionActive > 0 || ::sqlite3_get_autocommit(db) == 0)
+      {
+        transactionActive = 1;
+        rollbackTransaction();
+      }
+
+      return true;
+    }
+
     long Connection::lastInsertId(const std::string& name)
     {
       return static_cast<int>(sqlite3_last_insert_rowid(db));
@@ -28,6 +28,7 @@
 
 #include <tntdb/sqlite/impl/cursor.h>
 #include <tntdb/sqlite/impl/stmtrow.h>
+#include <tntdb/sqlite/impl/statement.h>
 #include <tntdb/sqlite/error.h>
 #include <tntdb/row.h>
 #include <cxxtools/log.h>
@@ -57,7 +58,10 @@ namespace tntdb
       else if (ret != SQLITE_ROW)
         throw Execerror("sqlite3_step", stmt, ret);
 
-      return Row(new StmtRow(getStmt()));
+      if (!row)
+        row = Row(new StmtRow(getStmt(), Statement::createColumnDescriptor(stmt).getPointer()));
+
+      return row;
     }
   }
 }
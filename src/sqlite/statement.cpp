@@ -28,6 +28,7 @@
 
 #include <tntdb/sqlite/impl/statement.h>
 #include <tntdb/sqlite/impl/cursor.h>
+#include <tntdb/sqlite/impl/stmtrow.h>
 #include <tntdb/sqlite/impl/connection.h>
 #include <tntdb/impl/result.h>
 #include <tntdb/impl/row.h>
@@ -39,6 +40,8 @@
 #include <tntdb/result.h>
 #include <tntdb/row.h>
 #include <tntdb/value.h>
+#include <tntdb/batch.h>
+#include <tntdb/rowvisitor.h>
 #include <sstream>
 #include <limits>
 #include <cxxtools/log.h>
@@ -121,6 +124,30 @@ namespace tntdb
       return stmt;
     }
 
+    cxxtools::SmartPtr<ColumnDescriptor> Statement::createColumnDescriptor(sqlite3_stmt* stmt)
+    {
+      log_debug("sqlite3_column_count(" << stmt << ')');
+      int count = ::sqlite3_column_count(stmt);
+
+      cxxtools::SmartPtr<ColumnDescriptor> columns = new ColumnDescriptor();
+      columns->reserve(count);
+
+      for (int i = 0; i < count; ++i)
+      {
+        log_debug("sqlite3_column_name(" << stmt << ", " << i << ')');
+        const char* name = ::sqlite3_column_name(stmt, i);
+        if (name == 0)
+          throw std::bad_alloc();
+
+        log_debug("sqlite3_column_decltype(" << stmt << ", " << i << ')');
+        const char* type = ::sqlite3_column_decltype(stmt, i);
+
+        columns->add(name, type ? type : "");
+      }
+
+      return columns;
+    }
+
     void Statement::putback(sqlite3_stmt* stmt_)
     {
       if (stmt == 0)
@@ -141,15 +168,21 @@ namespace tntdb
       }
     }
 
-    int Statement::getBindIndex(const std::string& col)
+    Statement::size_type Statement::paramIndex(const std::string& col)
+    {
+      size_type idx = findParam(col);
+      if (idx == npos)
+        log_warn("hostvariable :" << col << " not found");
+      return idx;
+    }
+
+    Statement::size_type Statement::findParam(const std::string& col)
     {
       getBindStmt();
 
       log_debug("sqlite3_bind_parameter_index(" << stmt << ", :" << col  << ')');
       int idx = ::sqlite3_bind_parameter_index(stmt, (':' + col).c_str());
-      if (idx == 0)
-        log_warn("hostvariable :" << col << " not found");
-      return idx;
+      return idx == 0 ? npos : static_cast<size_type>(idx);
     }
 
     void Statement::reset()
@@ -181,13 +214,13 @@ namespace tntdb
         if (ret != SQLITE_OK)
           throw Execerror("sqlite3_bind_null", stmt, ret);
       }
+
+      blobs.clear();
     }
 
-    void Statement::setNull(const std::string& col)
+    void Statement::setNull(size_type idx)
     {
-      int idx = getBindIndex(col);
-      getBindStmt();
-      if (idx != 0)
+      if (idx != npos)
       {
         reset();
 
@@ -199,21 +232,19 @@ namespace tntdb
       }
     }
 
-    void Statement::setBool(const std::string& col, bool data)
+    void Statement::setBool(size_type idx, bool data)
     {
-      setInt(col, data ? 1 : 0);
+      setInt(idx, data ? 1 : 0);
     }
 
-    void Statement::setShort(const std::string& col, short data)
+    void Statement::setShort(size_type idx, short data)
     {
-      setInt(col, data);
+      setInt(idx, data);
     }
 
-    void Statement::setInt(const std::string& col, int data)
+    void Statement::setInt(size_type idx, int data)
     {
-      int idx = getBindIndex(col);
-      getBindStmt();
-      if (idx != 0)
+      if (idx != npos)
       {
         reset();
 
@@ -225,11 +256,9 @@ namespace tntdb
       }
     }
 
-    void Statement::setLong(const std::string& col, long data)
+    void Statement::setLong(size_type idx, long data)
     {
-      int idx = getBindIndex(col);
-      getBindStmt();
-      if (idx != 0)
+      if (idx != npos)
       {
         reset();
 
@@ -241,57 +270,55 @@ namespace tntdb
       }
     }
 
-    void Statement::setInt32(const std::string& col, int32_t data)
+    void Statement::setInt32(size_type idx, int32_t data)
     {
-      setInt(col, data);
+      setInt(idx, data);
     }
 
-    void Statement::setUnsignedShort(const std::string& col, unsigned short data)
+    void Statement::setUnsignedShort(size_type idx, unsigned short data)
     {
       if (data > static_cast<unsigned short>(std::numeric_limits<unsigned short>::max()))
       {
         log_warn("possible loss of precision while converting unsigned short " << data
           << " to double");
-        setDouble(col, static_cast<double>(data));
+        setDouble(idx, static_cast<double>(data));
       }
       else
-        setInt(col, static_cast<int>(data));
+        setInt(idx, static_cast<int>(data));
     }
 
-    void Statement::setUnsigned(const std::string& col, unsigned data)
+    void Statement::setUnsigned(size_type idx, unsigned data)
     {
       if (data > static_cast<unsigned>(std::numeric_limits<int>::max()))
       {
         log_warn("possible loss of precision while converting unsigned " << data
           << " to double");
-        setDouble(col, static_cast<double>(data));
+        setDouble(idx, static_cast<double>(data));
       }
       else
-        setInt(col, static_cast<int>(data));
+        setInt(idx, static_cast<int>(data));
     }
 
-    void Statement::setUnsignedLong(const std::string& col, unsigned long data)
+    void Statement::setUnsignedLong(size_type idx, unsigned long data)
     {
       if (data > static_cast<unsigned long>(std::numeric_limits<long>::max()))
       {
         log_warn("possible loss of precision while converting long unsigned " << data
           << " to double");
-        setDouble(col, static_cast<double>(data));
+        setDouble(idx, static_cast<double>(data));
       }
       else
-        setLong(col, static_cast<long>(data));
+        setLong(idx, static_cast<long>(data));
     }
 
-    void Statement::setUnsigned32(const std::string& col, uint32_t data)
+    void Statement::setUnsigned32(size_type idx, uint32_t data)
     {
-      setUnsigned(col, data);
+      setUnsigned(idx, data);
     }
 
-    void Statement::setInt64(const std::string& col, int64_t data)
+    void Statement::setInt64(size_type idx, int64_t data)
     {
-      int idx = getBindIndex(col);
-      getBindStmt();
-      if (idx != 0)
+      if (idx != npos)
       {
         reset();
 
@@ -303,12 +330,12 @@ namespace tntdb
       }
     }
 
-    void Statement::setUnsigned64(const std::string& col, uint64_t data)
+    void Statement::setUnsigned64(size_type idx, uint64_t data)
     {
-      setInt64(col, (int64_t)data);
+      setInt64(idx, (int64_t)data);
     }
 
-    void Statement::setDecimal(const std::string& col, const Decimal& data)
+    void Statement::setDecimal(size_type idx, const Decimal& data)
     {
       // SQLite 3.4.1 does not support the SQL decimal or numeric types.
       // So double is used instead, but of course binary floating point can
@@ -320,19 +347,17 @@ namespace tntdb
       // yet the API documentation talks about returning an int, double
       // or text string.
       double d = data.getDouble();
-      setDouble(col, d);
+      setDouble(idx, d);
     }
 
-    void Statement::setFloat(const std::string& col, float data)
+    void Statement::setFloat(size_type idx, float data)
     {
-      setDouble(col, static_cast<double>(data));
+      setDouble(idx, static_cast<double>(data));
     }
 
-    void Statement::setDouble(const std::string& col, double data)
+    void Statement::setDouble(size_type idx, double data)
     {
-      int idx = getBindIndex(col);
-      getBindStmt();
-      if (idx != 0)
+      if (idx != npos)
       {
         reset();
 
@@ -344,11 +369,9 @@ namespace tntdb
       }
     }
 
-    void Statement::setChar(const std::string& col, char data)
+    void Statement::setChar(size_type idx, char data)
     {
-      int idx = getBindIndex(col);
-      getBindStmt();
-      if (idx != 0)
+      if (idx != npos)
       {
         reset();
 
@@ -361,53 +384,84 @@ namespace tntdb
       }
     }
 
-    void Statement::setString(const std::string& col, const std::string& data)
+    void Statement::setString(size_type idx, const std::string& data)
     {
-      int idx = getBindIndex(col);
-      getBindStmt();
-      if (idx != 0)
+      setString(idx, data.data(), data.size());
+    }
+
+    void Statement::setString(size_type idx, const char* data, std::size_t length)
+    {
+      if (idx != npos)
       {
         reset();
 
-        log_debug("sqlite3_bind_text(" << stmt << ", " << idx << ", " << data
-          << ", " << data.size() << ", SQLITE_TRANSIENT)");
-        int ret = ::sqlite3_bind_text(stmt, idx, data.data(), data.size(), SQLITE_TRANSIENT);
+        log_debug("sqlite3_bind_text(" << stmt << ", " << idx << ", " << std::string(data, length)
+          << ", " << length << ", SQLITE_TRANSIENT)");
+        int ret = ::sqlite3_bind_text(stmt, idx, data, length, SQLITE_TRANSIENT);
 
         if (ret != SQLITE_OK)
           throw Execerror("sqlite3_bind_text", stmt, ret);
       }
     }
 
-    void Statement::setBlob(const std::string& col, const Blob& data)
+    void Statement::setStringRef(size_type idx, const char* data, std::size_t length)
     {
-      int idx = getBindIndex(col);
-      getBindStmt();
-      if (idx != 0)
+      if (idx != npos)
+      {
+        reset();
+
+        log_debug("sqlite3_bind_text(" << stmt << ", " << idx << ", "
+          << static_cast<const void*>(data) << ", " << length << ", SQLITE_STATIC)");
+        int ret = ::sqlite3_bind_text(stmt, idx, data, length, SQLITE_STATIC);
+
+        if (ret != SQLITE_OK)
+          throw Execerror("sqlite3_bind_text", stmt, ret);
+      }
+    }
+
+    void Statement::setBlob(size_type idx, const Blob& data)
+    {
+      if (idx != npos)
+      {
+        // keep a reference to the blob, so that sqlite does not need to copy the data
+        if (blobs.size() <= idx)
+          blobs.resize(idx + 1);
+        blobs[idx] = data;
+        setBlobRef(idx, data.data(), data.size());
+      }
+    }
+
+    void Statement::setBlobRef(size_type idx, const char* data, std::size_t length)
+    {
+      if (idx != npos)
       {
         reset();
 
         log_debug("sqlite3_bind_blob(" << stmt << ", " << idx << ", data, "
-            << data.size() << ", SQLITE_TRANSIENT)");
-        int ret = ::sqlite3_bind_blob(stmt, idx, data.data(), data.size(), SQLITE_TRANSIENT);
+            << length << ", SQLITE_STATIC)");
+        int ret = ::sqlite3_bind_blob(stmt, idx, data, length, SQLITE_STATIC);
 
         if (ret != SQLITE_OK)
           throw Execerror("sqlite3_bind_blob", stmt, ret);
       }
     }
 
-    void Statement::setDate(const std::string& col, const Date& data)
+    void Statement::setDate(size_type idx, const Date& data)
     {
-      setString(col, data.getIso());
+      char iso[Date::isoLength];
+      setString(idx, iso, data.getIso(iso));
     }
 
-    void Statement::setTime(const std::string& col, const Time& data)
+    void Statement::setTime(size_type idx, const Time& data)
     {
-      setString(col, data.getIso());
+      char iso[Time::isoLength];
+      setString(idx, iso, data.getIso(iso));
     }
 
-    void Statement::setDatetime(const std::string& col, const Datetime& data)
+    void Statement::setDatetime(size_type idx, const Datetime& data)
     {
-      setString(col, data.getIso());
+      char iso[Datetime::isoLength];
+      setString(idx, iso, data.getIso(iso));
     }
 
     Statement::size_type Statement::execute()
@@ -436,8 +490,10 @@ namespace tntdb
       reset();
       needReset = true;
 
-      ResultImpl* r = new ResultImpl();
+      ResultImpl* r = new ResultImpl(createColumnDescriptor(stmt).getPointer());
       Result result(r);
+      int count = r->getFieldCount();
+
       int ret;
       do
       {
@@ -446,10 +502,7 @@ namespace tntdb
 
         if (ret == SQLITE_ROW)
         {
-          log_debug("sqlite3_column_count(" << stmt << ')');
-          int count = ::sqlite3_column_count(stmt);
-          RowImpl* row = new RowImpl();
-          r->add(Row(row));
+          r->addRow();
           for (int i = 0; i < count; ++i)
           {
             log_debug("sqlite3_column_bytes(" << stmt << ", " << i << ')');
@@ -463,17 +516,10 @@ namespace tntdb
               txt = sqlite3_column_blob(stmt, i);
             }
 
-            Value v;
             if (txt)
-              v = Value(new ValueImpl(
-                std::string(static_cast<const char*>(txt), n)));
-
-            log_debug("sqlite3_column_name(" << stmt << ", " << i << ')');
-            const char* name = sqlite3_column_name(stmt, i);
-            if (name == 0)
-              throw std::bad_alloc();
-
-            row->add(name, v);
+              r->addValue(static_cast<const char*>(txt), n);
+            else
+              r->addNull();
           }
         }
         else if (ret != SQLITE_DONE)
@@ -499,10 +545,9 @@ namespace tntdb
         throw NotFound();
       else if (ret == SQLITE_ROW)
       {
-        log_debug("sqlite3_column_count(" << stmt << ')');
-        int count = ::sqlite3_column_count(stmt);
-        RowImpl* r = new RowImpl();
+        RowImpl* r = new RowImpl(createColumnDescriptor(stmt).getPointer());
         Row row(r);
+        int count = r->getColumns().size();
         for (int i = 0; i < count; ++i)
         {
           log_debug("sqlite3_column_bytes(" << stmt << ", " << i << ')');
@@ -521,12 +566,7 @@ namespace tntdb
             v = Value(new ValueImpl(
               std::string(static_cast<const char*>(txt), n)));
 
-          log_debug("sqlite3_column_name(" << stmt << ", " << i << ')');
-          const char* name = sqlite3_column_name(stmt, i);
-          if (name == 0)
-            throw std::bad_alloc();
-
-          r->add(name, v);
+          r->add(v);
         }
         return row;
       }
@@ -588,5 +628,96 @@ namespace tntdb
       return new Cursor(this, stmtInUse);
     }
 
+    Statement::size_type Statement::forEach(RowVisitor& visitor, unsigned /* fetchsize */)
+    {
+      reset();
+      needReset = true;
+
+      // the row reads the current values of the statement handle, so a
+      // single row serves all steps
+      Row row(new StmtRow(stmt, createColumnDescriptor(stmt).getPointer()));
+
+      size_type count = 0;
+      while (true)
+      {
+        log_debug("sqlite3_step(" << stmt << ')');
+        int ret = sqlite3_step(stmt);
+
+        if (ret == SQLITE_DONE)
+          break;
+        else if (ret != SQLITE_ROW)
+        {
+          log_debug("sqlite3_step failed with return code " << ret);
+          throw Execerror("sqlite3_step", stmt, ret);
+        }
+
+        visitor.visit(row);
+        ++count;
+      }
+
+      return count;
+    }
+
+    void Statement::prepare()
+    {
+      getBindStmt();
+    }
+
+    // Outside of a transaction sqlite commits and syncs every row on its
+    // own. The batch runs in one transaction instead, which is rolled back
+    // when a row fails. The statement handle is reused for all rows.
+    namespace
+    {
+      void rollbackBatch(Connection* conn, sqlite3* db)
+      {
+        if (::sqlite3_get_autocommit(db) != 0)
+          return;  // rolled back by sqlite already
+
+        try
+        {
+          conn->execute("ROLLBACK TRANSACTION");
+        }
+        catch (const std::exception& e)
+        {
+          log_warn("rollback of batch failed: " << e.what());
+        }
+      }
+    }
+
+    Statement::size_type Statement::executeBatch(const Batch& batch)
+    {
+      sqlite3* db = conn->getSqlite3();
+      bool implicitTransaction = batch.getRowCount() > 1
+                              && ::sqlite3_get_autocommit(db) != 0;
+
+      if (implicitTransaction)
+        conn->execute("BEGIN IMMEDIATE TRANSACTION");
+
+      try
+      {
+        size_type count = IStatement::executeBatch(batch);
+
+        if (implicitTransaction)
+          conn->execute("COMMIT TRANSACTION");
+
+        return count;
+      }
+      catch (const BatchError& e)
+      {
+        if (!implicitTransaction)
+          throw;
+
+        // the rows before the failing one are rolled back as well
+        rollbackBatch(conn, db);
+        throw BatchError(e.getRow(), e.getRowMessage(), 0);
+      }
+      catch (const std::exception&)
+      {
+        if (implicitTransaction)
+          rollbackBatch(conn, db);
+        throw;
+      }
+    }
+
   }
 }
@@ -34,6 +34,15 @@ namespace tntdb
 {
   namespace sqlite
   {
+    StmtRow::StmtRow(sqlite3_stmt* stmt_, ColumnDescriptor* columns_)
+      : stmt(stmt_),
+        columns(columns_)
+    {
+      values.reserve(columns->size());
+      for (unsigned n = 0; n < columns->size(); ++n)
+        values.add(StmtValue(stmt, n));
+    }
+
     unsigned StmtRow::size() const
     {
       return static_cast<unsigned>(::sqlite3_column_count(stmt));
@@ -41,20 +50,57 @@ namespace tntdb
 
     Value StmtRow::getValueByNumber(size_type field_num) const
     {
-      return Value(new StmtValue(stmt, field_num));
+      return values.get(field_num, const_cast<StmtRow*>(this));
     }
 
     Value StmtRow::getValueByName(const std::string& field_name) const
     {
-      return Value(new StmtValue(stmt, field_name));
+      return getValueByNumber(columns->getIndex(field_name));
     }
 
     std::string StmtRow::getColumnName(size_type field_num) const
     {
-      const char* name = sqlite3_column_name(stmt, field_num);
-      if (name == 0)
-        throw std::bad_alloc();
-      return name;
+      return columns->getName(field_num);
+    }
+
+    StmtRow::size_type StmtRow::getColumnIndex(const std::string& field_name) const
+    {
+      return columns->find(field_name);
+    }
+
+    bool StmtRow::isNull(size_type field_num) const
+    {
+      return values.at(field_num).isNull();
+    }
+
+    bool StmtRow::getBool(size_type field_num) const
+    {
+      return values.at(field_num).getBool();
+    }
+
+    int StmtRow::getInt(size_type field_num) const
+    {
+      return values.at(field_num).getInt();
+    }
+
+    int64_t StmtRow::getInt64(size_type field_num) const
+    {
+      return values.at(field_num).getInt64();
+    }
+
+    uint64_t StmtRow::getUnsigned64(size_type field_num) const
+    {
+      return values.at(field_num).getUnsigned64();
+    }
+
+    double StmtRow::getDouble(size_type field_num) const
+    {
+      return values.at(field_num).getDouble();
+    }
+
+    void StmtRow::getString(size_type field_num, std::string& ret) const
+    {
+      values.at(field_num).getString(ret);
     }
 
   }
@@ -199,20 +199,23 @@ namespace tntdb
 
     Date StmtValue::getDate() const
     {
-      std::string str = getString();
-      return Date::fromIso(str);
+      const char* data = reinterpret_cast<const char*>(::sqlite3_column_text(getStmt(), iCol));
+      int bytes = ::sqlite3_column_bytes(getStmt(), iCol);
+      return Date::fromIso(data, bytes);
     }
 
     Time StmtValue::getTime() const
     {
-      std::string str = getString();
-      return Time::fromIso(str);
+      const char* data = reinterpret_cast<const char*>(::sqlite3_column_text(getStmt(), iCol));
+      int bytes = ::sqlite3_column_bytes(getStmt(), iCol);
+      return Time::fromIso(data, bytes);
     }
 
     Datetime StmtValue::getDatetime() const
     {
-      std::string str = getString();
-      return Datetime::fromIso(str);
+      const char* data = reinterpret_cast<const char*>(::sqlite3_column_text(getStmt(), iCol));
+      int bytes = ::sqlite3_column_bytes(getStmt(), iCol);
+      return Datetime::fromIso(data, bytes);
     }
 
   }
@@ -31,6 +31,11 @@
 #include <tntdb/result.h>
 #include <tntdb/row.h>
 #include <tntdb/value.h>
+#include <tntdb/batch.h>
+#include <tntdb/blob.h>
+#include <tntdb/error.h>
+#include <tntdb/rowvisitor.h>
+#include <tntdb/iface/icursor.h>
 #include <cxxtools/utf8codec.h>
 #include <cxxtools/log.h>
 
@@ -62,15 +67,217 @@ namespace tntdb
     return _stmt->selectValue();
   }
 
+  Statement::size_type Statement::executeBatch(const Batch& batch)
+  {
+    log_trace("Statement::executeBatch(" << batch.getRowCount() << " rows)");
+    return _stmt->executeBatch(batch);
+  }
+
+  Statement::size_type Statement::forEach(RowVisitor& visitor, unsigned fetchsize)
+  {
+    log_trace("Statement::forEach(" << fetchsize << ')');
+    return _stmt->forEach(visitor, fetchsize);
+  }
+
   Statement::const_iterator Statement::begin(unsigned fetchsize) const
   {
     log_trace("Statement::begin(" << fetchsize << ')');
     return const_iterator(_stmt->createCursor(fetchsize));
   }
 
+  void IStatement::prepare()
+  {
+  }
+
+  const IStatement::size_type IStatement::npos;
+
+  IStatement::size_type IStatement::findParam(const std::string& col)
+  {
+    return paramIndex(col);
+  }
+
+  IStatement::size_type IStatement::executeBatch(const Batch& batch)
+  {
+    std::vector<size_type> idx;
+    batch.paramIndexes(*this, idx);
+
+    size_type count = 0;
+    for (Batch::size_type row = 0; row < batch.getRowCount(); ++row)
+    {
+      batch.bindRow(*this, idx, row);
+      try
+      {
+        count += execute();
+      }
+      catch (const std::exception& e)
+      {
+        throw BatchError(row, e.what(), count);
+      }
+    }
+
+    return count;
+  }
+
+  IStatement::size_type IStatement::forEach(RowVisitor& visitor, unsigned fetchsize)
+  {
+    cxxtools::SmartPtr<ICursor> cursor(createCursor(fetchsize));
+
+    size_type count = 0;
+    while (true)
+    {
+      Row row = cursor->fetch();
+      if (!row)
+        break;
+      visitor.visit(row);
+      ++count;
+    }
+
+    return count;
+  }
+
+  void IStatement::setUString(size_type idx, const cxxtools::String& data)
+  {
+    setString(idx, cxxtools::Utf8Codec::encode(data));
+  }
+
+  void IStatement::setString(size_type idx, const char* data, std::size_t length)
+  {
+    setString(idx, std::string(data, length));
+  }
+
+  void IStatement::setStringRef(size_type idx, const char* data, std::size_t length)
+  {
+    setString(idx, data, length);
+  }
+
+  void IStatement::setBlobRef(size_type idx, const char* data, std::size_t length)
+  {
+    setBlob(idx, Blob(data, length));
+  }
+
+  void IStatement::setNull(const std::string& col)
+  {
+    setNull(paramIndex(col));
+  }
+
+  void IStatement::setBool(const std::string& col, bool data)
+  {
+    setBool(paramIndex(col), data);
+  }
+
+  void IStatement::setShort(const std::string& col, short data)
+  {
+    setShort(paramIndex(col), data);
+  }
+
+  void IStatement::setInt(const std::string& col, int data)
+  {
+    setInt(paramIndex(col), data);
+  }
+
+  void IStatement::setLong(const std::string& col, long data)
+  {
+    setLong(paramIndex(col), data);
+  }
+
+  void IStatement::setUnsignedShort(const std::string& col, unsigned short data)
+  {
+    setUnsignedShort(paramIndex(col), data);
+  }
+
+  void IStatement::setUnsigned(const std::string& col, unsigned data)
+  {
+    setUnsigned(paramIndex(col), data);
+  }
+
+  void IStatement::setUnsignedLong(const std::string& col, unsigned long data)
+  {
+    setUnsignedLong(paramIndex(col), data);
+  }
+
+  void IStatement::setInt32(const std::string& col, int32_t data)
+  {
+    setInt32(paramIndex(col), data);
+  }
+
+  void IStatement::setUnsigned32(const std::string& col, uint32_t data)
+  {
+    setUnsigned32(paramIndex(col), data);
+  }
+
+  void IStatement::setInt64(const std::string& col, int64_t data)
+  {
+    setInt64(paramIndex(col), data);
+  }
+
+  void IStatement::setUnsigned64(const std::string& col, uint64_t data)
+  {
+    setUnsigned64(paramIndex(col), data);
+  }
+
+  void IStatement::setDecimal(const std::string& col, const Decimal& data)
+  {
+    setDecimal(paramIndex(col), data);
+  }
+
+  void IStatement::setFloat(const std::string& col, float data)
+  {
+    setFloat(paramIndex(col), data);
+  }
+
+  void IStatement::setDouble(const std::string& col, double data)
+  {
+    setDouble(paramIndex(col), data);
+  }
+
+  void IStatement::setChar(const std::string& col, char data)
+  {
+    setChar(paramIndex(col), data);
+  }
+
+  void IStatement::setString(const std::string& col, const std::string& data)
+  {
+    setString(paramIndex(col), data);
+  }
+
+  void IStatement::setBlob(const std::string& col, const Blob& data)
+  {
+    setBlob(paramIndex(col), data);
+  }
+
+  void IStatement::setDate(const std::string& col, const Date& data)
+  {
+    setDate(paramIndex(col), data);
+  }
+
+  void IStatement::setTime(const std::string& col, const Time& data)
+  {
+    setTime(paramIndex(col), data);
+  }
+
+  void IStatement::setDatetime(const std::string& col, const Datetime& data)
+  {
+    setDatetime(paramIndex(col), data);
+  }
+
   void IStatement::setUString(const std::string& col, const cxxtools::String& data)
   {
-    setString(col, cxxtools::Utf8Codec::encode(data));
+    setUString(paramIndex(col), data);
+  }
+
+  void IStatement::setString(const std::string& col, const char* data, std::size_t length)
+  {
+    setString(paramIndex(col), data, length);
+  }
+
+  void IStatement::setStringRef(const std::string& col, const char* data, std::size_t length)
+  {
+    setStringRef(paramIndex(col), data, length);
+  }
+
+  void IStatement::setBlobRef(const std::string& col, const char* data, std::size_t length)
+  {
+    setBlobRef(paramIndex(col), data, length);
   }
 }
 
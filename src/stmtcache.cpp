@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <tntdb/impl/stmtcache.h>
+#include <tntdb/iface/istatement.h>
+#include <cxxtools/serializationinfo.h>
+#include <cxxtools/log.h>
+
+log_define("tntdb.stmtcache")
+
+namespace tntdb
+{
+  StmtCache::StmtCache(unsigned capacity)
+  {
+    _statistics.capacity = capacity;
+  }
+
+  void StmtCache::evict()
+  {
+    while (_statistics.capacity > 0 && _index.size() > _statistics.capacity)
+    {
+      log_debug("evict statement for query \"" << _entries.back().first << "\" from cache");
+      _index.erase(_entries.back().first);
+      _entries.pop_back();
+      ++_statistics.evictions;
+    }
+  }
+
+  IStatement* StmtCache::get(const std::string& key)
+  {
+    IndexType::iterator it = _index.find(key);
+    if (it == _index.end())
+    {
+      ++_statistics.misses;
+      return 0;
+    }
+
+    ++_statistics.hits;
+
+    // move the entry to the front of the list
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return _entries.front().second.getPointer();
+  }
+
+  IStatement* StmtCache::getIdle(const std::string& key, bool& found)
+  {
+    IndexType::iterator it = _index.find(key);
+    found = (it != _index.end());
+    if (!found || it->second->second->refs() > 1)
+    {
+      ++_statistics.misses;
+      return 0;
+    }
+
+    ++_statistics.hits;
+    _entries.splice(_entries.begin(), _entries, it->second);
+    return _entries.front().second.getPointer();
+  }
+
+  void StmtCache::put(const std::string& key, IStatement* stmt)
+  {
+    IndexType::iterator it = _index.find(key);
+    if (it != _index.end())
+    {
+      it->second->second = stmt;
+      _entries.splice(_entries.begin(), _entries, it->second);
+      return;
+    }
+
+    _entries.push_front(EntryType(key, stmt));
+    _index[key] = _entries.begin();
+    evict();
+  }
+
+  bool StmtCache::erase(const std::string& key)
+  {
+    IndexType::iterator it = _index.find(key);
+    if (it == _index.end())
+      return false;
+
+    _entries.erase(it->second);
+    _index.erase(it);
+    return true;
+  }
+
+  void StmtCache::clear()
+  {
+    _index.clear();
+    _entries.clear();
+  }
+
+  void StmtCache::setCapacity(unsigned capacity)
+  {
+    _statistics.capacity = capacity;
+    evict();
+  }
+
+  StmtCacheStatistics StmtCache::getStatistics() const
+  {
+    StmtCacheStatistics statistics = _statistics;
+    statistics.size = _index.size();
+    return statistics;
+  }
+
+  void operator<<= (cxxtools::SerializationInfo& si, const StmtCacheStatistics& statistics)
+  {
+    si.setTypeName("StmtCacheStatistics");
+    si.addMember("capacity") <<= statistics.capacity;
+    si.addMember("size") <<= statistics.size;
+    si.addMember("hits") <<= statistics.hits;
+    si.addMember("misses") <<= statistics.misses;
+    si.addMember("evictions") <<= statistics.evictions;
+  }
+}
@@ -28,123 +28,133 @@
 
 #include <tntdb/stmtparser.h>
 #include <cxxtools/log.h>
-#include <cctype>
 
 log_define("tntdb.stmtparser")
 
 namespace tntdb
 {
+  namespace
+  {
+    inline bool isNameStart(char ch)
+    {
+      return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z');
+    }
+
+    inline bool isNameChar(char ch)
+    {
+      return isNameStart(ch) || (ch >= '0' && ch <= '9') || ch == '_';
+    }
+  }
+
   void StmtParser::parse(const std::string& sqlIn, StmtEvent& event)
   {
+    log_debug("parse sql \"" << sqlIn << "\"");
+
+    sql.clear();
+    sql.reserve(sqlIn.size() + 16);
+
+    const char* p = sqlIn.data();
+    const char* const e = p + sqlIn.size();
+
+    while (p != e)
     {
-      enum state_type {
-        STATE_0,
-        STATE_NAME0,
-        STATE_NAME,
-        STATE_STRING,
-        STATE_STRING_ESC,
-        STATE_ESC
-      } state = STATE_0;
-
-      std::string name;
-      sql.clear();
-      char end_token = '\0';
-
-      log_debug("parse sql \"" << sqlIn << "\"");
-
-      for (std::string::const_iterator it = sqlIn.begin();
-           it != sqlIn.end(); ++it)
+      // copy plain text up to the next special character in one piece
+      const char* s = p;
+      while (p != e && *p != praefixChar && *p != '\\'
+                    && *p != '\'' && *p != '"' && *p != '`')
+        ++p;
+
+      sql.append(s, p);
+      if (p == e)
+        break;
+
+      char ch = *p++;
+
+      if (ch == '\\')
+      {
+        // escaped character is taken as is
+        if (p != e)
+          sql += *p++;
+      }
+      else if (ch != praefixChar)
       {
-        char ch = *it;
-        switch(state)
+        // skip string literal; a backslash escapes the next character
+        sql += ch;
+        while (p != e)
         {
-          case STATE_0:
-            if (ch == praefixChar)
-              state = STATE_NAME0;
-            else if (ch == '\\')
-              state = STATE_ESC;
-            else
-            {
-              sql += ch;
-              if (ch == '\'' || ch == '"' || ch == '`')
-              {
-                state = STATE_STRING;
-                end_token = ch;
-              }
-            }
-            break;
+          s = p;
+          while (p != e && *p != ch && *p != '\\')
+            ++p;
 
-          case STATE_NAME0:
-            if (std::isalpha(ch))
-            {
-              name = ch;
-              state = STATE_NAME;
-            }
-            else if (ch == praefixChar)
-            {
-              sql += praefixChar;
-              sql += praefixChar;
-              state = STATE_0;
-            }
-            else if (ch == '\\')
-            {
-              sql += praefixChar;
-              state = STATE_ESC;
-            }
+          if (p == e)
+          {
+            sql.append(s, p);
             break;
+          }
 
-          case STATE_NAME:
-            if (std::isalnum(ch) || ch == '_')
-              name += ch;
-            else
-            {
-              log_debug("hostvar :" << name);
-              sql += event.onHostVar(name);
-              if (ch == '\\')
-                state = STATE_ESC;
-              else if (ch == praefixChar)
-                state = STATE_NAME0;
-              else
-              {
-                sql += ch;
-                state = STATE_0;
-              }
-            }
+          char t = *p++;
+          sql.append(s, p);
+          if (t == ch)
             break;
 
-          case STATE_STRING:
-            sql += ch;
-            if (ch == end_token)
-              state = STATE_0;
-            else if (ch == '\\')
-              state = STATE_STRING_ESC;
+          if (p != e)
+          {
+            t = *p++;
+            sql += t;
+            if (t == ch)
+              break;
+          }
+        }
+      }
+      else
+      {
+        // host variable; characters between the prefix and the name are dropped
+        while (true)
+        {
+          if (p == e)
+          {
+            sql += praefixChar;
             break;
+          }
 
-          case STATE_STRING_ESC:
-            sql += ch;
-            state = (ch == end_token ? STATE_0 : STATE_STRING);
-            break;
+          ch = *p++;
+          if (isNameStart(ch))
+          {
+            s = p - 1;
+            while (p != e && isNameChar(*p))
+              ++p;
 
-          case STATE_ESC:
-            sql += ch;
-            state = STATE_0;
-            break;
-        }
-      }
+            std::string name(s, p);
+            log_debug("hostvar :" << name);
+            sql += event.onHostVar(name);
 
-      switch(state)
-      {
-        case STATE_NAME0:
-          sql += praefixChar;
-          break;
+            if (p == e)
+              break;
 
-        case STATE_NAME:
-          log_debug("hostvar :" << name);
-          sql += event.onHostVar(name);
-          break;
+            ch = *p++;
+            if (ch == praefixChar)
+              continue;
 
-        default:
-          ;
+            if (ch != '\\')
+              sql += ch;
+            else if (p != e)
+              sql += *p++;
+            break;
+          }
+          else if (ch == praefixChar)
+          {
+            sql += praefixChar;
+            sql += praefixChar;
+            break;
+          }
+          else if (ch == '\\')
+          {
+            sql += praefixChar;
+            if (p != e)
+              sql += *p++;
+            break;
+          }
+        }
       }
     }
   }
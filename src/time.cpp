@@ -27,8 +27,8 @@
  */
 
 #include <tntdb/time.h>
+#include <tntdb/impl/isodatetime.h>
 #include <tntdb/error.h>
-#include <cctype>
 #include <sys/time.h>
 #include <time.h>
 
@@ -60,11 +60,12 @@ namespace tntdb
                 tv.tv_usec / 1000);
   }
 
-  std::string Time::getIso() const
+  const unsigned Time::isoLength;
+
+  unsigned Time::getIso(char* ret) const
   {
     // format hh:mm:ss.sss
     //        0....+....1....+
-    char ret[14];
     ret[0] = '0' + _hour / 10;
     ret[1] = '0' + _hour % 10;
     ret[2] = ':';
@@ -81,60 +82,26 @@ namespace tntdb
     n /= 10;
     ret[9] = '0' + n % 10;
 
-    return std::string(ret, 12);
+    return isoLength;
   }
 
-  inline unsigned short getNumber2(const char* s)
+  std::string Time::getIso() const
   {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1]))
-      throw TypeError();
-
-    return (s[0] - '0') * 10
-         + (s[1] - '0');
+    char ret[isoLength];
+    return std::string(ret, getIso(ret));
   }
 
-  inline unsigned short getNumber3(const char* s)
+  Time Time::fromIso(const std::string& s)
   {
-    if (!std::isdigit(s[0])
-      || !std::isdigit(s[1])
-      || !std::isdigit(s[2]))
-      throw TypeError();
-
-    return (s[0] - '0') * 100
-         + (s[1] - '0') * 10
-         + (s[2] - '0');
+    return fromIso(s.data(), s.size());
   }
 
-  Time Time::fromIso(const std::string& s)
+  Time Time::fromIso(const char* s, unsigned len)
   {
     Time ret;
-    const char* d = s.data();
-    try
-    {
-      if (s.size() == 12
-        && d[2] == ':'
-        && d[5] == ':'
-        && d[8] == '.')
-      {
-        ret.set(getNumber2(d), getNumber2(d + 3), getNumber2(d + 6),
-                getNumber3(d + 9));
-      }
-      else if (s.size() == 8
-        && d[2] == ':'
-        && d[5] == ':')
-      {
-        ret.set(getNumber2(d), getNumber2(d + 3), getNumber2(d + 6));
-      }
-      else
-        throw TypeError();
-    }
-    catch (const TypeError&)
-    {
-      throw TypeError("failed to convert string \"" + s + "\" into time");
-    }
-
+    std::size_t n = parseIsoTime(s, len, ret);
+    if (n == 0 || n != len)
+      throw TypeError("failed to convert string \"" + std::string(s, len) + "\" into time");
     return ret;
   }
 }
-
@@ -27,14 +27,14 @@
  */
 
 #include <tntdb/impl/value.h>
+#include <tntdb/impl/numconvert.h>
 #include <tntdb/date.h>
 #include <tntdb/time.h>
 #include <tntdb/datetime.h>
 #include <tntdb/decimal.h>
 #include <tntdb/blob.h>
 #include <tntdb/error.h>
-#include <sstream>
-#include <cxxtools/convert.h>
+#include <stdexcept>
 #include <cxxtools/utf8codec.h>
 
 namespace
@@ -44,25 +44,28 @@ namespace
     return ch == 't' || ch == 'T' || ch == 'y' || ch == 'Y' || ch == '1';
   }
 
-  template <typename T>
-  T getValue(const std::string& s, const char* tname)
-  {
-    try
-    {
-        return cxxtools::convert<T>(s);
-    }
-    catch (const cxxtools::ConversionError&)
-    {
-      std::ostringstream msg;
-      msg << "can't convert \"" << s << "\" to " << tname;
-      throw tntdb::TypeError(msg.str());
-    }
-  }
-
 }
 
 namespace tntdb
 {
+  ValueImpl::ValueImpl(const ValueImpl& v)
+    : null(v.null),
+      own(v.own),
+      ptr(v.ptr == v.own.data() ? own.data() : v.ptr),
+      len(v.len),
+      result(v.result)
+  { }
+
+  ValueImpl& ValueImpl::operator= (const ValueImpl& v)
+  {
+    null = v.null;
+    own = v.own;
+    ptr = v.ptr == v.own.data() ? own.data() : v.ptr;
+    len = v.len;
+    result = v.result;
+    return *this;
+  }
+
   bool ValueImpl::isNull() const
   {
     return null;
@@ -72,141 +75,143 @@ namespace tntdb
   {
     if (null)
       throw NullValue();
-    return !data.empty()
-        && isTrue(data.at(0));
+    return len > 0
+        && isTrue(ptr[0]);
   }
 
   short ValueImpl::getShort() const
   {
     if (null)
       throw NullValue();
-    return getValue<short>(data, "short");
+    return convertNumber<short>(ptr, len, "short");
   }
 
   int ValueImpl::getInt() const
   {
     if (null)
       throw NullValue();
-    return getValue<int>(data, "int");
+    return convertNumber<int>(ptr, len, "int");
   }
 
   long ValueImpl::getLong() const
   {
     if (null)
       throw NullValue();
-    return getValue<long>(data, "long");
+    return convertNumber<long>(ptr, len, "long");
   }
 
   unsigned short ValueImpl::getUnsignedShort() const
   {
     if (null)
       throw NullValue();
-    return getValue<unsigned short>(data, "unsigned short");
+    return convertNumber<unsigned short>(ptr, len, "unsigned short");
   }
 
   unsigned ValueImpl::getUnsigned() const
   {
     if (null)
       throw NullValue();
-    return getValue<unsigned>(data, "unsigned");
+    return convertNumber<unsigned>(ptr, len, "unsigned");
   }
 
   unsigned long ValueImpl::getUnsignedLong() const
   {
     if (null)
       throw NullValue();
-    return getValue<unsigned long>(data, "unsigned long");
+    return convertNumber<unsigned long>(ptr, len, "unsigned long");
   }
 
   int32_t ValueImpl::getInt32() const
   {
     if (null)
       throw NullValue();
-    return getValue<int32_t>(data, "int32_t");
+    return convertNumber<int32_t>(ptr, len, "int32_t");
   }
 
   uint32_t ValueImpl::getUnsigned32() const
   {
     if (null)
       throw NullValue();
-    return getValue<uint32_t>(data, "uint32_t");
+    return convertNumber<uint32_t>(ptr, len, "uint32_t");
   }
 
   int64_t ValueImpl::getInt64() const
   {
     if (null)
       throw NullValue();
-    return getValue<int64_t>(data, "int64_t");
+    return convertNumber<int64_t>(ptr, len, "int64_t");
   }
 
   uint64_t ValueImpl::getUnsigned64() const
   {
     if (null)
       throw NullValue();
-    return getValue<uint64_t>(data, "uint64_t");
+    return convertNumber<uint64_t>(ptr, len, "uint64_t");
   }
 
   Decimal ValueImpl::getDecimal() const
   {
     if (null)
       throw NullValue();
-    return getValue<Decimal>(data, "Decimal");
+    return Decimal(ptr, len);
   }
 
   float ValueImpl::getFloat() const
   {
     if (null)
       throw NullValue();
-    return getValue<float>(data, "float");
+    return convertNumber<float>(ptr, len, "float");
   }
 
   double ValueImpl::getDouble() const
   {
     if (null)
       throw NullValue();
-    return getValue<double>(data, "double");
+    return convertNumber<double>(ptr, len, "double");
   }
 
   char ValueImpl::getChar() const
   {
     if (null)
       throw NullValue();
-    return data.at(0);
+    if (len == 0)
+      throw std::out_of_range("empty value");
+    return ptr[0];
   }
 
   void ValueImpl::getString(std::string& ret) const
   {
     if (null)
       throw NullValue();
-    ret.assign(data);
+    ret.assign(ptr, len);
   }
 
   void ValueImpl::getBlob(Blob& ret) const
   {
     if (null)
       throw NullValue();
-    ret.assign(data.data(), data.size());
+    ret.assign(ptr, len);
   }
 
   Date ValueImpl::getDate() const
   {
     if (null)
       throw NullValue();
-    return Date::fromIso(data);
+    return Date::fromIso(ptr, len);
   }
 
   Time ValueImpl::getTime() const
   {
     if (null)
       throw NullValue();
-    return Time::fromIso(data);
+    return Time::fromIso(ptr, len);
   }
 
   Datetime ValueImpl::getDatetime() const
   {
     if (null)
       throw NullValue();
-    return Datetime::fromIso(data);
+    return Datetime::fromIso(ptr, len);
   }
 
   void IValue::getUString(cxxtools::String& ret) const
@@ -31,14 +31,58 @@
 #include <cxxtools/unit/registertest.h>
 #include <cxxtools/log.h>
 #include <stdlib.h>
+#include <stdexcept>
 #include <tntdb/connect.h>
 #include <tntdb/transaction.h>
 #include <tntdb/statement.h>
 #include <tntdb/row.h>
 #include <tntdb/value.h>
+#include <tntdb/batch.h>
+#include <tntdb/columnarresult.h>
+#include <tntdb/error.h>
+#include <tntdb/structmap.h>
+#include <tntdb/rowvisitor.h>
 
 log_define("tntdb.unit.base")
 
+namespace
+{
+#if __cplusplus >= 201103L
+  struct TestRow
+  {
+    int intcol;
+    int64_t longcol;
+    double doublecol;
+    std::string stringcol;
+
+    TestRow()
+      : intcol(0), longcol(0), doublecol(0)
+      { }
+  };
+#endif
+
+  class SumVisitor : public tntdb::RowVisitor
+  {
+    public:
+      int sum;
+      unsigned count;
+
+      SumVisitor()
+        : sum(0), count(0)
+        { }
+
+      void visit(const tntdb::Row& row)
+      {
+        sum += row.getInt(0);
+        ++count;
+      }
+  };
+}
+
+#if __cplusplus >= 201103L
+TNTDB_MAP(TestRow, intcol, longcol, doublecol, stringcol)
+#endif
+
 class TntdbBaseTest : public cxxtools::unit::TestSuite
 {
     tntdb::Connection conn;
@@ -60,6 +104,21 @@ class TntdbBaseTest : public cxxtools::unit::TestSuite
       registerMethod("testSelectPlaceholder", *this, &TntdbBaseTest::testSelectPlaceholder);
       registerMethod("testSelectMultiplePlaceholder", *this, &TntdbBaseTest::testSelectMultiplePlaceholder);
       registerMethod("testSelectCursorPlaceholder", *this, &TntdbBaseTest::testSelectCursorPlaceholder);
+      registerMethod("testParamHandle", *this, &TntdbBaseTest::testParamHandle);
+      registerMethod("testExecuteBatch", *this, &TntdbBaseTest::testExecuteBatch);
+      registerMethod("testExecuteBatchError", *this, &TntdbBaseTest::testExecuteBatchError);
+      registerMethod("testStringRef", *this, &TntdbBaseTest::testStringRef);
+      registerMethod("testStatementCache", *this, &TntdbBaseTest::testStatementCache);
+      registerMethod("testStatementCaching", *this, &TntdbBaseTest::testStatementCaching);
+      registerMethod("testColumnarResult", *this, &TntdbBaseTest::testColumnarResult);
+      registerMethod("testColumnNames", *this, &TntdbBaseTest::testColumnNames);
+      registerMethod("testColumnHandle", *this, &TntdbBaseTest::testColumnHandle);
+      registerMethod("testValueLifetime", *this, &TntdbBaseTest::testValueLifetime);
+      registerMethod("testTypedRowAccess", *this, &TntdbBaseTest::testTypedRowAccess);
+#if __cplusplus >= 201103L
+      registerMethod("testStructMap", *this, &TntdbBaseTest::testStructMap);
+#endif
+      registerMethod("testForEach", *this, &TntdbBaseTest::testForEach);
       registerMethod("testTransaction", *this, &TntdbBaseTest::testTransaction);
     }
 
@@ -343,6 +402,350 @@ class TntdbBaseTest : public cxxtools::unit::TestSuite
       CXXTOOLS_UNIT_ASSERT_EQUALS(count, 2);
     }
 
+    void testExecuteBatch()
+    {
+      tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol, stringcol) values(:intcol, :stringcol)");
+
+      tntdb::Batch batch;
+      batch.setInt("intcol", 4).setString("stringcol", "four").addRow();
+      batch.setInt("intcol", 5).addRow();
+      batch.setInt("intcol", 3).setString("stringcol", "three").addRow();
+
+      unsigned count = ins.executeBatch(batch);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(count, 3);
+
+      unsigned rows = 0;
+      conn.selectValue("select count(*) from tntdbtest").get(rows);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(rows, 3);
+
+      std::string s;
+      bool notNull = conn.selectValue("select stringcol from tntdbtest where intcol = 5").get(s);
+      CXXTOOLS_UNIT_ASSERT(!notNull);
+    }
+
+    void testExecuteBatchError()
+    {
+      // tntdbbatchtest has no trigger or default for its primary key, so that
+      // a duplicate id fails with every database
+      conn.execute("delete from tntdbbatchtest");
+      tntdb::Statement ins = conn.prepare("insert into tntdbbatchtest(id, v) values(:id, :v)");
+
+      tntdb::Batch batch;
+      batch.setInt("id", 1).setInt("v", 1).addRow();
+      batch.setInt("id", 2).setInt("v", 2).addRow();
+      batch.setInt("id", 1).setInt("v", 3).addRow();  // duplicate key
+      batch.setInt("id", 4).setInt("v", 4).addRow();
+
+      unsigned failedRow = 0;
+      unsigned affected = 0;
+      try
+      {
+        ins.executeBatch(batch);
+        CXXTOOLS_UNIT_FAIL("BatchError expected");
+      }
+      catch (const tntdb::BatchError& e)
+      {
+        failedRow = e.getRow();
+        affected = e.getAffectedRows();
+      }
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(failedRow, 2);
+
+      // the count tells, how many rows the driver kept
+      unsigned rows = 0;
+      conn.selectValue("select count(*) from tntdbbatchtest").get(rows);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(rows, affected);
+
+      conn.execute("delete from tntdbbatchtest");
+    }
+
+    void testStringRef()
+    {
+      // the borrowed data is not terminated with a zero
+      const char data[] = { 'h', 'e', 'l', 'l', 'o', 'X' };
+
+      conn.prepare("insert into tntdbtest(intcol, stringcol) values(1, :stringcol)")
+          .setStringRef("stringcol", data, 5)
+          .execute();
+
+      std::string s;
+      conn.selectValue("select stringcol from tntdbtest where intcol = 1").get(s);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(s, "hello");
+    }
+
+    void testStatementCache()
+    {
+      conn.clearStatementCache();
+      conn.setStatementCacheCapacity(2);
+      tntdb::StmtCacheStatistics before = conn.getStatementCacheStatistics();
+
+      conn.prepareCached("select intcol from tntdbtest", "a");
+      conn.prepareCached("select shortcol from tntdbtest", "b");
+      conn.prepareCached("select intcol from tntdbtest", "a");
+      conn.prepareCached("select stringcol from tntdbtest", "c");  // evicts b
+
+      tntdb::StmtCacheStatistics after = conn.getStatementCacheStatistics();
+      CXXTOOLS_UNIT_ASSERT_EQUALS(after.size, 2);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(after.hits - before.hits, 1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(after.misses - before.misses, 3);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(after.evictions - before.evictions, 1);
+
+      CXXTOOLS_UNIT_ASSERT(!conn.clearStatementCache("b"));
+      CXXTOOLS_UNIT_ASSERT(conn.clearStatementCache("a"));
+
+      conn.setStatementCacheCapacity(256);
+    }
+
+    void testStatementCaching()
+    {
+      conn.setStatementCaching(true);
+
+      const std::string query = "select count(*) from tntdbtest where intcol >= :value";
+      const tntdb::IStatement* first = conn.prepare(query).getImpl();
+      tntdb::Statement stmt = conn.prepare(query);
+      CXXTOOLS_UNIT_ASSERT(stmt.getImpl() == first);
+
+      // the cached statement is in use, so an independent one is returned
+      tntdb::Statement other = conn.prepare(query);
+      CXXTOOLS_UNIT_ASSERT(other.getImpl() != stmt.getImpl());
+
+      conn.setStatementCaching(false);
+    }
+
+    void testColumnarResult()
+    {
+      conn.execute("insert into tntdbtest(intcol, doublecol) values(1, 1.5)");
+      conn.execute("insert into tntdbtest(intcol) values(2)");
+      conn.execute("insert into tntdbtest(intcol, doublecol) values(3, 2.5)");
+
+      tntdb::ColumnarResult cr(conn.select("select intcol, doublecol from tntdbtest order by intcol"));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(cr.size(), 3);
+
+      const std::vector<int64_t>& ints = cr.getInt64Column(0);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(ints.size(), 3);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(ints[0], 1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(ints[2], 3);
+
+      const std::vector<double>& doubles = cr.getDoubleColumn(1);
+      CXXTOOLS_UNIT_ASSERT(!cr.isNull(1, 0));
+      CXXTOOLS_UNIT_ASSERT(cr.isNull(1, 1));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(doubles[0] + doubles[2], 4.0);
+
+      std::vector<int> v;
+      std::vector<bool> nulls;
+      conn.select("select intcol from tntdbtest order by intcol").getColumn(0, v, nulls);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(v.size(), 3);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(v[1], 2);
+      CXXTOOLS_UNIT_ASSERT(!nulls[1]);
+
+      // values out of range are not truncated
+      conn.execute("insert into tntdbtest(intcol, longcol) values(4, 5000000000)");
+      CXXTOOLS_UNIT_ASSERT_THROW(
+        conn.select("select longcol from tntdbtest where intcol = 4").getColumn(0, v, nulls),
+        tntdb::TypeError);
+    }
+
+    void testColumnNames()
+    {
+      conn.execute("insert into tntdbtest(intcol, stringcol) values(1, 'one')");
+      conn.execute("insert into tntdbtest(intcol, stringcol) values(2, 'two')");
+
+      tntdb::Result r = conn.select("select intcol, stringcol from tntdbtest order by intcol");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(r.size(), 2);
+      for (tntdb::Result::size_type n = 0; n < r.size(); ++n)
+      {
+        tntdb::Row row = r.getRow(n);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row.getName(0), "intcol");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row.getName(1), "stringcol");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row.getColumnIndex("intcol"), 0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row.getColumnIndex("stringcol"), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row["intcol"].getInt(), static_cast<int>(n + 1));
+      }
+
+      // rows of a prepared statement share the column names as well
+      tntdb::Result sr = conn.prepare("select intcol, stringcol from tntdbtest where intcol > :min order by intcol")
+                             .set("min", 0)
+                             .select();
+      CXXTOOLS_UNIT_ASSERT_EQUALS(sr.size(), 2);
+      for (tntdb::Result::size_type n = 0; n < sr.size(); ++n)
+      {
+        tntdb::Row row = sr.getRow(n);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row.getName(1), "stringcol");
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row.getColumnIndex("stringcol"), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(row["intcol"].getInt(), static_cast<int>(n + 1));
+      }
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(r.getRow(1)["stringcol"].getString(), "two");
+      CXXTOOLS_UNIT_ASSERT_THROW(r.getRow(0)["unknown"], tntdb::FieldNotFound);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(r.getRow(0).getColumnIndex("unknown"), tntdb::IRow::npos);
+    }
+
+    void testColumnHandle()
+    {
+      conn.execute("insert into tntdbtest(intcol, stringcol) values(1, 'one')");
+      conn.execute("insert into tntdbtest(intcol, stringcol) values(2, 'two')");
+
+      tntdb::Statement stmt = conn.prepare("select stringcol, intcol from tntdbtest order by intcol");
+
+      tntdb::Row::Column intcol("intcol");
+      tntdb::Row::Column unknown("unknown");
+      int sum = 0;
+      for (tntdb::Statement::const_iterator cur = stmt.begin(); cur != stmt.end(); ++cur)
+      {
+        sum += (*cur)[intcol].getInt();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(intcol.getIndex(), 1);
+        CXXTOOLS_UNIT_ASSERT_THROW((*cur)[unknown], tntdb::FieldNotFound);
+      }
+      CXXTOOLS_UNIT_ASSERT_EQUALS(sum, 3);
+
+      tntdb::Result r = stmt.select();
+      tntdb::Row::Column stringcol = r.getRow(0).column("stringcol");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(stringcol.getIndex(), 0);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(r.getRow(1).getValue(stringcol).getString(), "two");
+    }
+
+    void testValueLifetime()
+    {
+      conn.execute("insert into tntdbtest(intcol, stringcol) values(42, 'hi')");
+
+      // values keep their row and result alive
+      tntdb::Value v = conn.select("select intcol, stringcol from tntdbtest").getRow(0).getValue(1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(v.getString(), "hi");
+
+      // the value is the last reference to its row, when it is assigned
+      // and destroyed
+      {
+        tntdb::Value w;
+        {
+          tntdb::Row row = conn.selectRow("select intcol, stringcol from tntdbtest");
+          w = row.getValue(1);
+        }
+        CXXTOOLS_UNIT_ASSERT_EQUALS(w.getString(), "hi");
+
+        w = conn.selectRow("select intcol from tntdbtest").getValue(0);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(w.getInt(), 42);
+      }
+
+      tntdb::Statement stmt = conn.prepare("select intcol from tntdbtest");
+      for (tntdb::Statement::const_iterator cur = stmt.begin(); cur != stmt.end(); ++cur)
+      {
+        tntdb::Value a = (*cur)[0];
+        tntdb::Value b = (*cur)[0];
+        CXXTOOLS_UNIT_ASSERT_EQUALS(a.getInt() + b.getInt(), 84);
+      }
+    }
+
+    void testTypedRowAccess()
+    {
+      conn.execute("insert into tntdbtest(intcol, longcol, doublecol, stringcol) values(7, 8, 1.5, 'abc')");
+
+      tntdb::Row row = conn.selectRow("select intcol, longcol, doublecol, stringcol, shortcol from tntdbtest");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(row.getInt(0), 7);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(row.getInt64(1), 8);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(row.getDouble(2), 1.5);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(row.getString(3), "abc");
+      CXXTOOLS_UNIT_ASSERT(!row.isNull(0));
+      CXXTOOLS_UNIT_ASSERT(row.isNull(4));
+
+      int i = 0;
+      int64_t l = 0;
+      double d = 0;
+      std::string s;
+      int n = -1;
+      bool nNotNull = true;
+      row.reader().get(i).get(l).get(d).get(s).get(n, nNotNull);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(i, 7);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(l, 8);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(d, 1.5);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(s, "abc");
+      CXXTOOLS_UNIT_ASSERT(!nNotNull);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(n, -1);
+
+      CXXTOOLS_UNIT_ASSERT_THROW(row.isNull(row.size()), std::out_of_range);
+      CXXTOOLS_UNIT_ASSERT_THROW(row.getInt(row.size()), std::out_of_range);
+      CXXTOOLS_UNIT_ASSERT_THROW(row.getString(row.size()), std::out_of_range);
+
+      tntdb::Statement sel = conn.prepare("select intcol, stringcol from tntdbtest where intcol = :intcol");
+      tntdb::Row srow = sel.set("intcol", 7).selectRow();
+      CXXTOOLS_UNIT_ASSERT_EQUALS(srow.getInt(0), 7);
+      CXXTOOLS_UNIT_ASSERT_THROW(srow.getInt(srow.size()), std::out_of_range);
+      CXXTOOLS_UNIT_ASSERT_THROW(srow.getDouble(srow.size()), std::out_of_range);
+    }
+
+#if __cplusplus >= 201103L
+    void testStructMap()
+    {
+      tntdb::Statement ins = conn.prepare(
+        "insert into tntdbtest(intcol, longcol, doublecol, stringcol)"
+        " values(:intcol, :longcol, :doublecol, :stringcol)");
+
+      TestRow r;
+      for (int n = 1; n <= 3; ++n)
+      {
+        r.intcol = n;
+        r.longcol = n * 10;
+        r.doublecol = n + 0.5;
+        r.stringcol = std::string(n, 'x');
+        ins.setStruct(r).execute();
+      }
+
+      tntdb::Statement sel = conn.prepare(
+        "select stringcol, doublecol, longcol, intcol from tntdbtest order by intcol");
+
+      std::vector<TestRow> rows;
+      CXXTOOLS_UNIT_ASSERT_EQUALS(sel.selectInto(rows), 3);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(rows.size(), 3);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(rows[1].intcol, 2);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(rows[1].longcol, 20);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(rows[1].doublecol, 2.5);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(rows[1].stringcol, "xx");
+
+      unsigned count = 0;
+      for (tntdb::Cursor cur = sel.begin(); cur.fetchInto(r); ++count)
+        CXXTOOLS_UNIT_ASSERT_EQUALS(r.intcol, static_cast<int>(count + 1));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(count, 3);
+
+      rows.clear();
+      tntdb::Statement missing = conn.prepare("select intcol, longcol from tntdbtest");
+      CXXTOOLS_UNIT_ASSERT_THROW(missing.selectInto(rows), tntdb::FieldNotFound);
+      CXXTOOLS_UNIT_ASSERT(rows.empty());
+    }
+#endif
+
+    void testForEach()
+    {
+      tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol) values(:intcol)");
+      for (int n = 1; n <= 250; ++n)
+        ins.set("intcol", n).execute();
+
+      tntdb::Statement sel = conn.prepare("select intcol from tntdbtest where intcol > :min");
+
+      SumVisitor visitor;
+      CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set("min", 200).forEach(visitor), 50);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(visitor.count, 50);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(visitor.sum, 11275);
+
+      SumVisitor none;
+      CXXTOOLS_UNIT_ASSERT_EQUALS(sel.set("min", 250).forEach(none, 10), 0);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(none.count, 0);
+    }
+
+    void testParamHandle()
+    {
+      tntdb::Statement ins = conn.prepare("insert into tntdbtest(intcol, shortcol) values(:intcol, :intcol)");
+      tntdb::Statement::Param intcol = ins.param("intcol");
+      for (int n = 1; n <= 3; ++n)
+        intcol.set(n).execute();
+
+      tntdb::Statement sel = conn.prepare("select count(*) from tntdbtest where shortcol >= :value");
+      tntdb::Statement::size_type value = sel.paramIndex("value");
+      unsigned count = 0;
+      sel.setInt(value, 2).selectValue().get(count);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(count, 2);
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(sel.paramIndex("unknown"), tntdb::IStatement::npos);
+    }
+
     void testSelectCursorPlaceholder()
     {
       conn.execute("insert into tntdbtest(intcol, shortcol, longcol) values(5, 6, 7)");
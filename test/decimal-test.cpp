@@ -179,6 +179,15 @@ class TntdbDecimalTest : public cxxtools::unit::TestSuite
       d = tntdb::Decimal("nan");
       CXXTOOLS_UNIT_ASSERT_EQUALS(d.toString(), "nan");
 
+      std::string s = "previous value";
+      tntdb::Decimal("-123.45").toString(s);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(s, "-123.45");
+      tntdb::Decimal("1e23").toString(s);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(s, "1e23");
+
+      const char buffer[] = "45.6789";
+      d = tntdb::Decimal(buffer, 4);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(d.toString(), "45.6");
     }
 
     void testInt()
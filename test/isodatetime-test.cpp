@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <cxxtools/unit/testsuite.h>
+#include <cxxtools/unit/registertest.h>
+#include <tntdb/impl/isodatetime.h>
+#include <tntdb/date.h>
+#include <tntdb/time.h>
+#include <tntdb/datetime.h>
+#include <tntdb/error.h>
+#include <string.h>
+
+class TntdbIsoDatetimeTest : public cxxtools::unit::TestSuite
+{
+  public:
+    TntdbIsoDatetimeTest()
+      : cxxtools::unit::TestSuite("isodatetime")
+    {
+      registerMethod("testDate", *this, &TntdbIsoDatetimeTest::testDate);
+      registerMethod("testTime", *this, &TntdbIsoDatetimeTest::testTime);
+      registerMethod("testDatetime", *this, &TntdbIsoDatetimeTest::testDatetime);
+      registerMethod("testFormat", *this, &TntdbIsoDatetimeTest::testFormat);
+    }
+
+    void testDate()
+    {
+      CXXTOOLS_UNIT_ASSERT(tntdb::Date::fromIso("2014-03-07") == tntdb::Date(2014, 3, 7));
+      CXXTOOLS_UNIT_ASSERT_THROW(tntdb::Date::fromIso("2014-3-07"), tntdb::TypeError);
+      CXXTOOLS_UNIT_ASSERT_THROW(tntdb::Date::fromIso("2014-0a-07"), tntdb::TypeError);
+
+      // the text is used without a terminating zero
+      const char* s = "2014-03-07xyz";
+      CXXTOOLS_UNIT_ASSERT(tntdb::Date::fromIso(s, 10) == tntdb::Date(2014, 3, 7));
+    }
+
+    void testTime()
+    {
+      CXXTOOLS_UNIT_ASSERT(tntdb::Time::fromIso("12:34:56") == tntdb::Time(12, 34, 56));
+      CXXTOOLS_UNIT_ASSERT(tntdb::Time::fromIso("12:34:56.078") == tntdb::Time(12, 34, 56, 78));
+      CXXTOOLS_UNIT_ASSERT(tntdb::Time::fromIso("12:34:56.5") == tntdb::Time(12, 34, 56, 500));
+      CXXTOOLS_UNIT_ASSERT(tntdb::Time::fromIso("12:34:56.123999") == tntdb::Time(12, 34, 56, 123));
+      CXXTOOLS_UNIT_ASSERT_THROW(tntdb::Time::fromIso("12:34:56."), tntdb::TypeError);
+      CXXTOOLS_UNIT_ASSERT_THROW(tntdb::Time::fromIso("12:34:56+01"), tntdb::TypeError);
+
+      const char* s = "12:34:56+01";
+      tntdb::Time t;
+      CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::parseIsoTime(s, strlen(s), t), 8);
+      CXXTOOLS_UNIT_ASSERT(t == tntdb::Time(12, 34, 56));
+    }
+
+    void testDatetime()
+    {
+      tntdb::Datetime expected(2014, 3, 7, 1, 2, 3, 45);
+      CXXTOOLS_UNIT_ASSERT(tntdb::Datetime::fromIso("2014-03-07 01:02:03.045") == expected);
+      CXXTOOLS_UNIT_ASSERT(tntdb::Datetime::fromIso("2014-03-07T01:02:03.045") == expected);
+      CXXTOOLS_UNIT_ASSERT(tntdb::Datetime::fromIso("2014-03-07 01:02:03") == tntdb::Datetime(2014, 3, 7, 1, 2, 3));
+      CXXTOOLS_UNIT_ASSERT_THROW(tntdb::Datetime::fromIso("2014-03-07"), tntdb::TypeError);
+      CXXTOOLS_UNIT_ASSERT_THROW(tntdb::Datetime::fromIso("2014-03-07_01:02:03"), tntdb::TypeError);
+    }
+
+    void testFormat()
+    {
+      char buf[tntdb::Datetime::isoLength];
+      unsigned len = tntdb::Datetime(2014, 3, 7, 1, 2, 3, 45).getIso(buf);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(std::string(buf, len), "2014-03-07 01:02:03.045");
+
+      len = tntdb::Date(2014, 3, 7).getIso(buf);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(std::string(buf, len), "2014-03-07");
+
+      len = tntdb::Time(1, 2, 3, 4).getIso(buf);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(std::string(buf, len), "01:02:03.004");
+    }
+
+};
+
+cxxtools::unit::RegisterTest<TntdbIsoDatetimeTest> register_TntdbIsoDatetimeTest;
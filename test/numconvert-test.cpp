@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <cxxtools/unit/testsuite.h>
+#include <cxxtools/unit/registertest.h>
+#include <tntdb/impl/numconvert.h>
+#include <tntdb/error.h>
+#include <limits>
+#include <string.h>
+
+namespace
+{
+  template <typename T>
+  bool parse(const char* s, T& ret)
+  {
+    return tntdb::parseNumber(s, strlen(s), ret);
+  }
+
+  template <typename T>
+  T roundTrip(T value)
+  {
+    char buf[tntdb::numberBufferSize];
+    T ret;
+    std::size_t len = tntdb::formatNumber(value, buf);
+    return tntdb::parseNumber(buf, len, ret) ? ret : T(-1);
+  }
+}
+
+class TntdbNumconvertTest : public cxxtools::unit::TestSuite
+{
+  public:
+    TntdbNumconvertTest()
+      : cxxtools::unit::TestSuite("numconvert")
+    {
+      registerMethod("testParseInteger", *this, &TntdbNumconvertTest::testParseInteger);
+      registerMethod("testParseDouble", *this, &TntdbNumconvertTest::testParseDouble);
+      registerMethod("testFormat", *this, &TntdbNumconvertTest::testFormat);
+      registerMethod("testConvertNumber", *this, &TntdbNumconvertTest::testConvertNumber);
+    }
+
+    void testParseInteger()
+    {
+      int i;
+      CXXTOOLS_UNIT_ASSERT(parse(" -42 ", i));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(i, -42);
+      CXXTOOLS_UNIT_ASSERT(parse("+17", i));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(i, 17);
+      CXXTOOLS_UNIT_ASSERT(!parse("", i));
+      CXXTOOLS_UNIT_ASSERT(!parse("12a", i));
+      CXXTOOLS_UNIT_ASSERT(!parse("1 2", i));
+
+      short s;
+      CXXTOOLS_UNIT_ASSERT(parse("-32768", s));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(s, -32768);
+      CXXTOOLS_UNIT_ASSERT(!parse("32768", s));
+
+      unsigned u;
+      CXXTOOLS_UNIT_ASSERT(!parse("-1", u));
+
+      int64_t l;
+      CXXTOOLS_UNIT_ASSERT(parse("-9223372036854775808", l));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(l, std::numeric_limits<int64_t>::min());
+      CXXTOOLS_UNIT_ASSERT(!parse("9223372036854775808", l));
+
+      uint64_t ul;
+      CXXTOOLS_UNIT_ASSERT(parse("18446744073709551615", ul));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(ul, std::numeric_limits<uint64_t>::max());
+      CXXTOOLS_UNIT_ASSERT(!parse("18446744073709551616", ul));
+    }
+
+    void testParseDouble()
+    {
+      double d;
+      CXXTOOLS_UNIT_ASSERT(parse("3.25", d));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(d, 3.25);
+      CXXTOOLS_UNIT_ASSERT(parse(" -1.5e3 ", d));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(d, -1500.0);
+      CXXTOOLS_UNIT_ASSERT(parse("0.1", d));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(d, 0.1);
+      CXXTOOLS_UNIT_ASSERT(parse("1.7976931348623157e308", d));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(d, std::numeric_limits<double>::max());
+      CXXTOOLS_UNIT_ASSERT(parse("-inf", d));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(d, -std::numeric_limits<double>::infinity());
+      CXXTOOLS_UNIT_ASSERT(parse("nan", d));
+      CXXTOOLS_UNIT_ASSERT(d != d);
+      CXXTOOLS_UNIT_ASSERT(!parse("1.5x", d));
+      CXXTOOLS_UNIT_ASSERT(!parse(".", d));
+
+      float f;
+      CXXTOOLS_UNIT_ASSERT(parse("0.1", f));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(f, 0.1f);
+    }
+
+    void testFormat()
+    {
+      CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::formatNumber(-42), "-42");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::formatNumber(std::numeric_limits<uint64_t>::max()), "18446744073709551615");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::formatNumber(0.1), "0.1");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::formatNumber(100.0), "100");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::formatNumber(0.1f), "0.1");
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(roundTrip(1.0 / 3), 1.0 / 3);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(roundTrip(-123e-154), -123e-154);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(roundTrip(std::numeric_limits<double>::max()), std::numeric_limits<double>::max());
+      CXXTOOLS_UNIT_ASSERT_EQUALS(roundTrip(std::numeric_limits<double>::min()), std::numeric_limits<double>::min());
+      CXXTOOLS_UNIT_ASSERT_EQUALS(roundTrip(1.0f / 3), 1.0f / 3);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(roundTrip(std::numeric_limits<int64_t>::min()), std::numeric_limits<int64_t>::min());
+    }
+
+    void testConvertNumber()
+    {
+      CXXTOOLS_UNIT_ASSERT_EQUALS(tntdb::convertNumber<int>("7", 1, "int"), 7);
+      CXXTOOLS_UNIT_ASSERT_THROW(tntdb::convertNumber<int>("seven", 5, "int"), tntdb::TypeError);
+      CXXTOOLS_UNIT_ASSERT_THROW(tntdb::convertNumber<unsigned short>("70000", 5, "unsigned short"), tntdb::TypeError);
+    }
+
+};
+
+cxxtools::unit::RegisterTest<TntdbNumconvertTest> register_TntdbNumconvertTest;
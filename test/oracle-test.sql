@@ -31,3 +31,9 @@ for each row
         select tntdbtest_seq.nextval into :new.id from dual;
     end;
 /
+
+create table tntdbbatchtest
+(
+  id integer not null primary key,
+  v integer
+);
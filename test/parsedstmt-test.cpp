@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+
+#include <cxxtools/unit/testsuite.h>
+#include <cxxtools/unit/registertest.h>
+#include <tntdb/parsedstmt.h>
+#include <tntdb/staticsql.h>
+
+class ParsedStmtTest : public cxxtools::unit::TestSuite
+{
+
+  public:
+    ParsedStmtTest()
+      : cxxtools::unit::TestSuite("parsedstmt")
+    {
+      registerMethod("testNumbered", *this, &ParsedStmtTest::testNumbered);
+      registerMethod("testQuestionmark", *this, &ParsedStmtTest::testQuestionmark);
+      registerMethod("testEscape", *this, &ParsedStmtTest::testEscape);
+      registerMethod("testShared", *this, &ParsedStmtTest::testShared);
+#if __cplusplus >= 201402L
+      registerMethod("testStaticSql", *this, &ParsedStmtTest::testStaticSql);
+#endif
+    }
+
+    void testNumbered()
+    {
+      cxxtools::SmartPtr<tntdb::ParsedStmt> p = tntdb::ParsedStmt::get(
+        "select a from t where b = :b and c = ':c' and d = :d or e = :b",
+        tntdb::ParsedStmt::NUMBERED);
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getSql(), "select a from t where b = $1 and c = ':c' and d = $2 or e = $1");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getParamCount(), 2);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getPlaceholderCount(), 3);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getHostvarMap().find("d")->second, 1);
+    }
+
+    void testQuestionmark()
+    {
+      cxxtools::SmartPtr<tntdb::ParsedStmt> p = tntdb::ParsedStmt::get(
+        "select a from t where b = :b and d = :d or e = :b",
+        tntdb::ParsedStmt::QUESTIONMARK);
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getSql(), "select a from t where b = ? and d = ? or e = ?");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getParamCount(), 2);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getPlaceholderCount(), 3);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getParams()[0].size(), 2);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getParams()[0][1], 2);
+    }
+
+    void testEscape()
+    {
+      cxxtools::SmartPtr<tntdb::ParsedStmt> p = tntdb::ParsedStmt::get(
+        "select a::text, ':x', \\:y from t where b = :b\\c",
+        tntdb::ParsedStmt::QUESTIONMARK);
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getSql(), "select a::text, ':x', :y from t where b = ?c");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getParamCount(), 1);
+    }
+
+    void testShared()
+    {
+      cxxtools::SmartPtr<tntdb::ParsedStmt> p1 = tntdb::ParsedStmt::get(
+        "select a from t where b = :b", tntdb::ParsedStmt::NUMBERED);
+      cxxtools::SmartPtr<tntdb::ParsedStmt> p2 = tntdb::ParsedStmt::get(
+        "select a from t where b = :b", tntdb::ParsedStmt::NUMBERED);
+      cxxtools::SmartPtr<tntdb::ParsedStmt> p3 = tntdb::ParsedStmt::get(
+        "select a from t where b = :b", tntdb::ParsedStmt::QUESTIONMARK);
+
+      CXXTOOLS_UNIT_ASSERT(p1.getPointer() == p2.getPointer());
+      CXXTOOLS_UNIT_ASSERT(p1.getPointer() != p3.getPointer());
+    }
+
+#if __cplusplus >= 201402L
+    void testStaticSql()
+    {
+      static constexpr auto sql = TNTDB_SQL("select a from t where b = :b and c = ':c' or d = :b and e = :e");
+      static_assert(sql.paramCount() == 2, "two host variables");
+      static_assert(sql.paramIndex("e") == 1, "index in order of first appearance");
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(std::string(TNTDB_PARAM(sql, "b")), "b");
+
+      std::string query = sql;
+      CXXTOOLS_UNIT_ASSERT(tntdb::ParsedStmt::isCached(query, tntdb::ParsedStmt::NUMBERED));
+
+      // the compile time result equals the runtime parser
+      cxxtools::SmartPtr<tntdb::ParsedStmt> p = tntdb::ParsedStmt::get(query, tntdb::ParsedStmt::NUMBERED);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getSql(), "select a from t where b = $1 and c = ':c' or d = $1 and e = $2");
+
+      tntdb::ParsedStmt::clearCache();
+      p = tntdb::ParsedStmt::get(query, tntdb::ParsedStmt::QUESTIONMARK);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getSql(), sql.sql(tntdb::ParsedStmt::QUESTIONMARK));
+      CXXTOOLS_UNIT_ASSERT_EQUALS(p->getPlaceholderCount(), sql.placeholderCount());
+    }
+#endif
+
+};
+
+cxxtools::unit::RegisterTest<ParsedStmtTest> register_ParsedStmtTest;
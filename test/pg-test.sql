@@ -24,3 +24,9 @@ create table tntdbtest
   datetimecol timestamp
 );
 alter sequence tntdbtest_seq owned by tntdbtest.id;
+
+create table tntdbbatchtest
+(
+  id integer not null primary key,
+  v integer
+);
@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2026 tntdb contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * As a special exception, you may use this file as part of a free
+ * software library without restriction. Specifically, if other files
+ * instantiate templates or use macros or inline functions from this
+ * file, or you compile this file and link it with other files to
+ * produce an executable, this file does not by itself cause the
+ * resulting executable to be covered by the GNU General Public
+ * License. This exception does not however invalidate any other
+ * reasons why the executable file might be covered by the GNU Library
+ * General Public License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+ */
+
+#include <cxxtools/unit/testsuite.h>
+#include <cxxtools/unit/registertest.h>
+#include <cxxtools/log.h>
+#include <sstream>
+#include <stdlib.h>
+#include <unistd.h>
+#include <tntdb/connectionpool.h>
+#include <tntdb/connection.h>
+#include <tntdb/error.h>
+#include <tntdb/statement.h>
+#include <tntdb/value.h>
+
+log_define("tntdb.unit.pool")
+
+class TntdbPoolTest : public cxxtools::unit::TestSuite
+{
+    std::string dburl;
+
+  public:
+    TntdbPoolTest()
+      : cxxtools::unit::TestSuite("pool")
+    {
+      registerMethod("testReuse", *this, &TntdbPoolTest::testReuse);
+      registerMethod("testMaximumSize", *this, &TntdbPoolTest::testMaximumSize);
+      registerMethod("testSetMaximumSize", *this, &TntdbPoolTest::testSetMaximumSize);
+      registerMethod("testWarmUp", *this, &TntdbPoolTest::testWarmUp);
+      registerMethod("testThreadCache", *this, &TntdbPoolTest::testThreadCache);
+      registerMethod("testMaintain", *this, &TntdbPoolTest::testMaintain);
+      registerMethod("testStatementRegistry", *this, &TntdbPoolTest::testStatementRegistry);
+      registerMethod("testStatementRegistryLimit", *this, &TntdbPoolTest::testStatementRegistryLimit);
+      registerMethod("testResetTransaction", *this, &TntdbPoolTest::testResetTransaction);
+      registerMethod("testRemovePool", *this, &TntdbPoolTest::testRemovePool);
+    }
+
+    void setUp()
+    {
+      const char* url = getenv("TNTDBURL");
+      dburl = url ? url : "sqlite:test.db";
+    }
+
+    void testReuse()
+    {
+      tntdb::ConnectionPool pool(dburl);
+
+      {
+        tntdb::Connection conn = pool.connect();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 0);
+      }
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+
+      tntdb::Connection conn = pool.connect();
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 0);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getTotalSize(), 1);
+
+      tntdb::PoolStatistics statistics = pool.getStatistics();
+      CXXTOOLS_UNIT_ASSERT_EQUALS(statistics.inUse, 1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(statistics.idle, 0);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(statistics.created, 1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(statistics.checkoutWait.count(), 2);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(statistics.holdTime.count(), 1);
+    }
+
+    void testMaximumSize()
+    {
+      tntdb::ConnectionPool pool(dburl, 2);
+
+      {
+        tntdb::Connection c1 = pool.connect();
+        tntdb::Connection c2 = pool.connect();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getTotalSize(), 2);
+
+        CXXTOOLS_UNIT_ASSERT_THROW(pool.connect(10), tntdb::PoolTimeout);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getWaitCount(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getTimeoutCount(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getWaiting(), 0);
+      }
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 2);
+
+      pool.drop(1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getTotalSize(), 1);
+    }
+
+    void testSetMaximumSize()
+    {
+      tntdb::ConnectionPool pool(dburl, 1);
+
+      tntdb::Connection c1 = pool.connect();
+      CXXTOOLS_UNIT_ASSERT_THROW(pool.connect(0), tntdb::PoolTimeout);
+
+      pool.setMaximumSize(2);
+      tntdb::Connection c2 = pool.connect(0);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getTotalSize(), 2);
+    }
+
+    void testWarmUp()
+    {
+      tntdb::ConnectionPool pool(dburl);
+      pool.setMinIdle(3);
+      pool.warmUp(2, true);
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 3);
+
+      tntdb::Connection conn = pool.connect();
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 2);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getTotalSize(), 3);
+    }
+
+    void testThreadCache()
+    {
+      tntdb::ConnectionPool pool(dburl);
+      pool.setThreadCache(true);
+
+      {
+        tntdb::Connection conn = pool.connect();
+      }
+
+      // the connection is kept in the cache of this thread
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getStatistics().idle, 1);
+
+      {
+        tntdb::Connection conn = pool.connect();
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getTotalSize(), 1);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getStatistics().idle, 0);
+      }
+
+      pool.setThreadCache(false);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+    }
+
+    void testRemovePool()
+    {
+      tntdb::ConnectionPools pools;
+
+      for (unsigned n = 0; n < 3; ++n)
+      {
+        {
+          tntdb::Connection conn = pools.connect(dburl);
+        }
+
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pools.getCurrentSize(dburl), 1);
+
+        // removes the empty pool; the next connect creates a new one
+        pools.drop(dburl);
+        CXXTOOLS_UNIT_ASSERT_EQUALS(pools.getCurrentSize(dburl), 0);
+      }
+    }
+
+    void testMaintain()
+    {
+      tntdb::ConnectionPool pool(dburl);
+      pool.setMinIdle(1);
+
+      {
+        tntdb::Connection c1 = pool.connect();
+        tntdb::Connection c2 = pool.connect();
+        tntdb::Connection c3 = pool.connect();
+      }
+
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 3);
+
+      // all connections get older than the maximum lifetime
+      pool.setMaxLifetime(1);
+      usleep(2000);
+      pool.maintain();
+
+      // the retired connections are replaced by one fresh connection
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getStatistics().created, 4);
+    }
+
+    void testStatementRegistry()
+    {
+      tntdb::ConnectionPool pool(dburl);
+      pool.registerStatement("one", "select 1");
+      pool.setRecordStatements(true);
+
+      {
+        tntdb::Connection conn = pool.connect();
+        conn.prepareCached("select\t2\nfrom dual", "two\\");
+      }
+
+      std::ostringstream out;
+      pool.dumpStatements(out);
+
+      tntdb::ConnectionPool pool2(dburl);
+      std::istringstream in(out.str());
+      pool2.loadStatements(in);
+
+      tntdb::ConnectionPool::StatementsType statements = pool2.getStatements();
+      CXXTOOLS_UNIT_ASSERT_EQUALS(statements.size(), 2);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(statements["one"], "select 1");
+      CXXTOOLS_UNIT_ASSERT_EQUALS(statements["two\\"], "select\t2\nfrom dual");
+
+      CXXTOOLS_UNIT_ASSERT(pool2.unregisterStatement("two\\"));
+      CXXTOOLS_UNIT_ASSERT(!pool2.unregisterStatement("two\\"));
+
+      // a new connection finds the registered statement in its cache
+      tntdb::Connection conn = pool2.connect();
+      conn.prepareCached("select 1", "one").selectValue();
+    }
+
+    void testStatementRegistryLimit()
+    {
+      tntdb::ConnectionPool pool(dburl);
+      pool.setMaxStatements(2);
+      pool.registerStatement("one", "select 1");
+      pool.registerStatement("two", "select 2");
+
+      // registering again makes "one" the most recently used statement
+      pool.registerStatement("one", "select 1");
+      pool.registerStatement("three", "select 3");
+
+      tntdb::ConnectionPool::StatementsType statements = pool.getStatements();
+      CXXTOOLS_UNIT_ASSERT_EQUALS(statements.size(), 2);
+      CXXTOOLS_UNIT_ASSERT(statements.find("one") != statements.end());
+      CXXTOOLS_UNIT_ASSERT(statements.find("three") != statements.end());
+
+      pool.setMaxStatements(1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getStatements().size(), 1);
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getStatements().begin()->first, "three");
+    }
+
+    void testResetTransaction()
+    {
+      tntdb::ConnectionPool pool(dburl);
+
+      {
+        tntdb::Connection conn = pool.connect();
+        conn.beginTransaction();
+        conn.beginTransaction();
+      }
+
+      // the pending transaction is rolled back and the connection reused
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getCurrentSize(), 1);
+
+      tntdb::Connection conn = pool.connect();
+      conn.beginTransaction();
+      conn.commitTransaction();
+      CXXTOOLS_UNIT_ASSERT_EQUALS(pool.getStatistics().created, 1);
+    }
+
+};
+
+cxxtools::unit::RegisterTest<TntdbPoolTest> register_TntdbPoolTest;
@@ -22,3 +22,9 @@ create table tntdbtest
   timecol time,
   datetimecol datetime
 );
+
+create table tntdbbatchtest
+(
+  id integer not null primary key,
+  v integer
+);